@@ -171,6 +171,49 @@ AC_DEFUN([QL_CHECK_BOOST_TEST_STREAM],
     ])
 ])
 
+# QL_CHECK_BOOST_THREAD
+# ---------------------
+# Check whether the Boost thread library is available, and add it to
+# the libraries to link
+AC_DEFUN([QL_CHECK_BOOST_THREAD],
+[AC_MSG_CHECKING([for Boost thread library])
+ AC_REQUIRE([AC_PROG_CC])
+ ql_original_LIBS=$LIBS
+ boost_thread_found=no
+ for boost_lib in boost_thread boost_thread-mt ; do
+     for boost_system_lib in "" boost_system boost_system-mt ; do
+         if test -n "$boost_system_lib" ; then
+             boost_thread_libs="-l$boost_lib -l$boost_system_lib"
+         else
+             boost_thread_libs="-l$boost_lib"
+         fi
+         LIBS="$ql_original_LIBS $boost_thread_libs"
+         AC_LINK_IFELSE([AC_LANG_SOURCE(
+             [@%:@include <boost/thread/mutex.hpp>
+              int main() {
+                  boost::mutex m;
+                  boost::mutex::scoped_lock lock(m);
+                  return 0;
+              }
+             ])],
+             [boost_thread_found=yes
+              break],
+             [])
+     done
+     if test "$boost_thread_found" = yes ; then
+         break
+     fi
+ done
+ LIBS="$ql_original_LIBS"
+ if test "$boost_thread_found" = no ; then
+     AC_MSG_RESULT([no])
+     AC_MSG_ERROR([Boost thread library not found])
+ else
+     AC_MSG_RESULT([$boost_thread_libs])
+     LIBS="$LIBS $boost_thread_libs"
+ fi
+])
+
 # QL_CHECK_BOOST
 # ------------------------
 # Boost-related tests
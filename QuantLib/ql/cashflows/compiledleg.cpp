@@ -0,0 +1,495 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/cashflows/compiledleg.hpp>
+#include <ql/cashflows/coupon.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/math/solvers1d/brent.hpp>
+#include <ql/math/solvers1d/newtonsafe.hpp>
+#include <ql/math/comparison.hpp>
+#include <ql/settings.hpp>
+#include <cmath>
+
+using boost::shared_ptr;
+using boost::dynamic_pointer_cast;
+
+namespace QuantLib {
+
+    namespace {
+
+        const Spread basisPoint_ = 1.0e-4;
+
+        template <class T>
+        Integer sign(T x) {
+            static T zero = T();
+            if (x == zero)
+                return 0;
+            else if (x > zero)
+                return 1;
+            else
+                return -1;
+        }
+
+    }
+
+    CompiledLeg::CompiledLeg(const Leg& leg,
+                             bool includeSettlementDateFlows,
+                             Date settlementDate,
+                             Date npvDate) {
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        settlementDate_ = settlementDate;
+        npvDate_ = npvDate;
+
+        dates_.reserve(leg.size());
+        amounts_.reserve(leg.size());
+        isCoupon_.reserve(leg.size());
+        bpsWeights_.reserve(leg.size());
+        refStartDates_.reserve(leg.size());
+        refEndDates_.reserve(leg.size());
+
+        Date lastDate = npvDate;
+        for (Size i=0; i<leg.size(); ++i) {
+            if (leg[i]->hasOccurred(settlementDate,
+                                    includeSettlementDateFlows))
+                continue;
+
+            Date paymentDate = leg[i]->date();
+            dates_.push_back(paymentDate);
+            amounts_.push_back(leg[i]->amount());
+
+            shared_ptr<Coupon> coupon = dynamic_pointer_cast<Coupon>(leg[i]);
+            if (coupon) {
+                isCoupon_.push_back(true);
+                bpsWeights_.push_back(coupon->nominal() *
+                                      coupon->accrualPeriod());
+                refStartDates_.push_back(coupon->accrualStartDate());
+                refEndDates_.push_back(coupon->accrualEndDate());
+            } else {
+                isCoupon_.push_back(false);
+                bpsWeights_.push_back(0.0);
+                if (lastDate == npvDate) {
+                    // we don't have a previous coupon date,
+                    // so we fake it
+                    refStartDates_.push_back(paymentDate - 1*Years);
+                } else  {
+                    refStartDates_.push_back(lastDate);
+                }
+                refEndDates_.push_back(paymentDate);
+            }
+            lastDate = paymentDate;
+        }
+    }
+
+    void CompiledLeg::periods(const DayCounter& dc,
+                              std::vector<Time>& result) const {
+        result.resize(dates_.size());
+        Date lastDate = npvDate_;
+        for (Size i=0; i<dates_.size(); ++i) {
+            QL_REQUIRE(dates_[i] >= lastDate,
+                       "d1 (" << lastDate << ") "
+                       "later than d2 (" << dates_[i] << ")");
+            result[i] = dc.yearFraction(lastDate, dates_[i],
+                                        refStartDates_[i], refEndDates_[i]);
+            lastDate = dates_[i];
+        }
+    }
+
+    void CompiledLeg::times(const DayCounter& dc,
+                            std::vector<Time>& result) const {
+        result.resize(dates_.size());
+        for (Size i=0; i<dates_.size(); ++i)
+            result[i] = dc.yearFraction(npvDate_, dates_[i]);
+    }
+
+
+    // YieldTermStructure functions
+
+    void CompiledLeg::discounts(const YieldTermStructure& discountCurve,
+                                Array& result) const {
+        std::vector<Time> times(dates_.size()+1);
+        for (Size i=0; i<dates_.size(); ++i)
+            times[i] = discountCurve.timeFromReference(dates_[i]);
+        times.back() = discountCurve.timeFromReference(npvDate_);
+        discountCurve.discounts(times, result);
+    }
+
+    Real CompiledLeg::npv(const YieldTermStructure& discountCurve) const {
+        if (dates_.empty())
+            return 0.0;
+
+        Array B;
+        discounts(discountCurve, B);
+
+        Real totalNPV = 0.0;
+        for (Size i=0; i<dates_.size(); ++i)
+            totalNPV += amounts_[i] * B[i];
+
+        return totalNPV/B[dates_.size()];
+    }
+
+    Real CompiledLeg::bps(const YieldTermStructure& discountCurve) const {
+        if (dates_.empty())
+            return 0.0;
+
+        Array B;
+        discounts(discountCurve, B);
+
+        Real bps = 0.0;
+        for (Size i=0; i<dates_.size(); ++i) {
+            if (isCoupon_[i])
+                bps += bpsWeights_[i] * B[i];
+        }
+
+        return basisPoint_*bps/B[dates_.size()];
+    }
+
+    void CompiledLeg::npvbps(const YieldTermStructure& discountCurve,
+                             Real& npv,
+                             Real& bps) const {
+        npv = bps = 0.0;
+        if (dates_.empty())
+            return;
+
+        Array B;
+        discounts(discountCurve, B);
+
+        for (Size i=0; i<dates_.size(); ++i) {
+            npv += amounts_[i] * B[i];
+            if (isCoupon_[i])
+                bps += bpsWeights_[i] * B[i];
+        }
+        DiscountFactor d = B[dates_.size()];
+        npv /= d;
+        bps = basisPoint_ * bps / d;
+    }
+
+
+    // Yield functions
+
+    Real CompiledLeg::npv(const InterestRate& y,
+                          const std::vector<Time>& periods) const {
+        Real npv = 0.0;
+        DiscountFactor discount = 1.0;
+        for (Size i=0; i<periods.size(); ++i) {
+            discount *= y.discountFactor(periods[i]);
+            npv += amounts_[i] * discount;
+        }
+        return npv;
+    }
+
+    Real CompiledLeg::npv(const InterestRate& y) const {
+        if (dates_.empty())
+            return 0.0;
+
+        std::vector<Time> t;
+        periods(y.dayCounter(), t);
+        return npv(y, t);
+    }
+
+    Real CompiledLeg::bps(const InterestRate& y) const {
+        if (dates_.empty())
+            return 0.0;
+
+        FlatForward flatRate(settlementDate_, y.rate(), y.dayCounter(),
+                             y.compounding(), y.frequency());
+        return bps(flatRate);
+    }
+
+    Real CompiledLeg::modifiedDuration(const InterestRate& y,
+                                       const std::vector<Time>& times) const {
+        Real P = 0.0;
+        Real dPdy = 0.0;
+        Rate r = y.rate();
+        Natural N = y.frequency();
+        for (Size i=0; i<times.size(); ++i) {
+            Time t = times[i];
+            Real c = amounts_[i];
+            DiscountFactor B = y.discountFactor(t);
+
+            P += c * B;
+            switch (y.compounding()) {
+              case Simple:
+                dPdy -= c * B*B * t;
+                break;
+              case Compounded:
+                dPdy -= c * t * B/(1+r/N);
+                break;
+              case Continuous:
+                dPdy -= c * B * t;
+                break;
+              case SimpleThenCompounded:
+                if (t<=1.0/N)
+                    dPdy -= c * B*B * t;
+                else
+                    dPdy -= c * t * B/(1+r/N);
+                break;
+              default:
+                QL_FAIL("unknown compounding convention (" <<
+                        Integer(y.compounding()) << ")");
+            }
+        }
+
+        if (P == 0.0) // no cashflows
+            return 0.0;
+        return -dPdy/P; // reverse derivative sign
+    }
+
+    Time CompiledLeg::duration(const InterestRate& y,
+                               Duration::Type type) const {
+        if (dates_.empty())
+            return 0.0;
+
+        std::vector<Time> t;
+        times(y.dayCounter(), t);
+
+        switch (type) {
+          case Duration::Simple: {
+              Real P = 0.0;
+              Real dPdy = 0.0;
+              for (Size i=0; i<t.size(); ++i) {
+                  DiscountFactor B = y.discountFactor(t[i]);
+                  P += amounts_[i] * B;
+                  dPdy += t[i] * amounts_[i] * B;
+              }
+              if (P == 0.0) // no cashflows
+                  return 0.0;
+              return dPdy/P;
+          }
+          case Duration::Modified:
+            return modifiedDuration(y, t);
+          case Duration::Macaulay:
+            QL_REQUIRE(y.compounding() == Compounded,
+                       "compounded rate required");
+            return (1.0+y.rate()/y.frequency()) * modifiedDuration(y, t);
+          default:
+            QL_FAIL("unknown duration type");
+        }
+    }
+
+    Real CompiledLeg::convexity(const InterestRate& y) const {
+        if (dates_.empty())
+            return 0.0;
+
+        std::vector<Time> times;
+        this->times(y.dayCounter(), times);
+
+        Real P = 0.0;
+        Real d2Pdy2 = 0.0;
+        Rate r = y.rate();
+        Natural N = y.frequency();
+        for (Size i=0; i<times.size(); ++i) {
+            Time t = times[i];
+            Real c = amounts_[i];
+            DiscountFactor B = y.discountFactor(t);
+            P += c * B;
+            switch (y.compounding()) {
+              case Simple:
+                d2Pdy2 += c * 2.0*B*B*B*t*t;
+                break;
+              case Compounded:
+                d2Pdy2 += c * B*t*(N*t+1)/(N*(1+r/N)*(1+r/N));
+                break;
+              case Continuous:
+                d2Pdy2 += c * B*t*t;
+                break;
+              case SimpleThenCompounded:
+                if (t<=1.0/N)
+                    d2Pdy2 += c * 2.0*B*B*B*t*t;
+                else
+                    d2Pdy2 += c * B*t*(N*t+1)/(N*(1+r/N)*(1+r/N));
+                break;
+              default:
+                QL_FAIL("unknown compounding convention (" <<
+                        Integer(y.compounding()) << ")");
+            }
+        }
+
+        if (P == 0.0)
+            // no cashflows
+            return 0.0;
+
+        return d2Pdy2/P;
+    }
+
+    class CompiledLeg::IrrFinder : public std::unary_function<Rate, Real> {
+      public:
+        IrrFinder(const CompiledLeg& leg,
+                  Real npv,
+                  const DayCounter& dayCounter,
+                  Compounding comp,
+                  Frequency freq)
+        : leg_(leg), npv_(npv),
+          dayCounter_(dayCounter), compounding_(comp), frequency_(freq) {
+            // the times don't depend on the yield, so they are
+            // calculated once for all the iterations
+            leg_.periods(dayCounter_, periods_);
+            leg_.times(dayCounter_, times_);
+            checkSign();
+        }
+        Real operator()(Rate y) const {
+            InterestRate yield(y, dayCounter_, compounding_, frequency_);
+            return npv_ - leg_.npv(yield, periods_);
+        }
+        Real derivative(Rate y) const {
+            InterestRate yield(y, dayCounter_, compounding_, frequency_);
+            return leg_.modifiedDuration(yield, times_);
+        }
+      private:
+        void checkSign() const {
+            // depending on the sign of the market price, check that cash
+            // flows of the opposite sign have been specified (otherwise
+            // IRR is nonsensical.)
+            Integer lastSign = sign(-npv_),
+                    signChanges = 0;
+            for (Size i = 0; i < leg_.amounts_.size(); ++i) {
+                Integer thisSign = sign(leg_.amounts_[i]);
+                if (lastSign * thisSign < 0) // sign change
+                    signChanges++;
+
+                if (thisSign != 0)
+                    lastSign = thisSign;
+            }
+            QL_REQUIRE(signChanges > 0,
+                       "the given cash flows cannot result in the given "
+                       "market price due to their sign");
+        }
+        const CompiledLeg& leg_;
+        Real npv_;
+        DayCounter dayCounter_;
+        Compounding compounding_;
+        Frequency frequency_;
+        std::vector<Time> periods_, times_;
+    };
+
+    Rate CompiledLeg::yield(Real npv,
+                            const DayCounter& dayCounter,
+                            Compounding compounding,
+                            Frequency frequency,
+                            Real accuracy,
+                            Size maxIterations,
+                            Rate guess) const {
+        NewtonSafe solver;
+        solver.setMaxEvaluations(maxIterations);
+        IrrFinder objFunction(*this, npv, dayCounter, compounding, frequency);
+        return solver.solve(objFunction, accuracy, guess, guess/10.0);
+    }
+
+
+    // Z-spread functions
+
+    /* This reproduces the discount factors of a ZeroSpreadedTermStructure
+       built on the given curve; the zero rates of the original curve
+       are calculated once, and each evaluation only needs to add the
+       spread to them.
+    */
+    class CompiledLeg::ZSpreadFinder : public std::unary_function<Rate, Real> {
+      public:
+        ZSpreadFinder(const CompiledLeg& leg,
+                      const shared_ptr<YieldTermStructure>& discountCurve,
+                      Real npv,
+                      Compounding comp,
+                      Frequency freq,
+                      bool extrapolate)
+        : leg_(leg), npv_(npv), compounding_(comp), frequency_(freq),
+          dayCounter_(discountCurve->dayCounter()) {
+            const Size n = leg_.dates_.size();
+            times_.resize(n+1);
+            zeroRates_.resize(n+1, 0.0);
+            for (Size i=0; i<=n; ++i) {
+                const Date& d = (i < n ? leg_.dates_[i] : leg_.npvDate_);
+                Time t = discountCurve->timeFromReference(d);
+                QL_REQUIRE(t >= 0.0,
+                           "negative time (" << t << ") given");
+                QL_REQUIRE(extrapolate || t <= discountCurve->maxTime()
+                           || close_enough(t, discountCurve->maxTime()),
+                           "time (" << t << ") is past max curve time ("
+                           << discountCurve->maxTime() << ")");
+                times_[i] = t;
+                if (t != 0.0)
+                    zeroRates_[i] =
+                        discountCurve->zeroRate(t, comp, freq, true);
+            }
+        }
+        Real value(Spread zSpread) const {
+            const Size n = leg_.dates_.size();
+            Real npv = 0.0;
+            for (Size i=0; i<n; ++i)
+                npv += leg_.amounts_[i] * discount(i, zSpread);
+            return npv/discount(n, zSpread);
+        }
+        Real operator()(Spread zSpread) const {
+            return npv_ - value(zSpread);
+        }
+      private:
+        DiscountFactor discount(Size i, Spread zSpread) const {
+            if (times_[i] == 0.0)
+                return 1.0;
+            InterestRate spreadedRate(zeroRates_[i] + zSpread, dayCounter_,
+                                      compounding_, frequency_);
+            Rate r = spreadedRate.equivalentRate(Continuous, NoFrequency,
+                                                 times_[i]);
+            return DiscountFactor(std::exp(-r*times_[i]));
+        }
+        const CompiledLeg& leg_;
+        Real npv_;
+        Compounding compounding_;
+        Frequency frequency_;
+        DayCounter dayCounter_;
+        std::vector<Time> times_;
+        std::vector<Rate> zeroRates_;
+    };
+
+    Real CompiledLeg::npv(const shared_ptr<YieldTermStructure>& discount,
+                          Spread zSpread,
+                          const DayCounter&,
+                          Compounding compounding,
+                          Frequency frequency) const {
+        if (dates_.empty())
+            return 0.0;
+
+        ZSpreadFinder finder(*this, discount, 0.0,
+                             compounding, frequency, false);
+        return finder.value(zSpread);
+    }
+
+    Spread CompiledLeg::zSpread(Real npv,
+                                const shared_ptr<YieldTermStructure>& discount,
+                                const DayCounter&,
+                                Compounding compounding,
+                                Frequency frequency,
+                                Real accuracy,
+                                Size maxIterations,
+                                Rate guess) const {
+        Brent solver;
+        solver.setMaxEvaluations(maxIterations);
+        // if the discount curve allows extrapolation, let's
+        // the spreaded curve do too.
+        ZSpreadFinder objFunction(*this, discount, npv,
+                                  compounding, frequency,
+                                  discount->allowsExtrapolation());
+        Real step = 0.01;
+        return solver.solve(objFunction, accuracy, guess, step);
+    }
+
+}
+
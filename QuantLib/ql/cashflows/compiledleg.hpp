@@ -0,0 +1,134 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file compiledleg.hpp
+    \brief flat snapshot of a leg for repeated cash-flow analysis
+*/
+
+#ifndef quantlib_compiled_leg_hpp
+#define quantlib_compiled_leg_hpp
+
+#include <ql/cashflows/duration.hpp>
+#include <ql/cashflow.hpp>
+#include <ql/interestrate.hpp>
+#include <ql/math/array.hpp>
+#include <boost/shared_ptr.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    class YieldTermStructure;
+
+    //! flat snapshot of the cash flows of a leg
+    /*! The cash flows of the leg that did not occur at the given
+        settlement date are stored as arrays of payment dates,
+        amounts and coupon data. The analytics below then run over
+        plain arrays, without virtual calls, and the yield and
+        z-spread solvers calculate the required times only once
+        instead of walking the leg at each iteration.
+
+        The methods give the same results as the corresponding
+        ones in the CashFlows class.
+
+        \warning the amounts are read when the snapshot is built; a
+                 new one must be built if they change, e.g., when
+                 the forecast curve of floating-rate coupons moves.
+    */
+    class CompiledLeg {
+      public:
+        CompiledLeg(const Leg& leg,
+                    bool includeSettlementDateFlows,
+                    Date settlementDate = Date(),
+                    Date npvDate = Date());
+        //! \name Inspectors
+        //@{
+        //! number of cash flows that did not occur yet
+        Size size() const { return dates_.size(); }
+        bool empty() const { return dates_.empty(); }
+        const Date& settlementDate() const { return settlementDate_; }
+        const Date& npvDate() const { return npvDate_; }
+        const std::vector<Date>& dates() const { return dates_; }
+        const std::vector<Real>& amounts() const { return amounts_; }
+        //! whether each cash flow is a coupon
+        const std::vector<bool>& isCoupon() const { return isCoupon_; }
+        //@}
+        //! \name YieldTermStructure functions
+        //@{
+        Real npv(const YieldTermStructure& discountCurve) const;
+        Real bps(const YieldTermStructure& discountCurve) const;
+        void npvbps(const YieldTermStructure& discountCurve,
+                    Real& npv,
+                    Real& bps) const;
+        //@}
+        //! \name Yield functions
+        //@{
+        Real npv(const InterestRate& yield) const;
+        Real bps(const InterestRate& yield) const;
+        Rate yield(Real npv,
+                   const DayCounter& dayCounter,
+                   Compounding compounding,
+                   Frequency frequency,
+                   Real accuracy = 1.0e-10,
+                   Size maxIterations = 100,
+                   Rate guess = 0.05) const;
+        Time duration(const InterestRate& yield,
+                      Duration::Type type) const;
+        Real convexity(const InterestRate& yield) const;
+        //@}
+        //! \name Z-spread functions
+        //@{
+        Real npv(const boost::shared_ptr<YieldTermStructure>& discount,
+                 Spread zSpread,
+                 const DayCounter& dayCounter,
+                 Compounding compounding,
+                 Frequency frequency) const;
+        Spread zSpread(Real npv,
+                       const boost::shared_ptr<YieldTermStructure>& discount,
+                       const DayCounter& dayCounter,
+                       Compounding compounding,
+                       Frequency frequency,
+                       Real accuracy = 1.0e-10,
+                       Size maxIterations = 100,
+                       Rate guess = 0.0) const;
+        //@}
+      private:
+        class IrrFinder;
+        class ZSpreadFinder;
+        //! discount factors at the payment dates and at the npv date
+        void discounts(const YieldTermStructure&, Array&) const;
+        //! accrual periods from the previous payment, used by npv
+        void periods(const DayCounter&, std::vector<Time>&) const;
+        //! times from the npv date, used by duration and convexity
+        void times(const DayCounter&, std::vector<Time>&) const;
+        Real npv(const InterestRate& yield,
+                 const std::vector<Time>& periods) const;
+        Real modifiedDuration(const InterestRate& yield,
+                              const std::vector<Time>& times) const;
+        Date settlementDate_, npvDate_;
+        std::vector<Date> dates_;
+        std::vector<Real> amounts_;
+        std::vector<bool> isCoupon_;
+        // nominal times accrual period, zero for other cash flows
+        std::vector<Real> bpsWeights_;
+        // reference periods used when discounting at a given yield
+        std::vector<Date> refStartDates_, refEndDates_;
+    };
+
+}
+
+
+#endif
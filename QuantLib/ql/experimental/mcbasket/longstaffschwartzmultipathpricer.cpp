@@ -50,7 +50,10 @@ namespace QuantLib {
       dF_        (discounts),
       v_         (LsmBasisSystem::multiPathBasisSystem(payoff->basisSystemDimension(),
                                                        polynomOrder,
-                                                       polynomType)) {
+                                                       polynomType)),
+      streaming_(false), firstPass_(true), regressionPass_(false),
+      calibrationDate_(0), pathIndex_(0),
+      lsq_(v_.size()) {
         QL_REQUIRE(   polynomType == LsmBasisSystem::Monomial
                    || polynomType == LsmBasisSystem::Laguerre
                    || polynomType == LsmBasisSystem::Hermite
@@ -83,14 +86,33 @@ namespace QuantLib {
         return info;
     }
 
+    Real LongstaffSchwartzMultiPathPricer::terminalValue(
+                                                const PathInfo& path) const {
+        const Size len = path.pathLength();
+        const Real payoff = path.payments[len - 1];
+        const Real exercise = path.exercises[len - 1];
+        const Array & states = path.states[len - 1];
+        const bool canExercise = !states.empty();
+
+        // at the end the continuation value is 0.0
+        Real price = 0.0;
+        if (canExercise && exercise > 0.0)
+            price += exercise;
+        price += payoff;
+        return price;
+    }
+
     Real LongstaffSchwartzMultiPathPricer::operator()(
                                             const MultiPath& multiPath) const {
         PathInfo path = transformPath(multiPath);
 
         if (calibrationPhase_) {
-            // store paths for the calibration
-            // only the relevant part
-            paths_.push_back(path);
+            if (streaming_)
+                accumulate(path);
+            else
+                // store paths for the calibration
+                // only the relevant part
+                paths_.push_back(path);
             // result doesn't matter
             return 0.0;
         }
@@ -98,20 +120,9 @@ namespace QuantLib {
         // exercise at time t, cancels all payment AFTER t
 
         const Size len = path.pathLength();
-        Real price = 0.0;
 
         // this is the last event date
-        {
-            const Real payoff = path.payments[len - 1];
-            const Real exercise = path.exercises[len - 1];
-            const Array & states = path.states[len - 1];
-            const bool canExercise = !states.empty();
-
-            // at the end the continuation value is 0.0
-            if (canExercise && exercise > 0.0)
-                price += exercise;
-            price += payoff;
-        }
+        Real price = terminalValue(path);
 
         for (Integer i = len - 2; i >= 0; --i) {
             price *= dF_[i + 1] / dF_[i];
@@ -137,13 +148,7 @@ namespace QuantLib {
                 }
                 else {
                     if (!coeff_[i].empty() && exercise > lowerBounds_[i]) {
-                        
-                        Real continuationValue = 0.0;
-                        for (Size l = 0; l < v_.size(); ++l) {
-                            continuationValue += coeff_[i][l] * v_[l](states);
-                        }
-                        
-                        if (continuationValue < exercise) {
+                        if (continuationValue(states, i) < exercise) {
                             price = exercise;
                         }
                     }
@@ -156,9 +161,33 @@ namespace QuantLib {
         return price * dF_[0];
     }
 
+    Real LongstaffSchwartzMultiPathPricer::continuationValue(
+                                     const Array& states, Size i) const {
+        Real value = 0.0;
+        for (Size l = 0; l < v_.size(); ++l) {
+            value += coeff_[i][l] * v_[l](states);
+        }
+        return value;
+    }
+
     void LongstaffSchwartzMultiPathPricer::calibrate() {
+        if (streaming_) {
+            QL_REQUIRE(!firstPass_ && calibrationDate_ == 0
+                                   && !regressionPass_,
+                       "streaming calibration not completed");
+            std::vector<Real> empty;
+            prices_.swap(empty);
+            std::vector<Real>().swap(exercises_);
+            std::vector<Real>().swap(payments_);
+            std::vector<bool>().swap(canExercise_);
+            std::vector<bool>().swap(lsExercise_);
+            calibrationPhase_ = false;
+            return;
+        }
+
         const Size n = paths_.size(); // number of paths
-        Array prices(n, 0.0), exercise(n, 0.0);
+        std::vector<Real> prices(n, 0.0), exercise(n, 0.0), payments(n);
+        std::vector<bool> canExercise(n), lsExercise(n);
 
         const Size basisDimension = payoff_->basisSystemDimension();
 
@@ -169,29 +198,19 @@ namespace QuantLib {
           so that only itm paths contribute to the regression.
          */
 
-        for (Size j = 0; j < n; ++j) {
-            const Real payoff = paths_[j].payments[len - 1];
-            const Real exercise = paths_[j].exercises[len - 1];
-            const Array & states = paths_[j].states[len - 1];
-            const bool canExercise = !states.empty();
-
-            // at the end the continuation value is 0.0
-            if (canExercise && exercise > 0.0)
-                prices[j] += exercise;
-            prices[j] += payoff;
-        }
+        for (Size j = 0; j < n; ++j)
+            prices[j] = terminalValue(paths_[j]);
 
         lowerBounds_[len - 1] = *std::min_element(prices.begin(), prices.end());
 
-        std::vector<bool> lsExercise(n);
-
         for (Integer i = len - 2; i >= 0; --i) {
             std::vector<Real>  y;
             std::vector<Array> x;
 
             // prices are discounted up to time i
             const Real discountRatio = dF_[i + 1] / dF_[i];
-            prices *= discountRatio;
+            for (Size j = 0; j < n; ++j)
+                prices[j] *= discountRatio;
             lowerBounds_[i + 1] *= discountRatio;
 
             //roll back step
@@ -225,84 +244,21 @@ namespace QuantLib {
                 coeff_[i] = Array(0);
             }
 
-            /* attempt to avoid static arbitrage given by always or never exercising.
-
-               always is absolute: regardless of the lowerBoundContinuationValue_ (this could be changed)
-               but it still honours "canExercise"
-             */
-            double sumOptimized = 0.0;
-            double sumNoExercise = 0.0;
-            double sumAlwaysExercise = 0.0; // always, if allowed
-
             for (Size j = 0, k = 0; j < n; ++j) {
-                sumNoExercise += prices[j];
+                payments[j] = paths_[j].payments[i];
+                canExercise[j] = !paths_[j].states[i].empty();
                 lsExercise[j] = false;
-
-                const bool canExercise = !paths_[j].states[i].empty();
-                if (canExercise) {
-                    sumAlwaysExercise += exercise[j];
+                if (canExercise[j]) {
                     if (!coeff_[i].empty() && exercise[j] > lowerBounds_[i + 1]) {
-                        Real continuationValue = 0.0;
-                        for (Size l = 0; l < v_.size(); ++l) {
-                            continuationValue += coeff_[i][l] * v_[l](x[k]);
-                        }
-                        
-                        if (continuationValue < exercise[j]) {
+                        if (continuationValue(x[k], i) < exercise[j]) {
                             lsExercise[j] = true;
                         }
                         ++k;
                     }
                 }
-                else {
-                    sumAlwaysExercise += prices[j];
-                }
-
-                sumOptimized += lsExercise[j] ? exercise[j] : prices[j];
-            }
-
-            sumOptimized /= n;
-            sumNoExercise /= n;
-            sumAlwaysExercise /= n;
-
-            QL_TRACE(   "Time index: " << i 
-                     << ", LowerBound: " << lowerBounds_[i + 1] 
-                     << ", Optimum: " << sumOptimized 
-                     << ", Continuation: " << sumNoExercise 
-                     << ", Termination: " << sumAlwaysExercise);
-
-            if (  sumOptimized >= sumNoExercise 
-                && sumOptimized >= sumAlwaysExercise) {
-                
-                QL_TRACE("Accepted LS decision");
-                for (Size j = 0; j < n; ++j) {
-                    // lsExercise already contains "canExercise"
-                    prices[j] = lsExercise[j] ? exercise[j] : prices[j];
-                }
-            }
-            else if (sumAlwaysExercise > sumNoExercise) {
-                QL_TRACE("Overridden bad LS decision: ALWAYS");
-                for (Size j = 0; j < n; ++j) {
-                    const bool canExercise = !paths_[j].states[i].empty();
-                    prices[j] = canExercise ? exercise[j] : prices[j];
-                }
-                // special value to indicate always exercise
-                coeff_[i] = Array(v_.size() + 1); 
-            }
-            else {
-                QL_TRACE("Overridden bad LS decision: NEVER");
-                // prices already contain the continuation value
-                // special value to indicate never exercise
-                coeff_[i] = Array(0); 
-            }
-
-            // then we add in any case the payment at time t
-            // which is made even if cancellation happens at t
-            for (Size j = 0; j < n; ++j) {
-                const Real payoff = paths_[j].payments[i];
-                prices[j] += payoff;
             }
 
-            lowerBounds_[i] = *std::min_element(prices.begin(), prices.end());
+            rollback(i, prices, exercise, payments, canExercise, lsExercise);
         }
 
         // remove calibration paths
@@ -310,4 +266,165 @@ namespace QuantLib {
         // entering the calculation phase
         calibrationPhase_ = false;
     }
+
+    void LongstaffSchwartzMultiPathPricer::rollback(
+                                   Size i,
+                                   std::vector<Real>& prices,
+                                   const std::vector<Real>& exercise,
+                                   const std::vector<Real>& payments,
+                                   const std::vector<bool>& canExercise,
+                                   const std::vector<bool>& lsExercise) {
+        const Size n = prices.size();
+
+        /* attempt to avoid static arbitrage given by always or never exercising.
+
+           always is absolute: regardless of the lowerBoundContinuationValue_ (this could be changed)
+           but it still honours "canExercise"
+         */
+        double sumOptimized = 0.0;
+        double sumNoExercise = 0.0;
+        double sumAlwaysExercise = 0.0; // always, if allowed
+
+        for (Size j = 0; j < n; ++j) {
+            sumNoExercise += prices[j];
+            if (canExercise[j])
+                sumAlwaysExercise += exercise[j];
+            else
+                sumAlwaysExercise += prices[j];
+
+            sumOptimized += lsExercise[j] ? exercise[j] : prices[j];
+        }
+
+        sumOptimized /= n;
+        sumNoExercise /= n;
+        sumAlwaysExercise /= n;
+
+        QL_TRACE(   "Time index: " << i 
+                 << ", LowerBound: " << lowerBounds_[i + 1] 
+                 << ", Optimum: " << sumOptimized 
+                 << ", Continuation: " << sumNoExercise 
+                 << ", Termination: " << sumAlwaysExercise);
+
+        if (  sumOptimized >= sumNoExercise 
+            && sumOptimized >= sumAlwaysExercise) {
+
+            QL_TRACE("Accepted LS decision");
+            for (Size j = 0; j < n; ++j) {
+                // lsExercise already contains "canExercise"
+                prices[j] = lsExercise[j] ? exercise[j] : prices[j];
+            }
+        }
+        else if (sumAlwaysExercise > sumNoExercise) {
+            QL_TRACE("Overridden bad LS decision: ALWAYS");
+            for (Size j = 0; j < n; ++j) {
+                prices[j] = canExercise[j] ? exercise[j] : prices[j];
+            }
+            // special value to indicate always exercise
+            coeff_[i] = Array(v_.size() + 1); 
+        }
+        else {
+            QL_TRACE("Overridden bad LS decision: NEVER");
+            // prices already contain the continuation value
+            // special value to indicate never exercise
+            coeff_[i] = Array(0); 
+        }
+
+        // then we add in any case the payment at time t
+        // which is made even if cancellation happens at t
+        for (Size j = 0; j < n; ++j) {
+            prices[j] += payments[j];
+        }
+
+        lowerBounds_[i] = *std::min_element(prices.begin(), prices.end());
+    }
+
+    void LongstaffSchwartzMultiPathPricer::startStreamingCalibration() {
+        QL_REQUIRE(calibrationPhase_ && paths_.empty(),
+                   "calibration already started");
+        streaming_ = true;
+    }
+
+    void LongstaffSchwartzMultiPathPricer::accumulate(
+                                               const PathInfo& path) const {
+        if (firstPass_) {
+            calibrationDate_ = path.pathLength() - 1;
+            prices_.push_back(terminalValue(path));
+            ++pathIndex_;
+            return;
+        }
+
+        QL_REQUIRE(pathIndex_ < prices_.size(),
+                   "more calibration paths than in the first pass");
+        const Size j = pathIndex_++;
+        const Size i = calibrationDate_;
+
+        const Array & states = path.states[i];
+        QL_REQUIRE(states.empty() ||
+                   states.size() == payoff_->basisSystemDimension(),
+                   "Invalid size of basis system");
+        const Real exercise = path.exercises[i];
+
+        if (regressionPass_) {
+            // prices are already discounted up to time i
+            if (!states.empty() && exercise > lowerBounds_[i + 1])
+                lsq_.add(states, prices_[j], v_);
+        } else {
+            exercises_[j] = exercise;
+            payments_[j] = path.payments[i];
+            canExercise_[j] = !states.empty();
+            lsExercise_[j] = canExercise_[j] && !coeff_[i].empty()
+                && exercise > lowerBounds_[i + 1]
+                && continuationValue(states, i) < exercise;
+        }
+    }
+
+    bool LongstaffSchwartzMultiPathPricer::nextCalibrationPass() {
+        if (!streaming_ || !calibrationPhase_)
+            return false;
+
+        const Size n = prices_.size();
+        QL_REQUIRE(n > 0, "no calibration paths");
+        QL_REQUIRE(pathIndex_ == n,
+                   pathIndex_ << " calibration paths passed, "
+                   << n << " expected");
+        pathIndex_ = 0;
+
+        const Size i = calibrationDate_;
+        if (firstPass_) {
+            firstPass_ = false;
+            lowerBounds_[i] = *std::min_element(prices_.begin(),
+                                                prices_.end());
+        } else if (regressionPass_) {
+            if (v_.size() <= lsq_.size()) {
+                coeff_[i] = lsq_.coefficients();
+            } else {
+                QL_TRACE("Not enough itm paths: default decision is NEVER");
+                coeff_[i] = Array(0);
+            }
+            lsq_.reset();
+            exercises_.resize(n);
+            payments_.resize(n);
+            canExercise_.resize(n);
+            lsExercise_.resize(n);
+            // the exercise decision needs another pass
+            regressionPass_ = false;
+            return true;
+        } else {
+            rollback(i, prices_, exercises_, payments_,
+                     canExercise_, lsExercise_);
+        }
+
+        if (i == 0)
+            return false;
+
+        // prices are discounted up to the previous date,
+        // which is regressed upon in the next pass
+        const Real discountRatio = dF_[i] / dF_[i - 1];
+        for (Size j = 0; j < n; ++j)
+            prices_[j] *= discountRatio;
+        lowerBounds_[i] *= discountRatio;
+        --calibrationDate_;
+        regressionPass_ = true;
+        return true;
+    }
 }
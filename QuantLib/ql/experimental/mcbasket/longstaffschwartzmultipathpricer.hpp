@@ -22,6 +22,7 @@
 
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/math/functional.hpp>
+#include <ql/math/streaminglinearleastsquares.hpp>
 #include <ql/methods/montecarlo/pathpricer.hpp>
 #include <ql/methods/montecarlo/multipath.hpp>
 #include <ql/methods/montecarlo/lsmbasissystem.hpp>
@@ -38,6 +39,12 @@ namespace QuantLib {
         by Simulation: A Simple Least-Squares Approach, The Review of
         Financial Studies, Volume 14, No. 1, 113-147
 
+        As in LongstaffSchwartzPathPricer, the calibration paths can
+        be streamed rather than stored; in this case, they must be
+        passed once at the start and twice for each exercise date
+        (once for the regression and once for the exercise
+        decision) until nextCalibrationPass() returns false.
+
         \ingroup mcarlo
 
         \test the correctness of the returned value is tested by
@@ -57,6 +64,16 @@ namespace QuantLib {
         Real operator()(const MultiPath& multiPath) const;
         virtual void calibrate();
 
+        //! \name Streaming calibration
+        //@{
+        //! calibration paths will not be stored
+        void startStreamingCalibration();
+        /*! performs the calculations required at the end of a pass;
+            returns true if the calibration paths must be passed again.
+        */
+        bool nextCalibrationPass();
+        //@}
+
       protected:
         struct PathInfo {
             PathInfo(Size numberOfTimes);
@@ -69,6 +86,15 @@ namespace QuantLib {
         };
 
         PathInfo transformPath(const MultiPath& path) const;
+        Real terminalValue(const PathInfo& path) const;
+        Real continuationValue(const Array& states, Size i) const;
+        void rollback(Size i,
+                      std::vector<Real>& prices,
+                      const std::vector<Real>& exercise,
+                      const std::vector<Real>& payments,
+                      const std::vector<bool>& canExercise,
+                      const std::vector<bool>& lsExercise);
+        void accumulate(const PathInfo& path) const;
 
         bool  calibrationPhase_;
 
@@ -83,6 +109,13 @@ namespace QuantLib {
 
         mutable std::vector<PathInfo> paths_;
         const   std::vector<boost::function1<Real, Array> > v_;
+
+        // streaming calibration
+        bool streaming_, firstPass_, regressionPass_;
+        mutable Size calibrationDate_, pathIndex_;
+        mutable std::vector<Real> prices_, exercises_, payments_;
+        mutable std::vector<bool> canExercise_, lsExercise_;
+        mutable StreamingLinearLeastSquares lsq_;
     };
 
 }
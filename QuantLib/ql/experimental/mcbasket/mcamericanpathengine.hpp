@@ -51,7 +51,8 @@ namespace QuantLib {
                                Real requiredTolerance,
                                Size maxSamples,
                                BigNatural seed,
-                               Size nCalibrationSamples = Null<Size>());
+                               Size nCalibrationSamples = Null<Size>(),
+                               bool streamingCalibration = false);
       protected:
         boost::shared_ptr<LongstaffSchwartzMultiPathPricer>
                                                       lsmPathPricer() const;
@@ -75,6 +76,7 @@ namespace QuantLib {
         MakeMCAmericanPathEngine& withMaxSamples(Size samples);
         MakeMCAmericanPathEngine& withSeed(BigNatural seed);
         MakeMCAmericanPathEngine& withCalibrationSamples(Size samples);
+        MakeMCAmericanPathEngine& withStreamingCalibration(bool b = true);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
       private:
@@ -83,6 +85,7 @@ namespace QuantLib {
         Size steps_, stepsPerYear_, samples_, maxSamples_, calibrationSamples_;
         Real tolerance_;
         BigNatural seed_;
+        bool streamingCalibration_;
     };
 
 
@@ -98,7 +101,8 @@ namespace QuantLib {
                    Real requiredTolerance,
                    Size maxSamples,
                    BigNatural seed,
-                   Size nCalibrationSamples)
+                   Size nCalibrationSamples,
+                   bool streamingCalibration)
         : MCLongstaffSchwartzPathEngine<PathMultiAssetOption::engine,
                                     MultiVariate,RNG>(processes,
                                                       timeSteps,
@@ -110,7 +114,8 @@ namespace QuantLib {
                                                       requiredTolerance,
                                                       maxSamples,
                                                       seed,
-                                                      nCalibrationSamples) {}
+                                                      nCalibrationSamples,
+                                                      streamingCalibration) {}
 
     template <class RNG>
     inline boost::shared_ptr<LongstaffSchwartzMultiPathPricer>
@@ -169,7 +174,7 @@ namespace QuantLib {
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
       calibrationSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), seed_(0) {}
+      tolerance_(Null<Real>()), seed_(0), streamingCalibration_(false) {}
 
     template <class RNG>
     inline MakeMCAmericanPathEngine<RNG>&
@@ -248,6 +253,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG>
+    inline MakeMCAmericanPathEngine<RNG>&
+    MakeMCAmericanPathEngine<RNG>::withStreamingCalibration(bool b) {
+        streamingCalibration_ = b;
+        return *this;
+    }
+
     template <class RNG>
     inline
     MakeMCAmericanPathEngine<RNG>::operator
@@ -267,7 +279,8 @@ namespace QuantLib {
                                         tolerance_,
                                         maxSamples_,
                                         seed_,
-                                        calibrationSamples_));
+                                        calibrationSamples_,
+                                        streamingCalibration_));
     }
 
 }
@@ -21,6 +21,7 @@
 #define quantlib_mc_longstaff_schwartz_path_engine_hpp
 
 #include <ql/pricingengines/mcsimulation.hpp>
+#include <ql/math/randomnumbers/seedgenerator.hpp>
 #include <ql/experimental/mcbasket/longstaffschwartzmultipathpricer.hpp>
 
 namespace QuantLib {
@@ -32,6 +33,12 @@ namespace QuantLib {
         by Simulation: A Simple Least-Squares Approach, The Review of
         Financial Studies, Volume 14, No. 1, 113-147
 
+        If streaming calibration is requested, the calibration paths
+        are generated again from the same seed as many times as
+        required by the path pricer instead of being stored.  When no
+        seed is given, one is drawn once per calculation and used for
+        all passes.
+
         \test the correctness of the returned value is tested by
               reproducing results available in web/literature
     */
@@ -59,7 +66,8 @@ namespace QuantLib {
             Real requiredTolerance,
             Size maxSamples,
             BigNatural seed,
-            Size nCalibrationSamples = Null<Size>());
+            Size nCalibrationSamples = Null<Size>(),
+            bool streamingCalibration = false);
 
         void calculate() const;
 
@@ -70,6 +78,8 @@ namespace QuantLib {
         TimeGrid timeGrid() const;
         boost::shared_ptr<path_pricer_type> pathPricer() const;
         boost::shared_ptr<path_generator_type> pathGenerator() const;
+        boost::shared_ptr<path_generator_type>
+        pathGenerator(BigNatural seed) const;
 
         boost::shared_ptr<StochasticProcess> process_;
         const Size timeSteps_;
@@ -80,6 +90,7 @@ namespace QuantLib {
         const Size maxSamples_;
         const Size seed_;
         const Size nCalibrationSamples_;
+        const bool streamingCalibration_;
 
         mutable boost::shared_ptr<LongstaffSchwartzMultiPathPricer> pathPricer_;
     };
@@ -98,7 +109,8 @@ namespace QuantLib {
             Real requiredTolerance,
             Size maxSamples,
             BigNatural seed,
-            Size nCalibrationSamples)
+            Size nCalibrationSamples,
+            bool streamingCalibration)
     : McSimulation<MC,RNG,S> (antitheticVariate, controlVariate),
       process_            (process),
       timeSteps_          (timeSteps),
@@ -109,7 +121,8 @@ namespace QuantLib {
       maxSamples_         (maxSamples),
       seed_               (seed),
       nCalibrationSamples_( (nCalibrationSamples == Null<Size>())
-                            ? 2048 : nCalibrationSamples) {
+                            ? 2048 : nCalibrationSamples),
+      streamingCalibration_(streamingCalibration) {
         QL_REQUIRE(timeSteps != Null<Size>() ||
                    timeStepsPerYear != Null<Size>(),
                    "no time steps provided");
@@ -143,12 +156,21 @@ namespace QuantLib {
     void MCLongstaffSchwartzPathEngine<GenericEngine,MC,RNG,S>::calculate() 
     const {
         pathPricer_ = this->lsmPathPricer();
-        this->mcModel_ = boost::shared_ptr<MonteCarloModel<MC,RNG,S> >(
-                          new MonteCarloModel<MC,RNG,S>
-                              (pathGenerator(), pathPricer_,
-                               stats_type(), this->antitheticVariate_));
-
-        this->mcModel_->addSamples(nCalibrationSamples_);
+        if (streamingCalibration_)
+            pathPricer_->startStreamingCalibration();
+
+        // in streaming mode, each pass replays the same paths; a
+        // null seed would give a new one to each pass, so that one is
+        // drawn here for all of them
+        BigNatural seed =
+            seed_ != 0 ? seed_ : SeedGenerator::instance().get();
+        do {
+            this->mcModel_ = boost::shared_ptr<MonteCarloModel<MC,RNG,S> >(
+                              new MonteCarloModel<MC,RNG,S>
+                                  (pathGenerator(seed), pathPricer_,
+                                   stats_type(), this->antitheticVariate_));
+            this->mcModel_->addSamples(nCalibrationSamples_);
+        } while (pathPricer_->nextCalibrationPass());
         this->pathPricer_->calibrate();
 
         McSimulation<MC,RNG,S>::calculate(requiredTolerance_,
@@ -187,11 +209,21 @@ namespace QuantLib {
     MCLongstaffSchwartzPathEngine<GenericEngine,MC,RNG,S>::path_generator_type>
     MCLongstaffSchwartzPathEngine<GenericEngine,MC,RNG,S>::pathGenerator() 
     const {
+        return pathGenerator(seed_);
+    }
+
+    template <class GenericEngine, template <class> class MC,
+              class RNG, class S>
+    inline
+    boost::shared_ptr<typename
+    MCLongstaffSchwartzPathEngine<GenericEngine,MC,RNG,S>::path_generator_type>
+    MCLongstaffSchwartzPathEngine<GenericEngine,MC,RNG,S>::pathGenerator(
+                                                     BigNatural seed) const {
 
         Size dimensions = process_->factors();
         TimeGrid grid = this->timeGrid();
         typename RNG::rsg_type generator =
-            RNG::make_sequence_generator(dimensions*(grid.size()-1),seed_);
+            RNG::make_sequence_generator(dimensions*(grid.size()-1),seed);
         return boost::shared_ptr<path_generator_type>(
                    new path_generator_type(process_,
                                            grid, generator, brownianBridge_));
@@ -90,4 +90,13 @@ namespace QuantLib {
         }
     }
 
+    void ExtendedBlackScholesMertonProcess::evolve(Time t0, Time dt, Size n,
+                                                   const Real* x0,
+                                                   const Real* dw,
+                                                   Real* x) const {
+        // the chosen scheme might not be the one implemented in
+        // the base class
+        StochasticProcess1D::evolve(t0, dt, n, x0, dw, x);
+    }
+
 }
@@ -48,6 +48,8 @@ namespace QuantLib {
         Real drift(Time t, Real x) const;
         Real diffusion(Time t, Real x) const;
         Real evolve(Time t0, Real x0, Time dt, Real dw) const;
+        void evolve(Time t0, Time dt, Size n,
+                    const Real* x0, const Real* dw, Real* x) const;
       private:
         const Discretization discretization_;
     };
@@ -107,4 +107,12 @@ namespace QuantLib {
         }
     }
 
+    void VegaStressedBlackScholesProcess::evolve(Time t0, Time dt, Size n,
+                                                 const Real* x0,
+                                                 const Real* dw,
+                                                 Real* x) const {
+        // the stressed volatility depends on the asset value
+        StochasticProcess1D::evolve(t0, dt, n, x0, dw, x);
+    }
+
 }
@@ -47,6 +47,8 @@ namespace QuantLib {
         //! \name StochasticProcess1D interface
         //@{
         Real diffusion(Time t, Real x) const;
+        void evolve(Time t0, Time dt, Size n,
+                    const Real* x0, const Real* dw, Real* x) const;
         //@}
         //! \name interface for vega stress test
         //@{
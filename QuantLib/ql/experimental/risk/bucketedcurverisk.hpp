@@ -0,0 +1,205 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file bucketedcurverisk.hpp
+    \brief bucketed sensitivities to the quotes of a bootstrapped curve
+*/
+
+#ifndef quantlib_bucketed_curve_risk_hpp
+#define quantlib_bucketed_curve_risk_hpp
+
+#include <ql/cashflows/compiledleg.hpp>
+#include <ql/math/matrix.hpp>
+#include <ql/termstructures/yieldtermstructure.hpp>
+#include <boost/shared_ptr.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! bucketed sensitivities to the quotes of a bootstrapped curve
+    /*! The sensitivities of the NPV of a set of legs to the quotes
+        of the helpers used to bootstrap a curve are obtained by
+        composing the sensitivities of the NPV to the curve nodes
+        with the Jacobian of the nodes with respect to the quotes,
+        as returned by the curve.
+
+        The curve is bootstrapped only once; the node sensitivities
+        are calculated by central differences on a copy of the
+        underlying interpolated curve, whose nodes are bumped in
+        turn. The times of the cash flows of all the legs are
+        calculated once, and each bumped curve is evaluated with a
+        single vectorized call to discounts() over all of them.
+        This replaces the (quotes x instruments) rebootstraps and
+        repricings required by bump-and-rebuild analysis.
+
+        \note the interpolations don't provide derivatives with
+              respect to their nodes, so that two evaluations of
+              the curve per node are still needed.
+
+        The Curve class must provide the jacobian() method, e.g., a
+        PiecewiseYieldCurve using the GlobalBootstrap class.
+
+        \warning the amounts of the cash flows are read when the legs
+                 are compiled, so that only the discounting risk is
+                 measured. Floating-rate coupons forecast on the
+                 same curve should be replaced by the equivalent
+                 fixed cash flows (e.g., the notional exchanges
+                 replicating a par floating leg) if their forecast
+                 risk is to be included.
+    */
+    template <class Curve>
+    class BucketedCurveRisk {
+      public:
+        BucketedCurveRisk(const boost::shared_ptr<Curve>& curve,
+                          Real nodeBump = 1.0e-6);
+        //! derivatives of the NPV with respect to the curve nodes
+        /*! The \f$ i \f$-th element is the derivative with respect
+            to the \f$ (i+1) \f$-th curve datum; the first datum is
+            fixed by the bootstrap and is excluded.
+
+            Empty quantities vector is considered as unit vector.
+        */
+        Disposable<Array>
+        nodeSensitivities(const std::vector<CompiledLeg>& legs,
+                          const std::vector<Real>& quantities =
+                                                  std::vector<Real>()) const;
+        //! derivatives of the NPV with respect to the helper quotes
+        /*! The elements follow the order in which the helpers were
+            passed to the curve.
+
+            Empty quantities vector is considered as unit vector.
+        */
+        Disposable<Array> deltas(const std::vector<CompiledLeg>& legs,
+                                 const std::vector<Real>& quantities =
+                                                  std::vector<Real>()) const;
+        Disposable<Array> deltas(const CompiledLeg& leg) const;
+      private:
+        typedef typename Curve::traits_type::template curve<
+                     typename Curve::interpolator_type>::type base_curve;
+        // copy of the underlying curve with writable nodes
+        class NodeCurve : public base_curve {
+          public:
+            NodeCurve(const base_curve& curve) : base_curve(curve) {}
+            Real node(Size i) const { return this->data_[i]; }
+            Size nodes() const { return this->data_.size(); }
+            void setNode(Size i, Real value) {
+                this->data_[i] = value;
+                this->interpolation_.update();
+            }
+        };
+        static Real npv(const std::vector<CompiledLeg>& legs,
+                        const std::vector<Real>& quantities,
+                        const Array& discounts);
+        boost::shared_ptr<Curve> curve_;
+        Real nodeBump_;
+    };
+
+
+    // template definitions
+
+    template <class Curve>
+    BucketedCurveRisk<Curve>::BucketedCurveRisk(
+                                         const boost::shared_ptr<Curve>& curve,
+                                         Real nodeBump)
+    : curve_(curve), nodeBump_(nodeBump) {
+        QL_REQUIRE(curve_, "null curve");
+        QL_REQUIRE(nodeBump_ > 0.0,
+                   "positive node bump required: " << nodeBump_ << " given");
+    }
+
+    template <class Curve>
+    Real BucketedCurveRisk<Curve>::npv(const std::vector<CompiledLeg>& legs,
+                                       const std::vector<Real>& quantities,
+                                       const Array& discounts) {
+        // the discounts at the payment dates of each leg in turn,
+        // followed by the discounts at the npv date of each leg
+        Real result = 0.0;
+        Size offset = 0, n = discounts.size()-legs.size();
+        for (Size k=0; k<legs.size(); ++k) {
+            const std::vector<Real>& amounts = legs[k].amounts();
+            Real q = quantities.empty() ? 1.0 : quantities[k];
+            if (q != 0.0) {
+                Real legNPV = 0.0;
+                for (Size i=0; i<amounts.size(); ++i)
+                    legNPV += amounts[i] * discounts[offset+i];
+                result += q * legNPV/discounts[n+k];
+            }
+            offset += amounts.size();
+        }
+        return result;
+    }
+
+    template <class Curve>
+    Disposable<Array> BucketedCurveRisk<Curve>::nodeSensitivities(
+                                   const std::vector<CompiledLeg>& legs,
+                                   const std::vector<Real>& quantities) const {
+        QL_REQUIRE(quantities.empty() || quantities.size() == legs.size(),
+                   "dimension mismatch between legs (" << legs.size() <<
+                   ") and quantities (" << quantities.size() << ")");
+
+        // the Jacobian is requested first to make sure that the
+        // curve is bootstrapped before its nodes are copied
+        curve_->jacobian();
+        NodeCurve nodeCurve(*curve_);
+
+        // the times don't depend on the nodes
+        std::vector<Time> times;
+        for (Size k=0; k<legs.size(); ++k) {
+            const std::vector<Date>& dates = legs[k].dates();
+            for (Size i=0; i<dates.size(); ++i)
+                times.push_back(nodeCurve.timeFromReference(dates[i]));
+        }
+        for (Size k=0; k<legs.size(); ++k)
+            times.push_back(nodeCurve.timeFromReference(legs[k].npvDate()));
+
+        Array result(nodeCurve.nodes()-1), discounts;
+        for (Size i=1; i<nodeCurve.nodes(); ++i) {
+            Real value = nodeCurve.node(i);
+            nodeCurve.setNode(i, value + nodeBump_);
+            nodeCurve.discounts(times, discounts);
+            Real up = npv(legs, quantities, discounts);
+            nodeCurve.setNode(i, value - nodeBump_);
+            nodeCurve.discounts(times, discounts);
+            Real down = npv(legs, quantities, discounts);
+            nodeCurve.setNode(i, value);
+            result[i-1] = (up - down)/(2.0*nodeBump_);
+        }
+        return result;
+    }
+
+    template <class Curve>
+    Disposable<Array> BucketedCurveRisk<Curve>::deltas(
+                                   const std::vector<CompiledLeg>& legs,
+                                   const std::vector<Real>& quantities) const {
+        Array sensitivities = nodeSensitivities(legs, quantities);
+        const Matrix& jacobian = curve_->jacobian();
+        QL_REQUIRE(jacobian.rows() == sensitivities.size(),
+                   "the curve Jacobian has " << jacobian.rows() <<
+                   " rows, " << sensitivities.size() << " required");
+        Array result = sensitivities * jacobian;
+        return result;
+    }
+
+    template <class Curve>
+    Disposable<Array>
+    BucketedCurveRisk<Curve>::deltas(const CompiledLeg& leg) const {
+        return deltas(std::vector<CompiledLeg>(1, leg));
+    }
+
+}
+
+#endif
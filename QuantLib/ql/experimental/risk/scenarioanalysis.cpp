@@ -0,0 +1,162 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/risk/scenarioanalysis.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/instrument.hpp>
+#include <ql/indexes/indexmanager.hpp>
+#include <ql/settings.hpp>
+#include <algorithm>
+#include <string>
+
+// without thread-local sessions, the workers would share (and
+// notify) the settings and the index fixings
+#if defined(_OPENMP) && defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+#define QL_PARALLEL_SCENARIOS
+#endif
+
+using std::vector;
+using boost::shared_ptr;
+
+namespace QuantLib {
+
+    namespace {
+
+        // settings and fixings of the calling thread, to be copied
+        // into the singletons of the worker threads
+        class SessionState {
+          public:
+            SessionState()
+            : settings_(&Settings::instance()),
+              evaluationDate_(Settings::instance().evaluationDate()),
+              includeReferenceDateEvents_(
+                  Settings::instance().includeReferenceDateEvents()),
+              includeTodaysCashFlows_(
+                  Settings::instance().includeTodaysCashFlows()),
+              enforcesTodaysHistoricFixings_(
+                  Settings::instance().enforcesTodaysHistoricFixings()),
+              names_(IndexManager::instance().histories()) {
+                for (Size i=0; i<names_.size(); ++i)
+                    fixings_.push_back(
+                              IndexManager::instance().getHistory(names_[i]));
+            }
+            void restore() const {
+                // nothing to do if the singletons are shared
+                if (&Settings::instance() == settings_)
+                    return;
+                Settings& settings = Settings::instance();
+                settings.evaluationDate() = evaluationDate_;
+                settings.includeReferenceDateEvents() =
+                    includeReferenceDateEvents_;
+                settings.includeTodaysCashFlows() = includeTodaysCashFlows_;
+                settings.enforcesTodaysHistoricFixings() =
+                    enforcesTodaysHistoricFixings_;
+                for (Size i=0; i<names_.size(); ++i)
+                    IndexManager::instance().setHistory(names_[i],
+                                                        fixings_[i]);
+            }
+          private:
+            const Settings* settings_;
+            Date evaluationDate_;
+            bool includeReferenceDateEvents_;
+            boost::optional<bool> includeTodaysCashFlows_;
+            bool enforcesTodaysHistoricFixings_;
+            vector<std::string> names_;
+            vector<TimeSeries<Real> > fixings_;
+        };
+
+    }
+
+    Matrix scenarioAnalysis(const vector<Handle<Quote> >& baseQuotes,
+                            const Matrix& shifts,
+                            const PortfolioBuilder& builder,
+                            Size workers) {
+        const Size nQuotes = baseQuotes.size();
+        const Size nScenarios = shifts.rows();
+        QL_REQUIRE(shifts.columns() == nQuotes,
+                   "dimension mismatch between base quotes (" << nQuotes <<
+                   ") and scenario shifts (" << shifts.columns() << ")");
+        QL_REQUIRE(workers > 0, "null number of workers given");
+
+        vector<Real> baseValues(nQuotes);
+        for (Size k=0; k<nQuotes; ++k)
+            baseValues[k] = baseQuotes[k]->value();
+
+        if (workers > nScenarios)
+            workers = std::max<Size>(nScenarios, 1);
+
+        const SessionState session;
+
+        // each worker fills its own rows
+        vector<vector<Real> > npvs(nScenarios);
+        vector<std::string> errors(workers);
+        const long n = static_cast<long>(workers);
+        #if defined(QL_PARALLEL_SCENARIOS)
+        #pragma omp parallel for schedule(static,1) num_threads(n)
+        #endif
+        for (long w = 0; w < n; ++w) {
+            const Size i = static_cast<Size>(w);
+            try {
+                const Size chunk = nScenarios/workers,
+                           extra = nScenarios%workers;
+                const Size first = i*chunk + std::min(i, extra),
+                           last = first + chunk + (i < extra ? 1 : 0);
+                if (first == last)
+                    continue;
+
+                session.restore();
+
+                vector<shared_ptr<SimpleQuote> > quotes(nQuotes);
+                vector<Handle<Quote> > handles(nQuotes);
+                for (Size k=0; k<nQuotes; ++k) {
+                    quotes[k] = shared_ptr<SimpleQuote>(
+                                            new SimpleQuote(baseValues[k]));
+                    handles[k] = Handle<Quote>(quotes[k]);
+                }
+                vector<shared_ptr<Instrument> > instruments =
+                    builder.build(handles);
+
+                for (Size s=first; s<last; ++s) {
+                    for (Size k=0; k<nQuotes; ++k)
+                        quotes[k]->setValue(baseValues[k] + shifts[s][k]);
+                    npvs[s].resize(instruments.size());
+                    for (Size j=0; j<instruments.size(); ++j)
+                        npvs[s][j] = instruments[j]->NPV();
+                }
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+            } catch (...) {
+                errors[i] = "unknown error";
+            }
+        }
+
+        for (Size i=0; i<workers; ++i)
+            QL_REQUIRE(errors[i].empty(),
+                       "worker " << i << " failed: " << errors[i]);
+
+        const Size nInstruments = nScenarios > 0 ? npvs[0].size() : 0;
+        Matrix result(nScenarios, nInstruments);
+        for (Size s=0; s<nScenarios; ++s) {
+            QL_ENSURE(npvs[s].size() == nInstruments,
+                      "portfolio builder returned different numbers "
+                      "of instruments");
+            std::copy(npvs[s].begin(), npvs[s].end(), result.row_begin(s));
+        }
+        return result;
+    }
+
+}
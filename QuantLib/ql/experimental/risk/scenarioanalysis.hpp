@@ -0,0 +1,83 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file scenarioanalysis.hpp
+    \brief repricing of a portfolio under a set of market scenarios
+*/
+
+#ifndef quantlib_scenario_analysis_hpp
+#define quantlib_scenario_analysis_hpp
+
+#include <ql/handle.hpp>
+#include <ql/quote.hpp>
+#include <ql/math/matrix.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    class Instrument;
+
+    //! builds a copy of a portfolio on a given set of quotes
+    /*! Derived classes build the term structures, indexes and
+        instruments of a portfolio on top of the passed quotes.  Each
+        call must return an independent copy, i.e., one that doesn't
+        share quotes, relinkable handles or lazy objects (term
+        structures, instruments) with other copies; objects that are
+        not modified after construction, such as calendars, schedules
+        or day counters, can be shared among all copies.
+    */
+    class PortfolioBuilder {
+      public:
+        virtual ~PortfolioBuilder() {}
+        virtual std::vector<boost::shared_ptr<Instrument> >
+        build(const std::vector<Handle<Quote> >& quotes) const = 0;
+    };
+
+    //! NPVs of a portfolio under a set of market scenarios
+    /*! returns a matrix whose \f$ (i,j) \f$ element is the NPV of the
+        \f$ j \f$-th instrument in the \f$ i \f$-th scenario.  In the
+        \f$ i \f$-th scenario, the \f$ k \f$-th quote has the value of
+        the \f$ k \f$-th base quote plus the \f$ (i,k) \f$ element of
+        the shift matrix.
+
+        The scenarios are split in contiguous chunks among the given
+        number of workers.  Each worker builds its own copy of the
+        portfolio on a set of SimpleQuote instances and moves it from
+        one scenario to the next; since a quote only notifies its
+        observers when its value changes, only the parts of the
+        portfolio depending on changed quotes are recalculated.
+
+        The workers run on separate threads when QuantLib is compiled
+        with OpenMP support and thread-local sessions are enabled;
+        otherwise, they run in sequence on the calling thread, since
+        their portfolios would share the settings and the index
+        fixings.  Each worker thread copies the settings and the
+        index fixings of the calling thread before building its
+        portfolio.
+
+        \note results can differ with the number of workers within the
+              accuracy of iterative calculations (e.g., curve
+              bootstrapping) which reuse the previous result as a guess.
+    */
+    Matrix scenarioAnalysis(const std::vector<Handle<Quote> >& baseQuotes,
+                            const Matrix& shifts,
+                            const PortfolioBuilder& builder,
+                            Size workers = 1);
+
+}
+
+#endif
@@ -21,6 +21,14 @@
 
 namespace QuantLib {
 
+    void Index::fixings(const std::vector<Date>& fixingDates,
+                        std::vector<Real>& result,
+                        bool forecastTodaysFixing) const {
+        result.resize(fixingDates.size());
+        for (Size i=0; i<fixingDates.size(); ++i)
+            result[i] = fixing(fixingDates[i], forecastTodaysFixing);
+    }
+
     void Index::addFixing(const Date& fixingDate,
                           Real fixing,
                           bool forceOverwrite) {
@@ -60,6 +60,14 @@ namespace QuantLib {
         */
         virtual Real fixing(const Date& fixingDate,
                             bool forecastTodaysFixing = false) const = 0;
+        //! returns the fixings at the given dates
+        /*! The results are the same as calling fixing() for each
+            date; derived classes can override this method so that
+            the stored fixings are looked up only once.
+        */
+        virtual void fixings(const std::vector<Date>& fixingDates,
+                             std::vector<Real>& result,
+                             bool forecastTodaysFixing = false) const;
         //! returns the fixing TimeSeries
         const TimeSeries<Real>& timeSeries() const {
             return IndexManager::instance().getHistory(name());
@@ -0,0 +1,251 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/indexes/fixingstore.hpp>
+#include <ql/indexes/indexmanager.hpp>
+#include <boost/algorithm/string/case_conv.hpp>
+#include <boost/cstdint.hpp>
+#include <cstring>
+#include <fstream>
+
+#if defined(BOOST_HAS_UNISTD_H)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define QL_FIXING_STORE_MMAP
+#endif
+
+using boost::algorithm::to_upper_copy;
+using std::string;
+
+namespace QuantLib {
+
+    namespace {
+
+        const char magic[8] = { 'Q', 'L', 'F', 'I', 'X', 'I', 'N', 'G' };
+        const boost::uint32_t byteOrderMark = 0x01020304;
+
+        struct Header {
+            char magic[8];
+            boost::uint32_t byteOrder;
+            boost::uint32_t size;
+        };
+
+        // the number of bytes used by n elements of the given type,
+        // rounded up so that the next block is aligned for doubles
+        template <class T>
+        boost::uint64_t blockSize(Size n) {
+            boost::uint64_t bytes = boost::uint64_t(n)*sizeof(T);
+            return (bytes + 7) & ~boost::uint64_t(7);
+        }
+
+        // whether the given number of bytes at the given offset lie
+        // within the file; each value read from the file is compared
+        // with the file size on its own, so that no sum can overflow
+        bool fits(boost::uint64_t offset, boost::uint64_t bytes,
+                  boost::uint64_t length) {
+            return offset <= length && bytes <= length - offset;
+        }
+
+    }
+
+    struct FixingStore::Entry {
+        boost::uint64_t nameOffset;
+        boost::uint64_t dataOffset;
+        boost::uint32_t nameLength;
+        boost::uint32_t fixings;
+    };
+
+
+    FixingStore::FixingStore(const string& filename)
+    : data_(0), length_(0), size_(0), mapped_(false) {
+        map(filename);
+
+        QL_REQUIRE(length_ >= sizeof(Header),
+                   filename << " is not a fixing store: file too short");
+        const Header* header = reinterpret_cast<const Header*>(data_);
+        QL_REQUIRE(std::memcmp(header->magic, magic, sizeof(magic)) == 0,
+                   filename << " is not a fixing store: wrong signature");
+        QL_REQUIRE(header->byteOrder == byteOrderMark,
+                   "fixing store " << filename <<
+                   " was written with a different byte order");
+        size_ = header->size;
+        QL_REQUIRE(size_ <= (length_ - sizeof(Header))/sizeof(Entry),
+                   "fixing store " << filename << " is truncated");
+
+        // the positions are checked once here, so that the
+        // inspectors can use them without further tests
+        for (Size i=0; i<size_; ++i) {
+            const Entry& e = entry(i);
+            boost::uint64_t values = blockSize<double>(e.fixings),
+                            serials = blockSize<boost::int32_t>(e.fixings);
+            QL_REQUIRE(fits(e.nameOffset, e.nameLength, length_) &&
+                       e.dataOffset % 8 == 0 &&
+                       fits(e.dataOffset, values, length_) &&
+                       fits(e.dataOffset + values, serials, length_),
+                       "fixing store " << filename << " is corrupted");
+        }
+    }
+
+    FixingStore::~FixingStore() {
+        #if defined(QL_FIXING_STORE_MMAP)
+        if (mapped_)
+            munmap(const_cast<char*>(data_), length_);
+        #endif
+    }
+
+    void FixingStore::map(const string& filename) {
+        #if defined(QL_FIXING_STORE_MMAP)
+        int fd = open(filename.c_str(), O_RDONLY);
+        QL_REQUIRE(fd != -1, "unable to open " << filename);
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            void* p = mmap(0, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+            if (p != MAP_FAILED) {
+                data_ = static_cast<const char*>(p);
+                length_ = info.st_size;
+                mapped_ = true;
+            }
+        }
+        close(fd);
+        if (mapped_)
+            return;
+        #endif
+
+        // fall back to reading the whole file
+        std::ifstream file(filename.c_str(),
+                           std::ios::in | std::ios::binary);
+        QL_REQUIRE(file, "unable to open " << filename);
+        file.seekg(0, std::ios::end);
+        buffer_.resize(file.tellg());
+        file.seekg(0, std::ios::beg);
+        if (!buffer_.empty())
+            file.read(&buffer_[0], buffer_.size());
+        QL_REQUIRE(file, "unable to read " << filename);
+        data_ = buffer_.empty() ? 0 : &buffer_[0];
+        length_ = buffer_.size();
+    }
+
+    const FixingStore::Entry& FixingStore::entry(Size i) const {
+        QL_REQUIRE(i < size_,
+                   "history #" << i << " requested, "
+                   << size_ << " available");
+        return reinterpret_cast<const Entry*>(data_ + sizeof(Header))[i];
+    }
+
+    string FixingStore::name(Size i) const {
+        const Entry& e = entry(i);
+        return string(data_ + e.nameOffset, e.nameLength);
+    }
+
+    Size FixingStore::fixings(Size i) const {
+        return entry(i).fixings;
+    }
+
+    TimeSeries<Real> FixingStore::history(Size i) const {
+        const Entry& e = entry(i);
+        const double* values =
+            reinterpret_cast<const double*>(data_ + e.dataOffset);
+        const boost::int32_t* serials =
+            reinterpret_cast<const boost::int32_t*>(
+                         data_ + e.dataOffset + blockSize<double>(e.fixings));
+        std::vector<Date> dates(e.fixings);
+        for (Size j=0; j<e.fixings; ++j)
+            dates[j] = Date(serials[j]);
+        return TimeSeries<Real>(dates.begin(), dates.end(), values);
+    }
+
+    void FixingStore::write(const string& filename,
+                            const std::vector<string>& names,
+                            const std::vector<TimeSeries<Real> >& histories) {
+        QL_REQUIRE(names.size() == histories.size(),
+                   "mismatch between number of names (" << names.size() <<
+                   ") and histories (" << histories.size() << ")");
+        Size n = names.size();
+
+        // layout
+        Header header;
+        std::memcpy(header.magic, magic, sizeof(magic));
+        header.byteOrder = byteOrderMark;
+        header.size = boost::uint32_t(n);
+        std::vector<Entry> entries(n);
+        boost::uint64_t offset = sizeof(Header) + n*sizeof(Entry);
+        for (Size i=0; i<n; ++i) {
+            entries[i].nameOffset = offset;
+            entries[i].nameLength = boost::uint32_t(names[i].size());
+            offset += names[i].size();
+        }
+        offset = (offset + 7) & ~boost::uint64_t(7);
+        for (Size i=0; i<n; ++i) {
+            Size fixings = histories[i].size();
+            entries[i].dataOffset = offset;
+            entries[i].fixings = boost::uint32_t(fixings);
+            offset += blockSize<double>(fixings)
+                    + blockSize<boost::int32_t>(fixings);
+        }
+
+        std::ofstream file(filename.c_str(),
+                           std::ios::out | std::ios::binary);
+        QL_REQUIRE(file, "unable to open " << filename << " for writing");
+        file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+        if (n > 0)
+            file.write(reinterpret_cast<const char*>(&entries[0]),
+                       n*sizeof(Entry));
+        Size position = sizeof(Header) + n*sizeof(Entry);
+        for (Size i=0; i<n; ++i) {
+            string name = to_upper_copy(names[i]);
+            file.write(name.data(), name.size());
+            position += name.size();
+        }
+        const char padding[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+        file.write(padding, entries.empty() ? 0 :
+                                      entries[0].dataOffset - position);
+        for (Size i=0; i<n; ++i) {
+            Size fixings = entries[i].fixings;
+            std::vector<double> values;
+            std::vector<boost::int32_t> serials;
+            values.reserve(fixings);
+            serials.reserve(fixings);
+            for (TimeSeries<Real>::const_iterator d = histories[i].begin();
+                 d != histories[i].end(); ++d) {
+                serials.push_back(boost::int32_t(d->first.serialNumber()));
+                values.push_back(d->second);
+            }
+            if (fixings > 0) {
+                file.write(reinterpret_cast<const char*>(&values[0]),
+                           blockSize<double>(fixings));
+                file.write(reinterpret_cast<const char*>(&serials[0]),
+                           fixings*sizeof(boost::int32_t));
+                file.write(padding, blockSize<boost::int32_t>(fixings)
+                                    - fixings*sizeof(boost::int32_t));
+            }
+        }
+        QL_REQUIRE(file, "unable to write " << filename);
+    }
+
+    void FixingStore::write(const string& filename) {
+        const IndexManager& manager = IndexManager::instance();
+        std::vector<string> names = manager.histories();
+        std::vector<TimeSeries<Real> > histories;
+        histories.reserve(names.size());
+        for (Size i=0; i<names.size(); ++i)
+            histories.push_back(manager.getHistory(names[i]));
+        write(filename, names, histories);
+    }
+
+}
@@ -0,0 +1,91 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fixingstore.hpp
+    \brief binary file of index fixings
+*/
+
+#ifndef quantlib_fixing_store_hpp
+#define quantlib_fixing_store_hpp
+
+#include <ql/timeseries.hpp>
+#include <boost/noncopyable.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! binary file of index fixings
+    /*! The file holds the histories of a number of indexes in a
+        layout that can be used in place: a header, a table with the
+        name and the position of each history, and for each history
+        the array of fixing values followed by the array of date
+        serial numbers. Numbers are stored in the byte order of the
+        machine that wrote the file, which is checked when reading.
+
+        Where supported (i.e., on POSIX systems) the file is mapped in
+        memory rather than read, so that opening it costs the same
+        regardless of its size; only the pages of the histories that
+        are actually requested are loaded by the operating system.
+        Elsewhere, the file is read into memory as a single block.
+        In both cases, no parsing is performed until a history is
+        requested.
+
+        Stores are usually passed to IndexManager::loadHistories(),
+        which builds the TimeSeries of an index only when its
+        fixings are first requested.
+
+        \note index names are stored in upper case.
+    */
+    class FixingStore : private boost::noncopyable {
+      public:
+        explicit FixingStore(const std::string& filename);
+        ~FixingStore();
+        //! \name Inspectors
+        //@{
+        //! number of stored histories
+        Size size() const { return size_; }
+        //! name of the i-th stored history
+        std::string name(Size i) const;
+        //! number of fixings in the i-th stored history
+        Size fixings(Size i) const;
+        //! the i-th stored history
+        TimeSeries<Real> history(Size i) const;
+        //@}
+        //! \name Writers
+        //@{
+        //! writes the given histories to a file
+        static void write(const std::string& filename,
+                          const std::vector<std::string>& names,
+                          const std::vector<TimeSeries<Real> >& histories);
+        //! writes all the histories stored in the IndexManager
+        static void write(const std::string& filename);
+        //@}
+      private:
+        struct Entry;
+        const Entry& entry(Size i) const;
+        void map(const std::string& filename);
+        const char* data_;
+        Size length_, size_;
+        // used when the file cannot be mapped
+        std::vector<char> buffer_;
+        bool mapped_;
+    };
+
+}
+
+
+#endif
@@ -18,47 +18,110 @@
 */
 
 #include <ql/indexes/indexmanager.hpp>
+#include <ql/indexes/fixingstore.hpp>
 #include <boost/algorithm/string/case_conv.hpp>
+#include <algorithm>
 
 using boost::algorithm::to_upper_copy;
 using std::string;
 
 namespace QuantLib {
 
+    const boost::shared_ptr<IndexManager::history_type>&
+    IndexManager::entry(const string& name) const {
+        string key = to_upper_copy(name);
+        history_map::const_iterator i = data_.find(key);
+        if (i != data_.end())
+            return i->second;
+        // no observers can be registered yet, so that a pending
+        // history can be read without notifications
+        boost::shared_ptr<history_type> h;
+        pending_map::iterator p = pending_.find(key);
+        if (p != pending_.end()) {
+            h = boost::shared_ptr<history_type>(new
+                history_type(p->second.first->history(p->second.second)));
+            pending_.erase(p);
+        } else {
+            h = boost::shared_ptr<history_type>(new history_type);
+        }
+        return data_[key] = h;
+    }
+
     bool IndexManager::hasHistory(const string& name) const {
-        return data_.find(to_upper_copy(name)) != data_.end();
+        string key = to_upper_copy(name);
+        history_map::const_iterator i = data_.find(key);
+        if (i != data_.end())
+            return !i->second->value().empty();
+        pending_map::const_iterator p = pending_.find(key);
+        return p != pending_.end() &&
+               p->second.first->fixings(p->second.second) > 0;
     }
 
     const TimeSeries<Real>&
     IndexManager::getHistory(const string& name) const {
-        return data_[to_upper_copy(name)].value();
+        return entry(name)->value();
+    }
+
+    boost::shared_ptr<const ObservableValue<TimeSeries<Real> > >
+    IndexManager::history(const string& name) const {
+        return entry(name);
     }
 
     void IndexManager::setHistory(const string& name,
                                   const TimeSeries<Real>& history) {
-        data_[to_upper_copy(name)] = history;
+        *entry(name) = history;
     }
 
     boost::shared_ptr<Observable>
     IndexManager::notifier(const string& name) const {
-        return data_[to_upper_copy(name)];
+        return *entry(name);
     }
 
     std::vector<string> IndexManager::histories() const {
         std::vector<string> temp;
-        temp.reserve(data_.size());
+        temp.reserve(data_.size() + pending_.size());
         for (history_map::const_iterator i=data_.begin();
-             i!=data_.end(); ++i)
-            temp.push_back(i->first);
+             i!=data_.end(); ++i) {
+            if (!i->second->value().empty())
+                temp.push_back(i->first);
+        }
+        for (pending_map::const_iterator p=pending_.begin();
+             p!=pending_.end(); ++p) {
+            if (p->second.first->fixings(p->second.second) > 0)
+                temp.push_back(p->first);
+        }
+        std::sort(temp.begin(), temp.end());
         return temp;
     }
 
     void IndexManager::clearHistory(const string& name) {
-        data_.erase(to_upper_copy(name));
+        string key = to_upper_copy(name);
+        pending_.erase(key);
+        history_map::iterator i = data_.find(key);
+        if (i != data_.end() && !i->second->value().empty())
+            *(i->second) = TimeSeries<Real>();
     }
 
     void IndexManager::clearHistories() {
-        data_.clear();
+        pending_.clear();
+        for (history_map::iterator i=data_.begin(); i!=data_.end(); ++i) {
+            if (!i->second->value().empty())
+                *(i->second) = TimeSeries<Real>();
+        }
+    }
+
+    void IndexManager::loadHistories(const string& filename) {
+        boost::shared_ptr<FixingStore> store(new FixingStore(filename));
+        for (Size i=0; i<store->size(); ++i) {
+            string key = store->name(i);
+            history_map::iterator h = data_.find(key);
+            if (h != data_.end()) {
+                pending_.erase(key);
+                *(h->second) = store->history(i);
+            } else {
+                pending_[key] = std::make_pair(store, i);
+            }
+        }
     }
 
 }
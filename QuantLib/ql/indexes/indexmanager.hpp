@@ -31,6 +31,8 @@
 
 namespace QuantLib {
 
+    class FixingStore;
+
     //! global repository for past index fixings
     /*! \note index names are case insensitive */
     class IndexManager : public Singleton<IndexManager> {
@@ -39,23 +41,64 @@ namespace QuantLib {
         IndexManager() {}
       public:
         //! returns whether historical fixings were stored for the index
+        /*! \note only non-empty histories are reported; this
+                  returns false after clearHistory() was called
+                  for the index, even though history() and
+                  notifier() keep the emptied series alive.
+        */
         bool hasHistory(const std::string& name) const;
         //! returns the (possibly empty) history of the index fixings
         const TimeSeries<Real>& getHistory(const std::string& name) const;
+        //! returns the fixings of the index, resolving its name once
+        /*! The returned object can be kept to access the fixings of
+            the index without further lookups; it reflects any later
+            change of the stored fixings, including their removal.
+        */
+        boost::shared_ptr<const ObservableValue<TimeSeries<Real> > >
+        history(const std::string& name) const;
         //! stores the historical fixings of the index
         void setHistory(const std::string& name, const TimeSeries<Real>&);
         //! observer notifying of changes in the index fixings
         boost::shared_ptr<Observable> notifier(const std::string& name) const;
         //! returns all names of the indexes for which fixings were stored
+        /*! \note as for hasHistory(), empty histories are skipped. */
         std::vector<std::string> histories() const;
         //! clears the historical fixings of the index
+        /*! The stored series is emptied rather than removed, so that
+            the objects returned by history() remain valid; unlike in
+            previous versions, the observers of the index fixings are
+            notified of the change.
+        */
         void clearHistory(const std::string& name);
         //! clears all stored fixings
+        /*! \note as for clearHistory(), the observers of each
+                  non-empty history are notified.
+        */
         void clearHistories();
+        //! loads the histories stored in a binary file
+        /*! The file, written by FixingStore::write(), is mapped in
+            memory and the fixings of each index are read only when
+            first requested.  Histories for which dependents are
+            already registered, i.e., for which notifier() or
+            history() were called, are replaced at once and their
+            observers are notified; the others replace any history
+            stored for the same index.
+        */
+        void loadHistories(const std::string& filename);
       private:
-        typedef std::map<std::string, ObservableValue<TimeSeries<Real> > >
+        typedef ObservableValue<TimeSeries<Real> > history_type;
+        // the stored histories are never removed, so that the
+        // objects returned by history() remain valid
+        typedef std::map<std::string, boost::shared_ptr<history_type> >
                                                                   history_map;
+        const boost::shared_ptr<history_type>&
+        entry(const std::string& name) const;
         mutable history_map data_;
+        // histories not read yet from their stores
+        typedef std::map<std::string,
+                         std::pair<boost::shared_ptr<FixingStore>, Size> >
+                                                                  pending_map;
+        mutable pending_map pending_;
     };
 
 }
@@ -58,39 +58,76 @@ namespace QuantLib {
         registerWith(IndexManager::instance().notifier(name()));
     }
 
-    Rate InterestRateIndex::fixing(const Date& fixingDate,
-                                   bool forecastTodaysFixing) const {
+    const TimeSeries<Real>& InterestRateIndex::history() const {
+        #if defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+        // each session has its own fixings
+        return IndexManager::instance().getHistory(name());
+        #else
+        // the stored histories are never removed, so that the object
+        // returned by the index manager can be kept; name() is
+        // virtual and can't be resolved in the constructor.  The
+        // pointer is read and set atomically, since the first lookup
+        // might happen on several threads at once.
+        boost::shared_ptr<const ObservableValue<TimeSeries<Real> > > h =
+            boost::atomic_load(&history_);
+        if (!h) {
+            h = IndexManager::instance().history(name());
+            boost::atomic_store(&history_, h);
+        }
+        return h->value();
+        #endif
+    }
+
+    Rate InterestRateIndex::fixingImpl(const Date& fixingDate,
+                                       bool forecastTodaysFixing,
+                                       const Date& today,
+                                       bool enforceTodaysFixing,
+                                       const TimeSeries<Real>& past) const {
 
         QL_REQUIRE(isValidFixingDate(fixingDate),
                    "Fixing date " << fixingDate << " is not valid");
 
-        Date today = Settings::instance().evaluationDate();
-
         if (fixingDate>today ||
             (fixingDate==today && forecastTodaysFixing))
             return forecastFixing(fixingDate);
 
-        if (fixingDate<today ||
-            Settings::instance().enforcesTodaysHistoricFixings()) {
+        Rate result = past[fixingDate];
+
+        if (fixingDate<today || enforceTodaysFixing) {
             // must have been fixed
-            // do not catch exceptions
-            Rate result = pastFixing(fixingDate);
             QL_REQUIRE(result != Null<Real>(),
                        "Missing " << name() << " fixing for " << fixingDate);
             return result;
         }
 
-        try {
-            // might have been fixed
-            Rate result = pastFixing(fixingDate);
-            if (result!=Null<Real>())
-                return result;
-            else
-                ;   // fall through and forecast
-        } catch (Error&) {
-                ;   // fall through and forecast
-        }
-        return forecastFixing(fixingDate);
+        // might have been fixed
+        if (result != Null<Real>())
+            return result;
+        else
+            return forecastFixing(fixingDate);
+    }
+
+    Rate InterestRateIndex::fixing(const Date& fixingDate,
+                                   bool forecastTodaysFixing) const {
+        return fixingImpl(fixingDate, forecastTodaysFixing,
+                          Settings::instance().evaluationDate(),
+                          Settings::instance().enforcesTodaysHistoricFixings(),
+                          history());
+    }
+
+    void InterestRateIndex::fixings(const std::vector<Date>& fixingDates,
+                                    std::vector<Rate>& result,
+                                    bool forecastTodaysFixing) const {
+        result.resize(fixingDates.size());
+        // the settings and the fixings are looked up once for all
+        // the dates
+        Date today = Settings::instance().evaluationDate();
+        bool enforceTodaysFixing =
+            Settings::instance().enforcesTodaysHistoricFixings();
+        const TimeSeries<Real>& past = history();
+        for (Size i=0; i<fixingDates.size(); ++i)
+            result[i] = fixingImpl(fixingDates[i], forecastTodaysFixing,
+                                   today, enforceTodaysFixing, past);
     }
 
 }
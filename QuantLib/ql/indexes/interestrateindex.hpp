@@ -52,6 +52,9 @@ namespace QuantLib {
         bool isValidFixingDate(const Date& fixingDate) const;
         Rate fixing(const Date& fixingDate,
                     bool forecastTodaysFixing = false) const;
+        void fixings(const std::vector<Date>& fixingDates,
+                     std::vector<Rate>& result,
+                     bool forecastTodaysFixing = false) const;
         //@}
         //! \name Observer interface
         //@{
@@ -89,8 +92,18 @@ namespace QuantLib {
         Currency currency_;
         DayCounter dayCounter_;
       private:
+        Rate fixingImpl(const Date& fixingDate,
+                        bool forecastTodaysFixing,
+                        const Date& today,
+                        bool enforceTodaysFixing,
+                        const TimeSeries<Real>& past) const;
+        /* the stored fixings, looked up by name at their first use;
+           the lookup can be done concurrently by different threads */
+        const TimeSeries<Real>& history() const;
         std::string name_;
         Calendar fixingCalendar_;
+        mutable boost::shared_ptr<const ObservableValue<TimeSeries<Real> > >
+                                                                   history_;
     };
 
 
@@ -127,7 +140,7 @@ namespace QuantLib {
     inline Rate InterestRateIndex::pastFixing(const Date& fixingDate) const {
         QL_REQUIRE(isValidFixingDate(fixingDate),
                    fixingDate << " is not a valid fixing date");
-        return timeSeries()[fixingDate];
+        return history()[fixingDate];
     }
 
 }
@@ -24,6 +24,7 @@
 #include <ql/math/richardsonextrapolation.hpp>
 #include <ql/math/sampledcurve.hpp>
 #include <ql/math/solver1d.hpp>
+#include <ql/math/streaminglinearleastsquares.hpp>
 #include <ql/math/surface.hpp>
 #include <ql/math/transformedgrid.hpp>
 
@@ -52,6 +52,13 @@ namespace QuantLib {
         return result;
     }
 
+    void CumulativeNormalDistribution::operator()(const Real* begin,
+                                                  const Real* end,
+                                                  Real* out) const {
+        for (; begin != end; ++begin, ++out)
+            *out = (*this)(*begin);
+    }
+
     #if !defined(QL_PATCH_SOLARIS)
     const CumulativeNormalDistribution InverseCumulativeNormal::f_;
     #endif
@@ -86,6 +93,42 @@ namespace QuantLib {
     const Real InverseCumulativeNormal::x_low_ = 0.02425;
     const Real InverseCumulativeNormal::x_high_= 1.0 - x_low_;
 
+    void InverseCumulativeNormal::operator()(const Real* begin,
+                                             const Real* end,
+                                             Real* out) const {
+        standard_values(begin, end, out);
+        if (average_ != 0.0 || sigma_ != 1.0) {
+            Size n = end-begin;
+            for (Size i=0; i<n; ++i)
+                out[i] = average_ + sigma_*out[i];
+        }
+    }
+
+    void InverseCumulativeNormal::standard_values(const Real* begin,
+                                                  const Real* end,
+                                                  Real* out) {
+        Size n = end-begin;
+
+        #ifdef REFINE_TO_FULL_MACHINE_PRECISION_USING_HALLEYS_METHOD
+        for (Size i=0; i<n; ++i)
+            out[i] = standard_value(begin[i]);
+        #else
+        // central region for all inputs; no branches, so that the
+        // loop can be vectorized
+        for (Size i=0; i<n; ++i) {
+            Real z = begin[i] - 0.5;
+            Real r = z*z;
+            out[i] = (((((a1_*r+a2_)*r+a3_)*r+a4_)*r+a5_)*r+a6_)*z /
+                (((((b1_*r+b2_)*r+b3_)*r+b4_)*r+b5_)*r+1.0);
+        }
+        // tails, which are rare, are fixed afterwards
+        for (Size i=0; i<n; ++i) {
+            if (begin[i] < x_low_ || x_high_ < begin[i])
+                out[i] = tail_value(begin[i]);
+        }
+        #endif
+    }
+
     Real InverseCumulativeNormal::tail_value(Real x) {
         if (x <= 0.0 || x >= 1.0) {
             // try to recover if due to numerical error
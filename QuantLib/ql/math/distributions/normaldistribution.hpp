@@ -72,6 +72,11 @@ namespace QuantLib {
                                      Real sigma   = 1.0);
         // function
         Real operator()(Real x) const;
+        /*! writes into the range starting at \c out the values of
+            the distribution for the inputs in [\c begin, \c end).
+        */
+        void operator()(const Real* begin, const Real* end,
+                        Real* out) const;
         Real derivative(Real x) const;
       private:
         Real average_, sigma_;
@@ -97,6 +102,7 @@ namespace QuantLib {
       in this case the traditional Box-Muller approach and its
       variants would not preserve the sequence's low-discrepancy.
 
+      \test the array version is checked against the scalar one.
     */
     class InverseCumulativeNormal
         : public std::unary_function<Real,Real> {
@@ -107,6 +113,18 @@ namespace QuantLib {
         Real operator()(Real x) const {
             return average_ + sigma_*standard_value(x);
         }
+        /*! writes into the range starting at \c out the values of
+            the inverse distribution for the inputs in [\c begin,
+            \c end).  The results are the same as those returned by
+            the scalar version; however, the central region is
+            calculated for all inputs in a loop free of branches,
+            which the compiler can vectorize, and the values in the
+            tails are overwritten afterwards.
+
+            \pre the input and output ranges must not overlap.
+        */
+        void operator()(const Real* begin, const Real* end,
+                        Real* out) const;
         // value for average=0, sigma=1
         /* Compared to operator(), this method avoids 2 floating point
            operations (we use average=0 and sigma=1 most of the
@@ -136,6 +154,9 @@ namespace QuantLib {
 
             return z;
         }
+        //! values for average=0, sigma=1 over a range of inputs
+        static void standard_values(const Real* begin, const Real* end,
+                                    Real* out);
       private:
         /* Handling tails moved into a separate method, which should
            make the inlining of operator() and standard_value method
@@ -29,6 +29,7 @@
 #include <ql/math/interpolations/extrapolation.hpp>
 #include <ql/math/comparison.hpp>
 #include <ql/errors.hpp>
+#include <algorithm>
 #include <vector>
 
 namespace QuantLib {
@@ -52,6 +53,11 @@ namespace QuantLib {
             virtual std::vector<Real> yValues() const = 0;
             virtual bool isInRange(Real) const = 0;
             virtual Real value(Real) const = 0;
+            /*! the default implementation ignores the hint;
+                implementations that locate x on the grid should
+                override it.
+            */
+            virtual Real value(Real x, Size&) const { return value(x); }
             virtual Real primitive(Real) const = 0;
             virtual Real derivative(Real) const = 0;
             virtual Real secondDerivative(Real) const = 0;
@@ -103,6 +109,40 @@ namespace QuantLib {
                 else
                     return std::upper_bound(xBegin_,xEnd_-1,x)-xBegin_-1;
             }
+            /*! The given interval, e.g., the one found by the last
+                call, is tried first. If x is beyond it, the search
+                proceeds forward with increasing steps, so that a
+                sequence of increasing x values is located in a
+                single walk over the grid. The hint is set to the
+                interval found, which is the same as above.
+            */
+            Size locate(Real x, Size& hint) const {
+                #if defined(QL_EXTRA_SAFETY_CHECKS)
+                for (I1 i=xBegin_, j=xBegin_+1; j!=xEnd_; ++i, ++j)
+                    QL_REQUIRE(*j > *i, "unsorted x values");
+                #endif
+                Size n = xEnd_-xBegin_;
+                if (x < *xBegin_)
+                    return hint = 0;
+                else if (x > *(xEnd_-1))
+                    return hint = n-2;
+                Size i = std::min<Size>(hint, n-2);
+                if (x < xBegin_[i]) {
+                    i = std::upper_bound(xBegin_,xBegin_+i,x)-xBegin_-1;
+                } else if (x >= xBegin_[i+1]) {
+                    Size lower = i+1, upper = lower+1, step = 1;
+                    while (upper < n-1 && xBegin_[upper] <= x) {
+                        lower = upper;
+                        step *= 2;
+                        upper = lower+step;
+                    }
+                    upper = std::min<Size>(upper, n-1);
+                    i = std::upper_bound(xBegin_+lower,xBegin_+upper,x)
+                        -xBegin_-1;
+                }
+                hint = i;
+                return i;
+            }
             I1 xBegin_, xEnd_;
             I2 yBegin_;
         };
@@ -114,6 +154,30 @@ namespace QuantLib {
             checkRange(x,allowExtrapolation);
             return impl_->value(x);
         }
+        //! value at x, starting the search from a given interval
+        /*! The hint should be initialized to 0 and passed again to
+            the next call, which then starts the search from the
+            interval found by this one. Increasing sequences of
+            points are thus evaluated in a single walk over the
+            interpolation grid; the result doesn't depend on the
+            hint.
+        */
+        Real value(Real x, Size& hint,
+                   bool allowExtrapolation = false) const {
+            checkRange(x,allowExtrapolation);
+            return impl_->value(x, hint);
+        }
+        //! values at a sequence of points
+        /*! Increasing sequences of points are evaluated in a single
+            walk over the interpolation grid.
+        */
+        template <class I, class O>
+        void values(I xBegin, I xEnd, O result,
+                    bool allowExtrapolation = false) const {
+            Size hint = 0;
+            for (; xBegin != xEnd; ++xBegin, ++result)
+                *result = value(*xBegin, hint, allowExtrapolation);
+        }
         Real primitive(Real x, bool allowExtrapolation = false) const {
             checkRange(x,allowExtrapolation);
             return impl_->primitive(x);
@@ -48,9 +48,13 @@ namespace QuantLib {
                 }
             }
             Real value(Real x) const {
+                Size i = this->locate(x);
+                return value(x, i);
+            }
+            Real value(Real x, Size& hint) const {
                 if (x <= this->xBegin_[0])
                     return this->yBegin_[0];
-                Size i = this->locate(x);
+                Size i = this->locate(x, hint);
                 if (x == this->xBegin_[i])
                     return this->yBegin_[i];
                 else
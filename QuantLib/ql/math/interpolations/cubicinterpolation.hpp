@@ -692,6 +692,10 @@ namespace QuantLib {
             }
             Real value(Real x) const {
                 Size j = this->locate(x);
+                return value(x, j);
+            }
+            Real value(Real x, Size& hint) const {
+                Size j = this->locate(x, hint);
                 Real dx_ = x-this->xBegin_[j];
                 return this->yBegin_[j] + dx_*(a_[j] + dx_*(b_[j] + dx_*c_[j]));
             }
@@ -47,10 +47,14 @@ namespace QuantLib {
                 }
             }
             Real value(Real x) const {
+                Size i = this->locate(x);
+                return value(x, i);
+            }
+            Real value(Real x, Size& hint) const {
                 if (x >= this->xBegin_[n_-1])
                     return this->yBegin_[n_-1];
 
-                Size i = this->locate(x);
+                Size i = this->locate(x, hint);
                 return this->yBegin_[i];
             }
             Real primitive(Real x) const {
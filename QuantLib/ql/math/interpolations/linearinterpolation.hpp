@@ -51,6 +51,10 @@ namespace QuantLib {
             }
             Real value(Real x) const {
                 Size i = this->locate(x);
+                return value(x, i);
+            }
+            Real value(Real x, Size& hint) const {
+                Size i = this->locate(x, hint);
                 return this->yBegin_[i] + (x-this->xBegin_[i])*s_[i];
             }
             Real primitive(Real x) const {
@@ -38,8 +38,215 @@
 #pragma warning(pop)
 #endif
 
+#if defined(QL_USE_BLAS)
+#include <cblas.h>
+#endif
+
 namespace QuantLib {
 
+    namespace {
+
+        // Block sizes for the products: a slice of a row of the
+        // result (columnBlock elements) stays in the L1 cache while
+        // a block of innerBlock rows of the right operand is read
+        // from the L2 cache.
+        const Size columnBlock = 256, innerBlock = 128;
+        // tiles used for the transposition
+        const Size transposeBlock = 32;
+
+        #if !defined(QL_USE_BLAS)
+
+        /* c += a*b, with c (m x p), a (m x n), b (n x p) stored by
+           rows. Four rows of the result are updated together, so
+           that each element of b is used four times once loaded;
+           the inner loops run over contiguous memory and can be
+           vectorized by the compiler. If lowerOnly is true, only
+           the elements on or below the diagonal are guaranteed to
+           be calculated. */
+        void multiply(const Real* a, const Real* b, Real* c,
+                      Size m, Size n, Size p, bool lowerOnly = false) {
+            for (Size jj=0; jj<p; jj+=columnBlock) {
+                Size jBlockEnd = std::min(jj+columnBlock, p);
+                for (Size kk=0; kk<n; kk+=innerBlock) {
+                    Size kEnd = std::min(kk+innerBlock, n);
+                    Size i = lowerOnly ? std::min(jj, m) : 0;
+                    for (; i+4<=m; i+=4) {
+                        Size jEnd =
+                            lowerOnly ? std::min(jBlockEnd, i+4) : jBlockEnd;
+                        Real *c0 = c+i*p, *c1 = c0+p,
+                             *c2 = c1+p, *c3 = c2+p;
+                        const Real *a0 = a+i*n, *a1 = a0+n,
+                                   *a2 = a1+n, *a3 = a2+n;
+                        for (Size k=kk; k<kEnd; ++k) {
+                            const Real* bk = b+k*p;
+                            Real x0 = a0[k], x1 = a1[k],
+                                 x2 = a2[k], x3 = a3[k];
+                            for (Size j=jj; j<jEnd; ++j) {
+                                Real y = bk[j];
+                                c0[j] += x0*y;
+                                c1[j] += x1*y;
+                                c2[j] += x2*y;
+                                c3[j] += x3*y;
+                            }
+                        }
+                    }
+                    for (; i<m; ++i) {
+                        Size jEnd =
+                            lowerOnly ? std::min(jBlockEnd, i+1) : jBlockEnd;
+                        Real* ci = c+i*p;
+                        const Real* ai = a+i*n;
+                        for (Size k=kk; k<kEnd; ++k) {
+                            const Real* bk = b+k*p;
+                            Real x = ai[k];
+                            for (Size j=jj; j<jEnd; ++j)
+                                ci[j] += x*bk[j];
+                        }
+                    }
+                }
+            }
+        }
+
+        #endif
+
+        // copies the lower triangle of a square matrix on the upper one
+        void symmetrize(Matrix& m) {
+            for (Size i=0; i<m.rows(); ++i)
+                for (Size j=0; j<i; ++j)
+                    m[j][i] = m[i][j];
+        }
+
+    }
+
+
+    const Disposable<Array> operator*(const Array& v, const Matrix& m) {
+        QL_REQUIRE(v.size() == m.rows(),
+                   "vectors and matrices with different sizes ("
+                   << v.size() << ", " << m.rows() << "x" << m.columns() <<
+                   ") cannot be multiplied");
+        Array result(m.columns(), 0.0);
+        if (m.empty())
+            return result;
+        #if defined(QL_USE_BLAS)
+        cblas_dgemv(CblasRowMajor, CblasTrans, m.rows(), m.columns(),
+                    1.0, m.begin(), m.columns(), v.begin(), 1,
+                    0.0, result.begin(), 1);
+        #else
+        // linear combination of the rows, instead of products of
+        // the vector with the (strided) columns
+        Size n = m.columns();
+        Real* r = result.begin();
+        for (Size i=0; i<m.rows(); ++i) {
+            const Real* mi = m[i];
+            Real x = v[i];
+            for (Size j=0; j<n; ++j)
+                r[j] += x*mi[j];
+        }
+        #endif
+        return result;
+    }
+
+    const Disposable<Array> operator*(const Matrix& m, const Array& v) {
+        QL_REQUIRE(v.size() == m.columns(),
+                   "vectors and matrices with different sizes ("
+                   << v.size() << ", " << m.rows() << "x" << m.columns() <<
+                   ") cannot be multiplied");
+        Array result(m.rows(), 0.0);
+        if (m.empty())
+            return result;
+        #if defined(QL_USE_BLAS)
+        cblas_dgemv(CblasRowMajor, CblasNoTrans, m.rows(), m.columns(),
+                    1.0, m.begin(), m.columns(), v.begin(), 1,
+                    0.0, result.begin(), 1);
+        #else
+        for (Size i=0; i<result.size(); i++)
+            result[i] =
+                std::inner_product(v.begin(),v.end(),m.row_begin(i),0.0);
+        #endif
+        return result;
+    }
+
+    const Disposable<Matrix> operator*(const Matrix& m1, const Matrix& m2) {
+        QL_REQUIRE(m1.columns() == m2.rows(),
+                   "matrices with different sizes (" <<
+                   m1.rows() << "x" << m1.columns() << ", " <<
+                   m2.rows() << "x" << m2.columns() << ") cannot be "
+                   "multiplied");
+        Matrix result(m1.rows(), m2.columns(), 0.0);
+        if (result.empty() || m1.columns() == 0)
+            return result;
+        #if defined(QL_USE_BLAS)
+        cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans,
+                    m1.rows(), m2.columns(), m1.columns(),
+                    1.0, m1.begin(), m1.columns(), m2.begin(), m2.columns(),
+                    0.0, result.begin(), result.columns());
+        #else
+        multiply(m1.begin(), m2.begin(), result.begin(),
+                 m1.rows(), m1.columns(), m2.columns());
+        #endif
+        return result;
+    }
+
+    const Disposable<Matrix> transposedProduct(const Matrix& A,
+                                               const Matrix& B) {
+        QL_REQUIRE(A.rows() == B.rows(),
+                   "matrices with different sizes (" <<
+                   A.rows() << "x" << A.columns() << ", " <<
+                   B.rows() << "x" << B.columns() << ") cannot be "
+                   "multiplied after transposing the first");
+        Matrix result(A.columns(), B.columns(), 0.0);
+        if (result.empty() || A.rows() == 0)
+            return result;
+        #if defined(QL_USE_BLAS)
+        cblas_dgemm(CblasRowMajor, CblasTrans, CblasNoTrans,
+                    A.columns(), B.columns(), A.rows(),
+                    1.0, A.begin(), A.columns(), B.begin(), B.columns(),
+                    0.0, result.begin(), result.columns());
+        #else
+        // the transposition takes O(n^2) operations against the
+        // O(n^3) of the product, and lets the kernel read rows
+        Matrix At = transpose(A);
+        multiply(At.begin(), B.begin(), result.begin(),
+                 At.rows(), At.columns(), B.columns());
+        #endif
+        return result;
+    }
+
+    const Disposable<Matrix> symmetricProduct(const Matrix& A) {
+        Matrix result(A.rows(), A.rows(), 0.0);
+        if (result.empty() || A.columns() == 0)
+            return result;
+        #if defined(QL_USE_BLAS)
+        cblas_dsyrk(CblasRowMajor, CblasLower, CblasNoTrans,
+                    A.rows(), A.columns(),
+                    1.0, A.begin(), A.columns(),
+                    0.0, result.begin(), result.columns());
+        #else
+        Matrix At = transpose(A);
+        multiply(A.begin(), At.begin(), result.begin(),
+                 A.rows(), A.columns(), A.rows(), true);
+        #endif
+        symmetrize(result);
+        return result;
+    }
+
+    const Disposable<Matrix> transpose(const Matrix& m) {
+        Matrix result(m.columns(),m.rows());
+        // tiles are copied in turn, so that both the rows being
+        // read and the ones being written stay in cache
+        for (Size ii=0; ii<m.rows(); ii+=transposeBlock) {
+            Size iEnd = std::min(ii+transposeBlock, m.rows());
+            for (Size jj=0; jj<m.columns(); jj+=transposeBlock) {
+                Size jEnd = std::min(jj+transposeBlock, m.columns());
+                for (Size i=ii; i<iEnd; ++i) {
+                    const Real* mi = m[i];
+                    for (Size j=jj; j<jEnd; ++j)
+                        result[j][i] = mi[j];
+                }
+            }
+        }
+        return result;
+    }
+
     Disposable<Matrix> inverse(const Matrix& m) {
         #if !defined(QL_NO_UBLAS_SUPPORT)
 
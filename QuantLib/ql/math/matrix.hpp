@@ -35,6 +35,11 @@ namespace QuantLib {
     /*! This class implements the concept of Matrix as used in linear
         algebra. As such, it is <b>not</b> meant to be used as a
         container.
+
+        Products of matrices are calculated by cache-blocked kernels
+        whose inner loops run over contiguous rows, so that compilers
+        can vectorize them; when QL_USE_BLAS is defined, they are
+        delegated to an external BLAS library instead.
     */
     class Matrix {
       public:
@@ -153,6 +158,20 @@ namespace QuantLib {
     const Disposable<Array> operator*(const Matrix&, const Array&);
     /*! \relates Matrix */
     const Disposable<Matrix> operator*(const Matrix&, const Matrix&);
+    /*! returns \f$ A^T B \f$ without building the transpose of
+        \f$ A \f$.
+
+        \relates Matrix
+    */
+    const Disposable<Matrix> transposedProduct(const Matrix& A,
+                                               const Matrix& B);
+    /*! returns the symmetric matrix \f$ A A^T \f$, e.g., the
+        covariance matrix corresponding to a pseudo-root. Only half
+        of the products are calculated.
+
+        \relates Matrix
+    */
+    const Disposable<Matrix> symmetricProduct(const Matrix& A);
 
     // misc. operations
 
@@ -495,57 +514,6 @@ namespace QuantLib {
         return temp;
     }
 
-    inline const Disposable<Array> operator*(const Array& v, const Matrix& m) {
-        QL_REQUIRE(v.size() == m.rows(),
-                   "vectors and matrices with different sizes ("
-                   << v.size() << ", " << m.rows() << "x" << m.columns() <<
-                   ") cannot be multiplied");
-        Array result(m.columns());
-        for (Size i=0; i<result.size(); i++)
-            result[i] =
-                std::inner_product(v.begin(),v.end(),
-                                   m.column_begin(i),0.0);
-        return result;
-    }
-
-    inline const Disposable<Array> operator*(const Matrix& m, const Array& v) {
-        QL_REQUIRE(v.size() == m.columns(),
-                   "vectors and matrices with different sizes ("
-                   << v.size() << ", " << m.rows() << "x" << m.columns() <<
-                   ") cannot be multiplied");
-        Array result(m.rows());
-        for (Size i=0; i<result.size(); i++)
-            result[i] =
-                std::inner_product(v.begin(),v.end(),m.row_begin(i),0.0);
-        return result;
-    }
-
-    inline const Disposable<Matrix> operator*(const Matrix& m1,
-                                              const Matrix& m2) {
-        QL_REQUIRE(m1.columns() == m2.rows(),
-                   "matrices with different sizes (" <<
-                   m1.rows() << "x" << m1.columns() << ", " <<
-                   m2.rows() << "x" << m2.columns() << ") cannot be "
-                   "multiplied");
-        Matrix result(m1.rows(),m2.columns());
-        for (Size i=0; i<result.rows(); i++)
-            for (Size j=0; j<result.columns(); j++)
-                result[i][j] =
-                    std::inner_product(m1.row_begin(i), m1.row_end(i),
-                                       m2.column_begin(j), 0.0);
-        return result;
-    }
-
-    inline const Disposable<Matrix> transpose(const Matrix& m) {
-        Matrix result(m.columns(),m.rows());
-        #if defined(QL_PATCH_MSVC) && defined(QL_DEBUG)
-        if (!m.empty())
-        #endif
-        for (Size i=0; i<m.rows(); i++)
-            std::copy(m.row_begin(i),m.row_end(i),result.column_begin(i));
-        return result;
-    }
-
     inline const Disposable<Matrix> outerProduct(const Array& v1,
                                                  const Array& v2) {
         return outerProduct(v1.begin(), v1.end(), v2.begin(), v2.end());
@@ -21,6 +21,28 @@
 
 namespace QuantLib {
 
+    namespace {
+
+        /* scalar product of the first n elements of two rows of the
+           result. The rows are contiguous; four partial sums break
+           the dependency between successive additions, so that they
+           can be pipelined or vectorized. */
+        Real dot(const Real* x, const Real* y, Size n) {
+            Real s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+            Size k = 0;
+            for (; k+4<=n; k+=4) {
+                s0 += x[k]*y[k];
+                s1 += x[k+1]*y[k+1];
+                s2 += x[k+2]*y[k+2];
+                s3 += x[k+3]*y[k+3];
+            }
+            for (; k<n; ++k)
+                s0 += x[k]*y[k];
+            return (s0+s1)+(s2+s3);
+        }
+
+    }
+
     const Disposable<Matrix> CholeskyDecomposition(const Matrix &S,
                                                    bool flexible) {
         Size i, j, size = S.rows();
@@ -37,11 +59,9 @@ namespace QuantLib {
         Matrix result(size, size, 0.0);
         Real sum;
         for (i=0; i<size; i++) {
+            const Real* li = result[i];
             for (j=i; j<size; j++) {
-                sum = S[i][j];
-                for (Integer k=0; k<=Integer(i)-1; k++) {
-                    sum -= result[i][k]*result[j][k];
-                }
+                sum = S[i][j] - dot(li, result[j], i);
                 if (i == j) {
                     QL_REQUIRE(flexible || sum > 0.0,
                                "input matrix is not positive definite");
@@ -44,6 +44,28 @@ namespace QuantLib {
                                ", [" << j << "][" << i << "]=" << matrix[j][i]);
         }
 
+        // the eigenvectors times the diagonal matrix of the square
+        // roots of the eigenvalues (floored at zero), restricted to
+        // the given number of columns; the columns are scaled
+        // directly instead of multiplied by the diagonal matrix.
+        const Disposable<Matrix>
+        spectralRoot(const SymmetricSchurDecomposition& jd, Size columns) {
+            const Matrix& eigenVectors = jd.eigenvectors();
+            const Array& eigenValues = jd.eigenvalues();
+            Size size = eigenVectors.rows();
+            Array roots(columns);
+            for (Size j=0; j<columns; ++j)
+                roots[j] = std::sqrt(std::max<Real>(eigenValues[j], 0.0));
+            Matrix result(size, columns);
+            for (Size i=0; i<size; ++i) {
+                const Real* v = eigenVectors[i];
+                Real* r = result[i];
+                for (Size j=0; j<columns; ++j)
+                    r[j] = v[j]*roots[j];
+            }
+            return result;
+        }
+
         void normalizePseudoRoot(const Matrix& matrix,
                                  Matrix& pseudo) {
             Size size = matrix.rows();
@@ -297,13 +319,8 @@ namespace QuantLib {
             QL_REQUIRE(size == M.columns(),
                        "matrix not square");
 
-            Matrix diagonal(size, size, 0.0);
             SymmetricSchurDecomposition jd(M);
-            for (Size i=0; i<size; ++i)
-                diagonal[i][i] = std::max<Real>(jd.eigenvalues()[i], 0.0);
-
-            Matrix result =
-                jd.eigenvectors()*diagonal*transpose(jd.eigenvectors());
+            Matrix result = symmetricProduct(spectralRoot(jd, size));
             return result;
         }
 
@@ -363,7 +380,6 @@ namespace QuantLib {
 
         // spectral (a.k.a Principal Component) analysis
         SymmetricSchurDecomposition jd(matrix);
-        Matrix diagonal(size, size, 0.0);
 
         // salvaging algorithm
         Matrix result(size, size);
@@ -379,22 +395,16 @@ namespace QuantLib {
             break;
           case SalvagingAlgorithm::Spectral:
             // negative eigenvalues set to zero
-            for (Size i=0; i<size; i++)
-                diagonal[i][i] =
-                    std::sqrt(std::max<Real>(jd.eigenvalues()[i], 0.0));
-
-            result = jd.eigenvectors() * diagonal;
+            result = spectralRoot(jd, size);
             normalizePseudoRoot(matrix, result);
             break;
           case SalvagingAlgorithm::Hypersphere:
             // negative eigenvalues set to zero
             negative=false;
             for (Size i=0; i<size; ++i){
-                diagonal[i][i] =
-                    std::sqrt(std::max<Real>(jd.eigenvalues()[i], 0.0));
                 if (jd.eigenvalues()[i]<0.0) negative=true;
             }
-            result = jd.eigenvectors() * diagonal;
+            result = spectralRoot(jd, size);
             normalizePseudoRoot(matrix, result);
 
             if (negative)
@@ -404,11 +414,9 @@ namespace QuantLib {
             // negative eigenvalues set to zero
             negative=false;
             for (Size i=0; i<size; ++i){
-                diagonal[i][i] =
-                    std::sqrt(std::max<Real>(jd.eigenvalues()[i], 0.0));
                 if (jd.eigenvalues()[i]<0.0) negative=true;
             }
-            result = jd.eigenvectors() * diagonal;
+            result = spectralRoot(jd, size);
 
             normalizePseudoRoot(matrix, result);
 
@@ -502,10 +510,7 @@ namespace QuantLib {
         // output is granted to have a rank<=maxRank
         retainedFactors=std::min(retainedFactors, maxRank);
 
-        Matrix diagonal(size, retainedFactors, 0.0);
-        for (Size i=0; i<retainedFactors; ++i)
-            diagonal[i][i] = std::sqrt(eigenValues[i]);
-        Matrix result = jd.eigenvectors() * diagonal;
+        Matrix result = spectralRoot(jd, retainedFactors);
 
         normalizePseudoRoot(matrix, result);
         return result;
@@ -30,9 +30,13 @@ namespace QuantLib {
         QL_REQUIRE(s.rows()==s.columns(), "input matrix must be square");
 
         Size size = s.rows();
+        // the eigenvectors are accumulated by rows, so that each
+        // rotation combines two contiguous rows instead of two
+        // strided columns; the matrix is transposed when sorting.
+        Matrix vt(size, size, 0.0);
         for (Size q=0; q<size; q++) {
             diagonal_[q] = s[q][q];
-            eigenVectors_[q][q] = 1.0;
+            vt[q][q] = 1.0;
         }
         Matrix ss = s;
 
@@ -94,9 +98,13 @@ namespace QuantLib {
                                 jacobiRotate_(ss, rho, sine, j, l, l, k);
                             for (l=k+1; l<size; l++)
                                 jacobiRotate_(ss, rho, sine, j, l, k, l);
-                            for (l=0;   l<size; l++)
-                                jacobiRotate_(eigenVectors_,
-                                                  rho, sine, l, j, l, k);
+                            Real* vj = vt[j];
+                            Real* vk = vt[k];
+                            for (l=0;   l<size; l++) {
+                                Real x1 = vj[l], x2 = vk[l];
+                                vj[l] = x1 - sine*(x2 + x1*rho);
+                                vk[l] = x2 + sine*(x1 - x2*rho);
+                            }
                         }
                     }
                 }
@@ -117,8 +125,8 @@ namespace QuantLib {
         std::vector<Real> eigenVector(size);
         Size row, col;
         for (col=0; col<size; col++) {
-            std::copy(eigenVectors_.column_begin(col),
-                      eigenVectors_.column_end(col), eigenVector.begin());
+            std::copy(vt.row_begin(col), vt.row_end(col),
+                      eigenVector.begin());
             temp[col] = std::make_pair(diagonal_[col], eigenVector);
         }
         std::sort(temp.begin(), temp.end(),
@@ -24,7 +24,7 @@
 #ifndef quantlib_optimization_costfunction_h
 #define quantlib_optimization_costfunction_h
 
-#include <ql/math/array.hpp>
+#include <ql/math/matrix.hpp>
 
 namespace QuantLib {
 
@@ -60,6 +60,22 @@ namespace QuantLib {
             return value(x);
         }
 
+        //! method to overload to compute J_f, the jacobian of
+        //  the cost function values with respect to x
+        virtual void jacobian(Matrix& jac, const Array& x) const {
+            Real eps = finiteDifferenceEpsilon();
+            Array xx(x), fp, fm;
+            for (Size i=0; i<x.size(); i++) {
+                xx[i] += eps;
+                fp = values(xx);
+                xx[i] -= 2.0*eps;
+                fm = values(xx);
+                for (Size j=0; j<fp.size(); j++)
+                    jac[j][i] = 0.5*(fp[j] - fm[j])/eps;
+                xx[i] = x[i];
+            }
+        }
+
         //! Default epsilon for finite difference method :
         virtual Real finiteDifferenceEpsilon() const { return 1e-8; }
     };
@@ -26,8 +26,10 @@ namespace QuantLib {
 
     LevenbergMarquardt::LevenbergMarquardt(Real epsfcn,
                                            Real xtol,
-                                           Real gtol)
-    : info_(0), epsfcn_(epsfcn), xtol_(xtol), gtol_(gtol) {}
+                                           Real gtol,
+                                           bool useCostFunctionsJacobian)
+    : info_(0), epsfcn_(epsfcn), xtol_(xtol), gtol_(gtol),
+      useCostFunctionsJacobian_(useCostFunctionsJacobian) {}
 
     Integer LevenbergMarquardt::getInfo() const {
         return info_;
@@ -42,6 +44,10 @@ namespace QuantLib {
         initCostValues_ = P.costFunction().values(x_);
         int m = initCostValues_.size();
         int n = x_.size();
+        if (useCostFunctionsJacobian_) {
+            initJacobian_ = Matrix(m, n);
+            P.costFunction().jacobian(initJacobian_, x_);
+        }
         boost::scoped_array<double> xx(new double[n]);
         std::copy(x_.begin(), x_.end(), xx.get());
         boost::scoped_array<double> fvec(new double[m]);
@@ -75,6 +81,10 @@ namespace QuantLib {
         // in n variables by the Levenberg-Marquardt algorithm.
         MINPACK::LmdifCostFunction lmdifCostFunction = 
             boost::bind(&LevenbergMarquardt::fcn, this, _1, _2, _3, _4, _5);
+        MINPACK::LmdifCostFunction lmdifJacFunction;
+        if (useCostFunctionsJacobian_)
+            lmdifJacFunction = boost::bind(&LevenbergMarquardt::jacFcn,
+                                           this, _1, _2, _3, _4, _5);
         MINPACK::lmdif(m, n, xx.get(), fvec.get(),
                        static_cast<double>(endCriteria.functionEpsilon()),
                        static_cast<double>(xtol_),
@@ -85,7 +95,7 @@ namespace QuantLib {
                        nprint, &info, &nfev, fjac.get(),
                        ldfjac, ipvt.get(), qtf.get(),
                        wa1.get(), wa2.get(), wa3.get(), wa4.get(),
-                       lmdifCostFunction);
+                       lmdifCostFunction, lmdifJacFunction);
         info_ = info;
         // check requirements & endCriteria evaluation
         QL_REQUIRE(info != 0, "MINPACK: improper input parameters");
@@ -123,5 +133,20 @@ namespace QuantLib {
         }
     }
 
+    void LevenbergMarquardt::jacFcn(int m, int n, double* x, double* fjac,
+                                    int*) {
+        Array xt(n);
+        std::copy(x, x+n, xt.begin());
+        // same constraint handling as in fcn; MINPACK stores the
+        // jacobian by columns, hence the transposition
+        Matrix tmp(m, n);
+        if (currentProblem_->constraint().test(xt))
+            currentProblem_->costFunction().jacobian(tmp, xt);
+        else
+            tmp = initJacobian_;
+        Matrix tmpT = transpose(tmp);
+        std::copy(tmpT.begin(), tmpT.end(), fjac);
+    }
+
 }
 
@@ -32,12 +32,19 @@ namespace QuantLib {
     /*! This implementation is based on MINPACK
         (<http://www.netlib.org/minpack>,
         <http://www.netlib.org/cephes/linalg.tgz>)
+
+        By default, the jacobian is approximated by forward
+        differences; if useCostFunctionsJacobian is set, it is
+        obtained from the jacobian() method of the cost function
+        instead, which should be used when the latter provides
+        analytic derivatives.
     */
     class LevenbergMarquardt : public OptimizationMethod {
       public:
         LevenbergMarquardt(Real epsfcn = 1.0e-8,
                            Real xtol = 1.0e-8,
-                           Real gtol = 1.0e-8);
+                           Real gtol = 1.0e-8,
+                           bool useCostFunctionsJacobian = false);
         virtual EndCriteria::Type minimize(Problem& P,
                                            const EndCriteria& endCriteria //= EndCriteria()
                                            );
@@ -48,11 +55,18 @@ namespace QuantLib {
                  double* x,
                  double* fvec,
                  int* iflag);
+        void jacFcn(int m,
+                    int n,
+                    double* x,
+                    double* fjac,
+                    int* iflag);
       private:
         Problem* currentProblem_;
         Array initCostValues_;
+        Matrix initJacobian_;
         mutable Integer info_;
         const Real epsfcn_, xtol_, gtol_;
+        const bool useCostFunctionsJacobian_;
     };
 
 }
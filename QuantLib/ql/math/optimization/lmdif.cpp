@@ -1124,7 +1124,8 @@ void lmdif(int m,int n,double* x,double* fvec,double ftol,
       int nprint, int* info,int* nfev,double* fjac,
       int ldfjac,int* ipvt,double* qtf,
       double* wa1,double* wa2,double* wa3,double* wa4,
-      const QuantLib::MINPACK::LmdifCostFunction& fcn)
+      const QuantLib::MINPACK::LmdifCostFunction& fcn,
+      const QuantLib::MINPACK::LmdifCostFunction& jacFcn)
 {
 /*
 *     **********
@@ -1364,8 +1365,12 @@ L30:
 *    calculate the jacobian matrix.
 */
 iflag = 2;
-fdjac2(m,n,x,fvec,fjac,ldfjac,&iflag,epsfcn,wa4, fcn);
-*nfev += n;
+if (jacFcn.empty()) {
+    fdjac2(m,n,x,fvec,fjac,ldfjac,&iflag,epsfcn,wa4, fcn);
+    *nfev += n;
+} else {
+    jacFcn(m,n,x,fjac,&iflag);
+}
 if(iflag < 0)
     goto L300;
 /*
@@ -36,13 +36,18 @@ namespace QuantLib {
                                       double*,
                                       int*)> LmdifCostFunction;
 
+        /*! If jacFcn is given, it is called as jacFcn(m,n,x,fjac,iflag)
+            to calculate the jacobian instead of using forward
+            differences; fjac is stored by columns.
+        */
         void lmdif(int m,int n,double* x,double* fvec,double ftol,
                    double xtol,double gtol,int maxfev,double epsfcn,
                    double* diag, int mode, double factor,
                    int nprint, int* info,int* nfev,double* fjac,
                    int ldfjac,int* ipvt,double* qtf,
                    double* wa1,double* wa2,double* wa3,double* wa4,
-                   const LmdifCostFunction& fcn);
+                   const LmdifCostFunction& fcn,
+                   const LmdifCostFunction& jacFcn = LmdifCostFunction());
         
         void qrsolv(int n,double* r,int ldr,int* ipvt,
                     double* diag,double* qtb, double* x,
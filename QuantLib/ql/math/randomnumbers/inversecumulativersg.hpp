@@ -26,6 +26,7 @@
 #define quantlib_inversecumulative_rsg_h
 
 #include <ql/methods/montecarlo/sample.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
 #include <vector>
 
 namespace QuantLib {
@@ -51,6 +52,9 @@ namespace QuantLib {
             IC::IC();
             Real IC::operator() const;
         \endcode
+
+        When IC is InverseCumulativeNormal, its array version is
+        used to transform the whole sequence at once.
     */
     template <class USG, class IC>
     class InverseCumulativeRsg {
@@ -63,6 +67,10 @@ namespace QuantLib {
         const sample_type& nextSequence() const;
         const sample_type& lastSequence() const { return x_; }
         Size dimension() const { return dimension_; }
+        /*! skips to the n-th sample of the underlying sequence;
+            requires USG to implement skipTo().
+        */
+        void skipTo(unsigned long n) { uniformSequenceGenerator_.skipTo(n); }
       private:
         USG uniformSequenceGenerator_;
         Size dimension_;
@@ -70,6 +78,26 @@ namespace QuantLib {
         IC ICD_;
     };
 
+    namespace detail {
+
+        template <class IC, class Sequence>
+        inline void inverseCumulativeTransform(const IC& ic,
+                                               const Sequence& x,
+                                               std::vector<Real>& y) {
+            for (Size i = 0; i < y.size(); i++)
+                y[i] = ic(x[i]);
+        }
+
+        inline void inverseCumulativeTransform(
+                                        const InverseCumulativeNormal& ic,
+                                        const std::vector<Real>& x,
+                                        std::vector<Real>& y) {
+            if (!x.empty())
+                ic(&x[0], &x[0]+x.size(), &y[0]);
+        }
+
+    }
+
     template <class USG, class IC>
     InverseCumulativeRsg<USG, IC>::InverseCumulativeRsg(const USG& usg)
     : uniformSequenceGenerator_(usg),
@@ -87,12 +115,10 @@ namespace QuantLib {
     template <class USG, class IC>
     inline const typename InverseCumulativeRsg<USG, IC>::sample_type&
     InverseCumulativeRsg<USG, IC>::nextSequence() const {
-        typename USG::sample_type sample =
+        const typename USG::sample_type& sample =
             uniformSequenceGenerator_.nextSequence();
         x_.weight = sample.weight;
-        for (Size i = 0; i < dimension_; i++) {
-            x_.value[i] = ICD_(sample.value[i]);
-        }
+        detail::inverseCumulativeTransform(ICD_, sample.value, x_.value);
         return x_;
     }
 
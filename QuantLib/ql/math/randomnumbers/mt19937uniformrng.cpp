@@ -68,9 +68,226 @@
 
 #include <ql/math/randomnumbers/seedgenerator.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/errors.hpp>
+#include <boost/cstdint.hpp>
 
 namespace QuantLib {
 
+    namespace {
+
+        /* Polynomials over GF(2) are stored as bit vectors; bit i%64
+           of word i/64 is the coefficient of x^i. */
+        typedef boost::uint64_t word;
+        typedef std::vector<word> Polynomial;
+
+        const Size stateSize = 624, shiftSize = 397;
+        const Integer degreeMT = 19937;
+
+        bool coefficient(const Polynomial& p, Integer i) {
+            Size k = Size(i)/64;
+            return k < p.size() && ((p[k] >> (i%64)) & 1) != 0;
+        }
+
+        Integer degree(const Polynomial& p) {
+            for (Size k=p.size(); k>0; --k) {
+                if (p[k-1] != 0) {
+                    Integer d = 63;
+                    while (((p[k-1] >> d) & 1) == 0)
+                        --d;
+                    return Integer(64*(k-1)) + d;
+                }
+            }
+            return -1;
+        }
+
+        // p += q x^shift
+        void addShifted(Polynomial& p, const Polynomial& q, Size shift) {
+            const Size words = shift/64, bits = shift%64;
+            if (p.size() < q.size()+words+1)
+                p.resize(q.size()+words+1, 0);
+            if (bits == 0) {
+                for (Size k=0; k<q.size(); ++k)
+                    p[k+words] ^= q[k];
+            } else {
+                for (Size k=0; k<q.size(); ++k) {
+                    p[k+words] ^= q[k] << bits;
+                    p[k+words+1] ^= q[k] >> (64-bits);
+                }
+            }
+        }
+
+        // p mod m
+        void reduce(Polynomial& p, const Polynomial& m) {
+            const Integer dm = degree(m);
+            for (Integer i=degree(p); i>=dm; --i)
+                if (coefficient(p, i))
+                    addShifted(p, m, i-dm);
+            p.resize(dm/64+1);
+        }
+
+        Polynomial multiply(const Polynomial& a, const Polynomial& b,
+                            const Polynomial& m) {
+            Polynomial p(a.size()+b.size()+1, 0);
+            for (Integer i=degree(a); i>=0; --i)
+                if (coefficient(a, i))
+                    addShifted(p, b, i);
+            reduce(p, m);
+            return p;
+        }
+
+        Polynomial square(const Polynomial& a, const Polynomial& m) {
+            // the square of a polynomial over GF(2) is obtained by
+            // spreading its coefficients over the even powers
+            Polynomial p(2*a.size(), 0);
+            for (Size k=0; k<a.size(); ++k) {
+                for (Size j=0; j<64; ++j) {
+                    if ((a[k] >> j) & 1)
+                        p[(128*k+2*j)/64] |= word(1) << ((2*j)%64);
+                }
+            }
+            reduce(p, m);
+            return p;
+        }
+
+        Polynomial timesX(const Polynomial& a, const Polynomial& m) {
+            Polynomial p;
+            addShifted(p, a, 1);
+            reduce(p, m);
+            return p;
+        }
+
+        Polynomial dividedByX(Polynomial a, const Polynomial& m) {
+            // requires m(0) = 1, so that x^{-1} exists modulo m
+            if (coefficient(a, 0))
+                addShifted(a, m, 0);
+            for (Size k=0; k<a.size(); ++k) {
+                a[k] >>= 1;
+                if (k+1 < a.size())
+                    a[k] |= a[k+1] << 63;
+            }
+            return a;
+        }
+
+        // advances a window of the recurrence stored in a ring buffer
+        // starting at the given position
+        void nextState(unsigned long* w, Size& start) {
+            const Size s1 = (start+1 == stateSize ? 0 : start+1);
+            const Size sm = (start+shiftSize < stateSize ?
+                             start+shiftSize : start+shiftSize-stateSize);
+            unsigned long y = (w[start]&0x80000000UL)|(w[s1]&0x7fffffffUL);
+            w[start] = w[sm] ^ (y >> 1) ^ ((y & 0x1UL) ? 0x9908b0dfUL : 0UL);
+            start = s1;
+        }
+
+        /* The characteristic polynomial of the recurrence is obtained
+           by running the Berlekamp-Massey algorithm on the sequence
+           of the least significant bits of its output. */
+        Polynomial characteristicPolynomial() {
+            const Size n = 2*degreeMT;
+
+            unsigned long w[stateSize];
+            w[0] = 5489UL;
+            for (Size i=1; i<stateSize; ++i)
+                w[i] = (1812433253UL * (w[i-1] ^ (w[i-1] >> 30)) + i)
+                     & 0xffffffffUL;
+
+            // the sequence is stored in reverse order, so that the
+            // discrepancy is the inner product of the connection
+            // polynomial with a contiguous range of bits
+            Polynomial r(n/64+2, 0);
+            Size start = 0;
+            for (Size i=0; i<n; ++i) {
+                nextState(w, start);
+                Size j = n-1-i;
+                if (w[start == 0 ? stateSize-1 : start-1] & 1)
+                    r[j/64] |= word(1) << (j%64);
+            }
+
+            Polynomial c(1, 1), b(1, 1);
+            Integer l = 0;
+            Size m = 1;
+            for (Size i=0; i<n; ++i) {
+                const Size offset = n-1-i;
+                word d = 0;
+                for (Size k=0; k<c.size(); ++k) {
+                    const Size pos = offset + 64*k;
+                    const Size idx = pos/64, bits = pos%64;
+                    word chunk = 0;
+                    if (idx < r.size()) {
+                        chunk = r[idx] >> bits;
+                        if (bits != 0 && idx+1 < r.size())
+                            chunk |= r[idx+1] << (64-bits);
+                    }
+                    d ^= c[k] & chunk;
+                }
+                d ^= d >> 32; d ^= d >> 16; d ^= d >> 8;
+                d ^= d >> 4;  d ^= d >> 2;  d ^= d >> 1;
+                if ((d & 1) == 0) {
+                    ++m;
+                } else if (2*l <= Integer(i)) {
+                    Polynomial t = c;
+                    addShifted(c, b, m);
+                    l = Integer(i)+1-l;
+                    b.swap(t);
+                    m = 1;
+                } else {
+                    addShifted(c, b, m);
+                    ++m;
+                }
+            }
+            QL_ENSURE(l == degreeMT,
+                      "wrong degree (" << l << ") of characteristic "
+                      "polynomial");
+
+            // the characteristic polynomial is the reciprocal of the
+            // connection polynomial
+            Polynomial p(l/64+1, 0);
+            for (Integer i=0; i<=l; ++i)
+                if (coefficient(c, l-i))
+                    p[i/64] |= word(1) << (i%64);
+            return p;
+        }
+
+        const Polynomial& characteristic() {
+            static const Polynomial p = characteristicPolynomial();
+            return p;
+        }
+
+        // x^(2^64) modulo the characteristic polynomial
+        Polynomial jumpPolynomial() {
+            const Polynomial& m = characteristic();
+            Polynomial p(1, 2);
+            for (Size i=0; i<64; ++i)
+                p = square(p, m);
+            return p;
+        }
+
+        /* Advances the state by J draws given the polynomial
+           x^J modulo the characteristic polynomial.  The new state is
+           obtained by Horner evaluation of x^(J-1) on the current
+           window, which is exact apart from the unused low bits of its
+           first word, followed by a single step. */
+        void advance(unsigned long* mt, const Polynomial& jump) {
+            const Polynomial q = dividedByX(jump, characteristic());
+
+            unsigned long w[stateSize] = { 0 };
+            Size start = 0;
+            for (Integer i=degree(q); i>=0; --i) {
+                nextState(w, start);
+                if (coefficient(q, i)) {
+                    for (Size k=0; k<stateSize-start; ++k)
+                        w[start+k] ^= mt[k];
+                    for (Size k=stateSize-start; k<stateSize; ++k)
+                        w[start+k-stateSize] ^= mt[k];
+                }
+            }
+            nextState(w, start);
+            for (Size k=0; k<stateSize; ++k)
+                mt[k] = w[(start+k)%stateSize];
+        }
+
+    }
+
     // constant vector a
     const unsigned long MersenneTwisterUniformRng::MATRIX_A = 0x9908b0dfUL;
     // most significant w-r bits
@@ -122,6 +339,37 @@ namespace QuantLib {
         mt[0] = UPPER_MASK; /*MSB is 1; assuring non-zero initial array*/
     }
 
+    void MersenneTwisterUniformRng::skip(BigNatural n) {
+        if (n == 0)
+            return;
+        const Polynomial& m = characteristic();
+        Polynomial p(1, 1);
+        Integer bit = 8*sizeof(BigNatural)-1;
+        while (((n >> bit) & 1) == 0)
+            --bit;
+        for (; bit>=0; --bit) {
+            p = square(p, m);
+            if ((n >> bit) & 1)
+                p = timesX(p, m);
+        }
+        advance(mt, p);
+    }
+
+    void MersenneTwisterUniformRng::jump(BigNatural n) {
+        if (n == 0)
+            return;
+        static const Polynomial jumpBy2To64 = jumpPolynomial();
+        const Polynomial& m = characteristic();
+        Polynomial p(1, 1), j = jumpBy2To64;
+        for (; n != 0; n >>= 1) {
+            if (n & 1)
+                p = multiply(p, j, m);
+            if (n > 1)
+                j = square(j, m);
+        }
+        advance(mt, p);
+    }
+
     void MersenneTwisterUniformRng::twist() const {
         static const unsigned long mag01[2]={0x0UL, MATRIX_A};
         /* mag01[x] = x * MATRIX_A  for x=0,1 */
@@ -35,8 +35,17 @@ namespace QuantLib {
 
         For more details see http://www.math.keio.ac.jp/matumoto/emt.html
 
-        \test the correctness of the returned values is tested by
-              checking them against known good results.
+        The generator can be advanced by an arbitrary number of draws
+        without generating them by means of the jump-ahead algorithm
+        by Haramoto, Matsumoto, Nishimura, Panneton and L'Ecuyer
+        (2008), "Efficient Jump Ahead for F2-Linear Random Number
+        Generators", INFORMS Journal on Computing, 20(3), 385-390.
+
+        \test
+        - the correctness of the returned values is tested by
+          checking them against known good results.
+        - skipping and jumping ahead are tested against drawing
+          the skipped numbers.
     */
     class MersenneTwisterUniformRng {
       private:
@@ -70,6 +79,15 @@ namespace QuantLib {
             y ^= (y >> 18);
             return y;
         }
+        //! advance the generator by the given number of draws
+        /*! The cost is logarithmic in the number of skipped draws. */
+        void skip(BigNatural n);
+        //! advance the generator by \f$ n 2^{64} \f$ draws
+        /*! Jumping a generator by a different multiple of
+            \f$ 2^{64} \f$ for each worker provides non-overlapping
+            substreams of the sequence starting from a given seed.
+        */
+        void jump(BigNatural n);
       private:
         void seedInitialization(unsigned long seed);
         void twist() const;
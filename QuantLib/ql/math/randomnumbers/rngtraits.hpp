@@ -34,9 +34,37 @@
 #include <ql/math/randomnumbers/inversecumulativersg.hpp>
 #include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/math/distributions/poissondistribution.hpp>
+#include <boost/type_traits/integral_constant.hpp>
 
 namespace QuantLib {
 
+    namespace detail {
+
+        // whether URNG provides jump(), as needed by substreams
+        template <class URNG>
+        class HasJump {
+            typedef char yes;
+            typedef char (&no)[2];
+            template <class T, void (T::*)(BigNatural)> struct check;
+            template <class T> static yes test(check<T, &T::jump>*);
+            template <class T> static no test(...);
+          public:
+            static const bool value = sizeof(test<URNG>(0)) == sizeof(yes);
+        };
+
+        template <class URNG>
+        inline void jump(URNG& rng, BigNatural n, boost::true_type) {
+            rng.jump(n);
+        }
+
+        template <class URNG>
+        inline void jump(URNG&, BigNatural, boost::false_type) {
+            QL_FAIL("the random-number generator can't jump ahead; "
+                    "substreams are not available");
+        }
+
+    }
+
     // random number traits
 
     template <class URNG, class IC>
@@ -54,6 +82,32 @@ namespace QuantLib {
             ursg_type g(dimension, seed);
             return (icInstance ? rsg_type(g, *icInstance) : rsg_type(g));
         }
+        /*! returns a generator for the given substream among a number
+            of non-overlapping ones started from the same seed; the
+            i-th substream starts \f$ i 2^{64} \f$ draws after the
+            first.  Requires URNG to implement jump(); otherwise,
+            only the first substream is available.
+
+            \pre the seed must be the same non-null value for all
+                 substreams; a null seed would be replaced by a
+                 different random one for each of them.
+        */
+        static rsg_type make_sequence_generator(Size dimension,
+                                                BigNatural seed,
+                                                Size stream,
+                                                Size streams) {
+            QL_REQUIRE(stream < streams,
+                       "substream " << stream << " not available "
+                       "(" << streams << " substreams)");
+            QL_REQUIRE(seed != 0 || streams == 1,
+                       "a non-null seed is required for substreams");
+            urng_type rng(seed);
+            if (stream > 0)
+                detail::jump(rng, stream, boost::integral_constant<bool,
+                                         detail::HasJump<URNG>::value>());
+            ursg_type g(dimension, rng);
+            return (icInstance ? rsg_type(g, *icInstance) : rsg_type(g));
+        }
         // data
         static boost::shared_ptr<IC> icInstance;
     };
@@ -91,6 +145,28 @@ namespace QuantLib {
             ursg_type g(dimension, seed);
             return (icInstance ? rsg_type(g, *icInstance) : rsg_type(g));
         }
+        /*! returns a generator for the given substream among a
+            number of them.  All substreams produce the same sequence;
+            multithreaded Monte Carlo models position each of them on
+            its own contiguous slice of the samples by means of
+            skipTo(), so that the points used are the same as those
+            drawn by a single generator.
+
+            \pre the seed must be the same for all substreams; for
+                 sequences whose direction integers are initialized
+                 randomly, a null seed would be replaced by a
+                 different random one for each of them.
+        */
+        static rsg_type make_sequence_generator(Size dimension,
+                                                BigNatural seed,
+                                                Size stream,
+                                                Size streams) {
+            QL_REQUIRE(stream < streams,
+                       "substream " << stream << " not available "
+                       "(" << streams << " substreams)");
+            ursg_type g(dimension, seed);
+            return (icInstance ? rsg_type(g, *icInstance) : rsg_type(g));
+        }
         // data
         static boost::shared_ptr<IC> icInstance;
     };
@@ -19,12 +19,24 @@
 
 #include <ql/math/randomnumbers/seedgenerator.hpp>
 #include <ctime>
+#if defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+#include <boost/atomic.hpp>
+#endif
 #if defined(BOOST_NO_STDC_NAMESPACE)
     namespace std { using ::time; }
 #endif
 
 namespace QuantLib {
 
+    #if defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+    namespace {
+
+        // counts the instances created by different threads
+        boost::atomic<unsigned long> instanceCounter(0);
+
+    }
+    #endif
+
     // we need to prevent rng from being default-initialized
     SeedGenerator::SeedGenerator() : rng_(42UL) {
         initialize();
@@ -49,6 +61,10 @@ namespace QuantLib {
         init[1]=second.nextInt32();
         init[2]=second.nextInt32();
         init[3]=second.nextInt32();
+        #if defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+        // threads starting in the same second get different seeds
+        init.push_back(instanceCounter++);
+        #endif
 
         rng_ = MersenneTwisterUniformRng(init);
 
@@ -31,7 +31,8 @@ namespace QuantLib {
 
     //! Random seed generator
     /*! Random number generator used for automatic generation of
-        initialization seeds.
+        initialization seeds.  With thread-local sessions, the
+        instance of each thread is initialized differently.
 
         \test correct initialization of the single instance is tested.
     */
@@ -0,0 +1,99 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/streaminglinearleastsquares.hpp>
+#include <ql/math/matrixutilities/svd.hpp>
+#include <numeric>
+
+namespace QuantLib {
+
+    StreamingLinearLeastSquares::StreamingLinearLeastSquares(Size dimension)
+    : xtx_(dimension, dimension, 0.0), xty_(dimension, 0.0),
+      samples_(0), basisValues_(dimension) {
+        QL_REQUIRE(dimension > 0, "null number of basis functions");
+    }
+
+    void StreamingLinearLeastSquares::add(const Array& basisValues,
+                                          Real y) {
+        Size m = dim();
+        QL_REQUIRE(basisValues.size() == m,
+                   basisValues.size() << " basis values given, "
+                   << m << " required");
+        // only the lower triangle is accumulated
+        for (Size i=0; i<m; ++i) {
+            Real bi = basisValues[i];
+            Real* row = xtx_[i];
+            for (Size j=0; j<=i; ++j)
+                row[j] += bi*basisValues[j];
+            xty_[i] += bi*y;
+        }
+        ++samples_;
+    }
+
+    void StreamingLinearLeastSquares::reset() {
+        std::fill(xtx_.begin(), xtx_.end(), 0.0);
+        std::fill(xty_.begin(), xty_.end(), 0.0);
+        samples_ = 0;
+    }
+
+    Disposable<Array> StreamingLinearLeastSquares::coefficients() const {
+        Size m = dim();
+        QL_REQUIRE(samples_ >= m,
+                   "not enough samples: " << samples_ << " given, "
+                   << m << " required");
+
+        // equilibrate the normal matrix by its diagonal, so that
+        // basis functions of different magnitude are solved for
+        // with the same relative accuracy
+        Array scale(m);
+        for (Size i=0; i<m; ++i)
+            scale[i] = xtx_[i][i] > 0.0 ? 1.0/std::sqrt(xtx_[i][i]) : 0.0;
+
+        Matrix a(m, m);
+        Array b(m);
+        for (Size i=0; i<m; ++i) {
+            for (Size j=0; j<=i; ++j)
+                a[i][j] = a[j][i] = xtx_[i][j]*scale[i]*scale[j];
+            b[i] = xty_[i]*scale[i];
+        }
+
+        // the normal matrix is symmetric and positive semi-definite;
+        // its pseudo-inverse discards the directions which are not
+        // determined by the data, e.g., because of linearly
+        // dependent basis functions.
+        const SVD svd(a);
+        const Matrix& U = svd.U();
+        const Matrix& V = svd.V();
+        const Array& w = svd.singularValues();
+        const Real threshold = m*QL_EPSILON*w[0];
+
+        Array result(m, 0.0);
+        for (Size k=0; k<m; ++k) {
+            if (w[k] > threshold) {
+                const Real u = std::inner_product(U.column_begin(k),
+                                                  U.column_end(k),
+                                                  b.begin(), 0.0)/w[k];
+                for (Size i=0; i<m; ++i)
+                    result[i] += u*V[i][k];
+            }
+        }
+        for (Size i=0; i<m; ++i)
+            result[i] *= scale[i];
+        return result;
+    }
+
+}
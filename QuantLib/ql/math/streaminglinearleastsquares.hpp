@@ -0,0 +1,84 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file streaminglinearleastsquares.hpp
+    \brief linear least squares regression on a stream of samples
+*/
+
+#ifndef quantlib_streaming_linear_least_squares_hpp
+#define quantlib_streaming_linear_least_squares_hpp
+
+#include <ql/math/matrix.hpp>
+
+namespace QuantLib {
+
+    //! linear least squares regression on a stream of samples
+    /*! The normal equations \f$ X^T X a = X^T y \f$ are accumulated
+        one sample at a time, so that the design matrix \f$ X \f$ is
+        never stored: memory use depends on the number of basis
+        functions only. Unlike GeneralLinearLeastSquares, samples
+        can be discarded as soon as they are added.
+
+        The coefficients are obtained from the pseudo-inverse of
+        \f$ X^T X \f$, equilibrated by its diagonal; components not
+        determined by the data (e.g., because of linearly dependent
+        basis functions) are set to zero.
+
+        \warning the condition number of \f$ X^T X \f$ is the square
+                 of that of \f$ X \f$; the basis functions should be
+                 evaluated on scaled variables.
+    */
+    class StreamingLinearLeastSquares {
+      public:
+        explicit StreamingLinearLeastSquares(Size dimension);
+        //! adds a sample given the values of the basis functions
+        void add(const Array& basisValues, Real y);
+        //! adds a sample given the regressor and the basis functions
+        template <class X, class vContainer>
+        void add(const X& x, Real y, const vContainer& v);
+        //! removes all samples
+        void reset();
+        //! number of samples
+        Size size() const { return samples_; }
+        //! number of basis functions
+        Size dim() const { return xty_.size(); }
+        Disposable<Array> coefficients() const;
+      private:
+        Matrix xtx_;
+        Array xty_;
+        Size samples_;
+        Array basisValues_;
+    };
+
+
+    // template definitions
+
+    template <class X, class vContainer>
+    void StreamingLinearLeastSquares::add(const X& x, Real y,
+                                          const vContainer& v) {
+        QL_REQUIRE(v.size() == dim(),
+                   v.size() << " basis functions given, "
+                   << dim() << " required");
+        for (Size i=0; i<v.size(); ++i)
+            basisValues_[i] = v[i](x);
+        add(basisValues_, y);
+    }
+
+}
+
+
+#endif
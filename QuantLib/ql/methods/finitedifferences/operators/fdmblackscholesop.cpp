@@ -58,33 +58,41 @@ namespace QuantLib {
             const boost::shared_ptr<FdmLinearOpLayout> layout=mesher_->layout();
             const FdmLinearOpIterator endIter = layout->end();
 
-            Array v(layout->size());
+            if (halfVariance_.size() != layout->size()) {
+                halfVariance_ = Array(layout->size());
+                drift_ = Array(layout->size());
+            }
             for (FdmLinearOpIterator iter = layout->begin();
                  iter!=endIter; ++iter) {
                 const Size i = iter.index();
 
+                Real v;
                 if (illegalLocalVolOverwrite_ < 0.0) {
-                    v[i] = square<Real>()(
+                    v = square<Real>()(
                                 localVol_->localVol(0.5*(t1+t2), x_[i], true));
                 }
                 else {
                     try {
-                        v[i] = square<Real>()(
+                        v = square<Real>()(
                                 localVol_->localVol(0.5*(t1+t2), x_[i], true));
                     } catch (Error&) {
-                        v[i] = square<Real>()(illegalLocalVolOverwrite_);
+                        v = square<Real>()(illegalLocalVolOverwrite_);
                     }
 
                 }
+                halfVariance_[i] = 0.5*v;
+                drift_[i] = r - q - halfVariance_[i];
             }
-            mapT_.axpyb(r - q - 0.5*v, dxMap_,
-                        dxxMap_.mult(0.5*v), Array(1, -r));
+            // mapT_ is first set to the second-derivative part and
+            // then updated in place
+            dxxMap_.mult(halfVariance_, mapT_);
+            mapT_.axpyb(drift_, dxMap_, mapT_, Array(1, -r));
         }
         else {
             const Real v
                 = volTS_->blackForwardVariance(t1, t2, strike_)/(t2-t1);
-            mapT_.axpyb(Array(1, r - q - 0.5*v), dxMap_,
-                        dxxMap_.mult(0.5*Array(mesher_->layout()->size(), v)),
+            dxxMap_.mult(Array(1, 0.5*v), mapT_);
+            mapT_.axpyb(Array(1, r - q - 0.5*v), dxMap_, mapT_,
                         Array(1, -r));
         }
     }
@@ -127,6 +135,33 @@ namespace QuantLib {
         return solve_splitting(direction_, r, dt);
     }
 
+    void FdmBlackScholesOp::apply(const Array& r, Array& result) const {
+        mapT_.apply(r, result);
+    }
+
+    void FdmBlackScholesOp::apply_mixed(const Array& r,
+                                        Array& result) const {
+        if (result.size() != r.size())
+            result = Array(r.size());
+        std::fill(result.begin(), result.end(), 0.0);
+    }
+
+    void FdmBlackScholesOp::apply_direction(Size direction, const Array& r,
+                                            Array& result) const {
+        if (direction == direction_)
+            mapT_.apply(r, result);
+        else
+            apply_mixed(r, result);
+    }
+
+    void FdmBlackScholesOp::solve_splitting(Size direction, const Array& r,
+                                            Real dt, Array& result) const {
+        if (direction == direction_)
+            mapT_.solve_splitting(r, dt, 1.0, result);
+        else
+            result = r;
+    }
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
     Disposable<std::vector<SparseMatrix> >
     FdmBlackScholesOp::toMatrixDecomp() const {
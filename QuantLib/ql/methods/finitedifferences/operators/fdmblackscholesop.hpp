@@ -55,6 +55,13 @@ namespace QuantLib {
                                           const Array& r, Real s) const;
         Disposable<Array> preconditioner(const Array& r, Real s) const;
 
+        void apply(const Array& r, Array& result) const;
+        void apply_mixed(const Array& r, Array& result) const;
+        void apply_direction(Size direction, const Array& r,
+                             Array& result) const;
+        void solve_splitting(Size direction, const Array& r, Real s,
+                             Array& result) const;
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const;
 #endif
@@ -67,6 +74,7 @@ namespace QuantLib {
         const FirstDerivativeOp  dxMap_;
         const TripleBandLinearOp dxxMap_;
         TripleBandLinearOp mapT_;
+        Array halfVariance_, drift_;
         const Real strike_;
         const Real illegalLocalVolOverwrite_;
         const Size direction_;
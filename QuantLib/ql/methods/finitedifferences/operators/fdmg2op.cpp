@@ -67,9 +67,12 @@ namespace QuantLib {
         const Real phi = 0.5*(  dynamics->shortRate(t1, 0.0, 0.0)
                               + dynamics->shortRate(t2, 0.0, 0.0));
 
-        const Array hr = -0.5*(x_ + y_ + phi);
-        mapX_.axpyb(Array(), dxMap_, dxMap_, hr);
-        mapY_.axpyb(Array(), dyMap_, dyMap_, hr);
+        if (hr_.size() != x_.size())
+            hr_ = Array(x_.size());
+        for (Size i=0; i < hr_.size(); ++i)
+            hr_[i] = -0.5*(x_[i] + y_[i] + phi);
+        mapX_.axpyb(Array(), dxMap_, dxMap_, hr_);
+        mapY_.axpyb(Array(), dyMap_, dyMap_, hr_);
     }
 
     Disposable<Array> FdmG2Op::apply(const Array& r) const {
@@ -113,6 +116,42 @@ namespace QuantLib {
         return solve_splitting(direction1_, r, dt);
     }
 
+    void FdmG2Op::apply(const Array& r, Array& result) const {
+        mapX_.apply(r, result);
+        mapY_.apply_add(r, result);
+        corrMap_.apply_add(r, result);
+    }
+
+    void FdmG2Op::apply_mixed(const Array& r, Array& result) const {
+        corrMap_.apply(r, result);
+    }
+
+    void FdmG2Op::apply_direction(Size direction, const Array& r,
+                                  Array& result) const {
+        if (direction == direction1_)
+            mapX_.apply(r, result);
+        else if (direction == direction2_)
+            mapY_.apply(r, result);
+        else {
+            if (result.size() != r.size())
+                result = Array(r.size());
+            std::fill(result.begin(), result.end(), 0.0);
+        }
+    }
+
+    void FdmG2Op::solve_splitting(Size direction, const Array& r, Real a,
+                                  Array& result) const {
+        if (direction == direction1_)
+            mapX_.solve_splitting(r, a, 1.0, result);
+        else if (direction == direction2_)
+            mapY_.solve_splitting(r, a, 1.0, result);
+        else {
+            if (result.size() != r.size())
+                result = Array(r.size());
+            std::fill(result.begin(), result.end(), 0.0);
+        }
+    }
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
     Disposable<std::vector<SparseMatrix> > FdmG2Op::toMatrixDecomp() const {
         std::vector<SparseMatrix> retVal(3);
@@ -67,7 +67,11 @@ namespace QuantLib {
                 dxMap_, dxxMap_, Array(1, -0.5*r));
         }
         else {
-            mapT_.axpyb(r - q - varianceValues_, dxMap_, dxxMap_, Array(1, -0.5*r));
+            if (drift_.size() != varianceValues_.size())
+                drift_ = Array(varianceValues_.size());
+            for (Size i=0; i < drift_.size(); ++i)
+                drift_[i] = r - q - varianceValues_[i];
+            mapT_.axpyb(drift_, dxMap_, dxxMap_, Array(1, -0.5*r));
         }
     }
 
@@ -162,6 +166,36 @@ namespace QuantLib {
         return solve_splitting(0, r, dt);
     }
 
+    void FdmHestonOp::apply(const Array& u, Array& result) const {
+        dyMap_.getMap().apply(u, result);
+        dxMap_.getMap().apply_add(u, result);
+        correlationMap_.apply_add(u, result);
+    }
+
+    void FdmHestonOp::apply_mixed(const Array& r, Array& result) const {
+        correlationMap_.apply(r, result);
+    }
+
+    void FdmHestonOp::apply_direction(Size direction, const Array& r,
+                                      Array& result) const {
+        if (direction == 0)
+            dxMap_.getMap().apply(r, result);
+        else if (direction == 1)
+            dyMap_.getMap().apply(r, result);
+        else
+            QL_FAIL("direction too large");
+    }
+
+    void FdmHestonOp::solve_splitting(Size direction, const Array& r,
+                                      Real a, Array& result) const {
+        if (direction == 0)
+            dxMap_.getMap().solve_splitting(r, a, 1.0, result);
+        else if (direction == 1)
+            dyMap_.getMap().solve_splitting(r, a, 1.0, result);
+        else
+            QL_FAIL("direction too large");
+    }
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
     Disposable<std::vector<SparseMatrix> >
     FdmHestonOp::toMatrixDecomp() const {
@@ -51,6 +51,32 @@ namespace QuantLib {
         virtual Disposable<Array> 
             preconditioner(const Array& r, Real s) const = 0;
 
+        /*! \name in-place versions
+            The following methods write their results into the passed
+            array, so that schemes can reuse their storage across time
+            steps.  The default implementations call the methods
+            above; derived classes can override them to avoid
+            allocating new arrays.  The result must be a different
+            array than the argument.
+        */
+        //@{
+        using FdmLinearOp::apply;
+        virtual void apply(const Array& r, Array& result) const {
+            result = apply(r);
+        }
+        virtual void apply_mixed(const Array& r, Array& result) const {
+            result = apply_mixed(r);
+        }
+        virtual void apply_direction(Size direction, const Array& r,
+                                     Array& result) const {
+            result = apply_direction(direction, r);
+        }
+        virtual void solve_splitting(Size direction, const Array& r, Real s,
+                                     Array& result) const {
+            result = solve_splitting(direction, r, s);
+        }
+        //@}
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
         virtual Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const {
             QL_FAIL(" ublas representation is not implemented");
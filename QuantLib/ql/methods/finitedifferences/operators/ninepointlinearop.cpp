@@ -25,6 +25,11 @@
 
 namespace QuantLib {
 
+    namespace {
+        // below this size, threads cost more than they save
+        const long minParallelSize = 4096;
+    }
+
     NinePointLinearOp::NinePointLinearOp(
         Size d0, Size d1,
         const boost::shared_ptr<FdmMesher>& mesher)
@@ -131,11 +136,20 @@ namespace QuantLib {
     Disposable<Array> NinePointLinearOp::apply(const Array& u)
         const {
 
+        Array retVal(u.size());
+        apply(u, retVal);
+        return retVal;
+    }
+
+    void NinePointLinearOp::apply(const Array& u, Array& retVal) const {
+
         const boost::shared_ptr<FdmLinearOpLayout> index=mesher_->layout();
         QL_REQUIRE(u.size() == index->size(),"inconsistent length of r "
                     << u.size() << " vs " << index->size());
+        QL_REQUIRE(&u != &retVal, "result must not overwrite the argument");
+        if (retVal.size() != u.size())
+            Array(u.size()).swap(retVal);
 
-        Array retVal(u.size());
         // direct access to make the following code faster.
         const Real *a00(a00_.get()), *a01(a01_.get()), *a02(a02_.get());
         const Real *a10(a10_.get()), *a11(a11_.get()), *a12(a12_.get());
@@ -144,7 +158,11 @@ namespace QuantLib {
         const Size *i10(i10_.get()),                   *i12(i12_.get());
         const Size *i20(i20_.get()), *i21(i21_.get()), *i22(i22_.get());
 
-        for (Size i=0; i < retVal.size(); ++i) {
+        const long size = static_cast<long>(retVal.size());
+        #if defined(_OPENMP)
+        #pragma omp parallel for if(size > minParallelSize)
+        #endif
+        for (long i=0; i < size; ++i) {
             retVal[i] =   a00[i]*u[i00[i]]
                         + a01[i]*u[i01[i]]
                         + a02[i]*u[i02[i]]
@@ -155,7 +173,39 @@ namespace QuantLib {
                         + a21[i]*u[i21[i]]
                         + a22[i]*u[i22[i]];
         }
-        return retVal;
+    }
+
+    void NinePointLinearOp::apply_add(const Array& u, Array& retVal) const {
+
+        const boost::shared_ptr<FdmLinearOpLayout> index=mesher_->layout();
+        QL_REQUIRE(u.size() == index->size(),"inconsistent length of r "
+                    << u.size() << " vs " << index->size());
+        QL_REQUIRE(retVal.size() == u.size(), "inconsistent length of result");
+        QL_REQUIRE(&u != &retVal, "result must not overwrite the argument");
+
+        // direct access to make the following code faster.
+        const Real *a00(a00_.get()), *a01(a01_.get()), *a02(a02_.get());
+        const Real *a10(a10_.get()), *a11(a11_.get()), *a12(a12_.get());
+        const Real *a20(a20_.get()), *a21(a21_.get()), *a22(a22_.get());
+        const Size *i00(i00_.get()), *i01(i01_.get()), *i02(i02_.get());
+        const Size *i10(i10_.get()),                   *i12(i12_.get());
+        const Size *i20(i20_.get()), *i21(i21_.get()), *i22(i22_.get());
+
+        const long size = static_cast<long>(retVal.size());
+        #if defined(_OPENMP)
+        #pragma omp parallel for if(size > minParallelSize)
+        #endif
+        for (long i=0; i < size; ++i) {
+            retVal[i] +=  a00[i]*u[i00[i]]
+                        + a01[i]*u[i01[i]]
+                        + a02[i]*u[i02[i]]
+                        + a10[i]*u[i10[i]]
+                        + a11[i]*u[i]
+                        + a12[i]*u[i12[i]]
+                        + a20[i]*u[i20[i]]
+                        + a21[i]*u[i21[i]]
+                        + a22[i]*u[i22[i]];
+        }
     }
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
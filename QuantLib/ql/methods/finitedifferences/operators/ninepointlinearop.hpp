@@ -44,6 +44,18 @@ namespace QuantLib {
         NinePointLinearOp& operator=(const Disposable<NinePointLinearOp>& m);
 
         Disposable<Array> apply(const Array& r) const;
+        /*! in-place version of apply(); \c retVal is resized only
+            if needed.
+
+            \pre \c retVal and \c r must be different arrays
+        */
+        void apply(const Array& r, Array& retVal) const;
+        /*! adds the result of apply() to \c retVal
+
+            \pre \c retVal and \c r must be different arrays of
+                 the same size
+        */
+        void apply_add(const Array& r, Array& retVal) const;
         Disposable<NinePointLinearOp> mult(const Array& u) const;
 
         void swap(NinePointLinearOp& m);
@@ -26,6 +26,11 @@
 
 namespace QuantLib {
 
+    namespace {
+        // below this size, threads cost more than they save
+        const long minParallelSize = 4096;
+    }
+
     TripleBandLinearOp::TripleBandLinearOp(
         Size direction,
         const boost::shared_ptr<FdmMesher>& mesher)
@@ -193,16 +198,31 @@ namespace QuantLib {
     Disposable<TripleBandLinearOp> TripleBandLinearOp::mult(const Array& u) const {
 
         TripleBandLinearOp retVal(direction_, mesher_);
+        mult(u, retVal);
+
+        return retVal;
+    }
+
+    void TripleBandLinearOp::mult(const Array& u,
+                                  TripleBandLinearOp& retVal) const {
+        QL_REQUIRE(retVal.mesher_ == mesher_
+                   && retVal.direction_ == direction_,
+                   "operator built on a different mesher or direction");
 
         const Size size = mesher_->layout()->size();
+        const Size uinc = (u.size() > 1) ? 1 : 0;
+        QL_REQUIRE(u.size() == size || u.size() == 1,
+                   "inconsistent length of u");
+
+        Real *lower(retVal.lower_.get());
+        Real *diag(retVal.diag_.get());
+        Real *upper(retVal.upper_.get());
         for (Size i=0; i < size; ++i) {
-            const Real s = u[i];
-            retVal.lower_[i]= lower_[i]*s;
-            retVal.diag_[i] = diag_[i]*s;
-            retVal.upper_[i]= upper_[i]*s;
+            const Real s = u[i*uinc];
+            lower[i]= lower_[i]*s;
+            diag[i] = diag_[i]*s;
+            upper[i]= upper_[i]*s;
         }
-
-        return retVal;
     }
 
     Disposable<TripleBandLinearOp> TripleBandLinearOp::add(const Array& u) const {
@@ -220,9 +240,19 @@ namespace QuantLib {
     }
 
     Disposable<Array> TripleBandLinearOp::apply(const Array& r) const {
+        Array retVal(r.size());
+        apply(r, retVal);
+
+        return retVal;
+    }
+
+    void TripleBandLinearOp::apply(const Array& r, Array& retVal) const {
         const boost::shared_ptr<FdmLinearOpLayout> index = mesher_->layout();
 
         QL_REQUIRE(r.size() == index->size(), "inconsistent length of r");
+        QL_REQUIRE(&r != &retVal, "result must not overwrite the argument");
+        if (retVal.size() != r.size())
+            Array(r.size()).swap(retVal);
 
         const Real* lptr = lower_.get();
         const Real* dptr = diag_.get();
@@ -230,12 +260,35 @@ namespace QuantLib {
         const Size* i0ptr = i0_.get();
         const Size* i2ptr = i2_.get();
 
-        array_type retVal(r.size());
-        for (Size i=0; i < index->size(); ++i) {
+        const long size = static_cast<long>(index->size());
+        #if defined(_OPENMP)
+        #pragma omp parallel for if(size > minParallelSize)
+        #endif
+        for (long i=0; i < size; ++i) {
             retVal[i] = r[i0ptr[i]]*lptr[i]+r[i]*dptr[i]+r[i2ptr[i]]*uptr[i];
         }
+    }
 
-        return retVal;
+    void TripleBandLinearOp::apply_add(const Array& r, Array& retVal) const {
+        const boost::shared_ptr<FdmLinearOpLayout> index = mesher_->layout();
+
+        QL_REQUIRE(r.size() == index->size(), "inconsistent length of r");
+        QL_REQUIRE(retVal.size() == r.size(), "inconsistent length of result");
+        QL_REQUIRE(&r != &retVal, "result must not overwrite the argument");
+
+        const Real* lptr = lower_.get();
+        const Real* dptr = diag_.get();
+        const Real* uptr = upper_.get();
+        const Size* i0ptr = i0_.get();
+        const Size* i2ptr = i2_.get();
+
+        const long size = static_cast<long>(index->size());
+        #if defined(_OPENMP)
+        #pragma omp parallel for if(size > minParallelSize)
+        #endif
+        for (long i=0; i < size; ++i) {
+            retVal[i] += r[i0ptr[i]]*lptr[i]+r[i]*dptr[i]+r[i2ptr[i]]*uptr[i];
+        }
     }
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
@@ -257,50 +310,88 @@ namespace QuantLib {
 
     Disposable<Array>
     TripleBandLinearOp::solve_splitting(const Array& r, Real a, Real b) const {
+        Array retVal(r.size());
+        solve_splitting(r, a, b, retVal);
+
+        return retVal;
+    }
+
+    void TripleBandLinearOp::solve_splitting(const Array& r, Real a, Real b,
+                                             Array& retVal) const {
         const boost::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
         QL_REQUIRE(r.size() == layout->size(), "inconsistent size of rhs");
 
-#ifdef QL_EXTRA_SAFETY_CHECKS
-        for (FdmLinearOpIterator iter = layout->begin();
-             iter!=layout->end(); ++iter) {
-            const std::vector<Size>& coordinates = iter.coordinates();
-            QL_REQUIRE(   coordinates[direction_] != 0
-                       || lower_[iter.index()] == 0,"removing non zero entry!");
-            QL_REQUIRE(   coordinates[direction_] != layout->dim()[direction_]-1
-                       || upper_[iter.index()] == 0,"removing non zero entry!");
-        }
-#endif
-
-        Array retVal(r.size()), tmp(r.size());
+        if (retVal.size() != r.size())
+            Array(r.size()).swap(retVal);
 
         const Real* lptr = lower_.get();
         const Real* dptr = diag_.get();
         const Real* uptr = upper_.get();
+        const Size* rptr = reverseIndex_.get();
+
+        // The system decouples into independent lines along the given
+        // direction, which are contiguous in the reversed ordering and
+        // are solved concurrently; this requires the lower coefficient
+        // at the first point and the upper one at the last point of
+        // each line to be null, as they are for the derivative
+        // operators.  The Thomson algorithm for each line is taken
+        // from TridiagonalOperator and changed to fit for the triple
+        // band operator.
+        const Size n = layout->dim()[direction_];
+        const long lines = static_cast<long>(layout->size()/n);
+        Size failures = 0, couplings = 0;
+        #if defined(_OPENMP)
+        const long size = static_cast<long>(layout->size());
+        #pragma omp parallel reduction(+:failures,couplings) \
+                             if(lines > 1 && size > minParallelSize)
+        #endif
+        {
+            // each thread keeps the coefficients of its current line,
+            // so that the operator can be used by several threads
+            std::vector<Real> tmp(n);
+
+            #if defined(_OPENMP)
+            #pragma omp for
+            #endif
+            for (long l=0; l < lines; ++l) {
+                const Size first = l*n, last = first + n;
+
+                if (lptr[rptr[first]] != 0.0 || uptr[rptr[last-1]] != 0.0) {
+                    ++couplings;
+                    continue;
+                }
 
-        // Thomson algorithm to solve a tridiagonal system.
-        // Example code taken from Tridiagonalopertor and
-        // changed to fit for the triple band operator.
-        Size rim1 = reverseIndex_[0];
-        Real bet=1.0/(a*dptr[rim1]+b);
-        QL_REQUIRE(bet != 0.0, "division by zero");
-        retVal[reverseIndex_[0]] = r[rim1]*bet;
-
-        for (Size j=1; j<=layout->size()-1; j++){
-            const Size ri = reverseIndex_[j];
-            tmp[j] = a*uptr[rim1]*bet;
-
-            bet=b+a*(dptr[ri]-tmp[j]*lptr[ri]);
-            QL_ENSURE(bet != 0.0, "division by zero");
-            bet=1.0/bet;
-
-            retVal[ri] = (r[ri]-a*lptr[ri]*retVal[rim1])*bet;
-            rim1 = ri;
+                Size rim1 = rptr[first];
+                Real bet = a*dptr[rim1]+b;
+                if (bet == 0.0) {
+                    ++failures;
+                    continue;
+                }
+                bet = 1.0/bet;
+                retVal[rim1] = r[rim1]*bet;
+
+                for (Size j=1; j < n; ++j) {
+                    const Size ri = rptr[first+j];
+                    tmp[j] = a*uptr[rim1]*bet;
+
+                    bet=b+a*(dptr[ri]-tmp[j]*lptr[ri]);
+                    if (bet == 0.0) {
+                        ++failures;
+                        break;
+                    }
+                    bet=1.0/bet;
+
+                    retVal[ri] = (r[ri]-a*lptr[ri]*retVal[rim1])*bet;
+                    rim1 = ri;
+                }
+                for (Size j=n-1; j > 0; --j)
+                    retVal[rptr[first+j-1]] -=
+                        tmp[j]*retVal[rptr[first+j]];
+            }
         }
-        // cannot be j>=0 with Size j
-        for (Size j=layout->size()-2; j>0; --j)
-            retVal[reverseIndex_[j]] -= tmp[j+1]*retVal[reverseIndex_[j+1]];
-        retVal[reverseIndex_[0]] -= tmp[1]*retVal[reverseIndex_[1]];
-
-        return retVal;
+        QL_REQUIRE(couplings == 0,
+                   "non-zero coefficients at the boundaries of "
+                   << couplings << " lines");
+        QL_ENSURE(failures == 0, "division by zero");
     }
 }
@@ -44,9 +44,36 @@ namespace QuantLib {
         TripleBandLinearOp& operator=(const Disposable<TripleBandLinearOp>& m);
 
         Disposable<Array> apply(const Array& r) const;
+        /*! solves \f$ (a L + b I) x = r \f$ independently on each
+            line along the operator direction.
+
+            \pre the lower coefficient at the first point and the
+                 upper coefficient at the last point of each line
+                 must be null.
+        */
         Disposable<Array> solve_splitting(const Array& r, Real a,
                                           Real b = 1.0) const;
 
+        /*! \name in-place versions
+            The following methods write their results into the passed
+            array or operator, which is resized only if needed, so
+            that their storage can be reused across time steps.
+        */
+        //@{
+        //! \pre \c retVal and \c r must be different arrays
+        void apply(const Array& r, Array& retVal) const;
+        //! adds the result of apply() to \c retVal
+        /*! \pre \c retVal and \c r must be different arrays of
+                 the same size
+        */
+        void apply_add(const Array& r, Array& retVal) const;
+        //! \c retVal and \c r can be the same array
+        void solve_splitting(const Array& r, Real a, Real b,
+                             Array& retVal) const;
+        //! \pre \c retVal must be built on the same mesher
+        void mult(const Array& u, TripleBandLinearOp& retVal) const;
+        //@}
+
         Disposable<TripleBandLinearOp> mult(const Array& u) const;
         Disposable<TripleBandLinearOp> add(const TripleBandLinearOp& m) const;
         Disposable<TripleBandLinearOp> add(const Array& u) const;
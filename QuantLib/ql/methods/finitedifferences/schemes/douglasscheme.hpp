@@ -54,6 +54,9 @@ namespace QuantLib {
         const Real theta_;
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+
+        // workspace kept across steps
+        Array y_, rhs_, tmp_;
     };
 }
 
@@ -59,6 +59,9 @@ namespace QuantLib {
 
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+
+        // workspace kept across steps
+        Array y_, y0_, yt_, rhs_, diff_, tmp_;
     };
 }
 
@@ -32,10 +32,42 @@
 #include <ql/methods/finitedifferences/schemes/modifiedcraigsneydscheme.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
 
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
 namespace QuantLib {
-    
-    FdmSchemeDesc::FdmSchemeDesc(FdmSchemeType aType, Real aTheta, Real aMu)
-    : type(aType), theta(aTheta), mu(aMu) { }
+
+    namespace {
+
+        // sets the number of threads used by the operators during
+        // the rollback and restores the previous one afterwards
+        class ThreadCountSetter {
+          public:
+            explicit ThreadCountSetter(Size numThreads) {
+                #if defined(_OPENMP)
+                previous_ = omp_get_max_threads();
+                omp_set_num_threads(static_cast<int>(numThreads));
+                #endif
+            }
+            ~ThreadCountSetter() {
+                #if defined(_OPENMP)
+                omp_set_num_threads(previous_);
+                #endif
+            }
+          private:
+            #if defined(_OPENMP)
+            int previous_;
+            #endif
+        };
+
+    }
+
+    FdmSchemeDesc::FdmSchemeDesc(FdmSchemeType aType, Real aTheta, Real aMu,
+                                 Size aNumThreads)
+    : type(aType), theta(aTheta), mu(aMu), numThreads(aNumThreads) {
+        QL_REQUIRE(numThreads > 0, "null number of threads given");
+    }
 
     FdmSchemeDesc FdmSchemeDesc::Douglas() { 
         return FdmSchemeDesc(FdmSchemeDesc::DouglasType, 0.5, 0.0);
@@ -86,6 +118,8 @@ namespace QuantLib {
                                      Time from, Time to,
                                      Size steps, Size dampingSteps) {
 
+        const ThreadCountSetter threads(schemeDesc_.numThreads);
+
         const Time deltaT = from - to;
         const Size allSteps = steps + dampingSteps;
         const Time dampingTo = from - (deltaT*dampingSteps)/allSteps;
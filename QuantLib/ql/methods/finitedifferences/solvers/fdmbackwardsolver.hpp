@@ -37,10 +37,16 @@ namespace QuantLib {
                              CraigSneydType, ModifiedCraigSneydType, 
                              ImplicitEulerType, ExplicitEulerType };
 
-        FdmSchemeDesc(FdmSchemeType type, Real theta, Real mu);
+        FdmSchemeDesc(FdmSchemeType type, Real theta, Real mu,
+                      Size numThreads = 1);
 
         const FdmSchemeType type;
         const Real theta, mu;
+        /*! number of threads used by the operators to apply and
+            invert their directional parts; it only has an effect
+            when QuantLib is compiled with OpenMP support.
+        */
+        const Size numThreads;
 
         // some default scheme descriptions
         static FdmSchemeDesc Douglas();
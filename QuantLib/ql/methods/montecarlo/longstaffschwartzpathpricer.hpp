@@ -27,6 +27,7 @@
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/math/functional.hpp>
 #include <ql/math/generallinearleastsquares.hpp>
+#include <ql/math/streaminglinearleastsquares.hpp>
 #include <ql/methods/montecarlo/pathpricer.hpp>
 #include <ql/methods/montecarlo/earlyexercisepathpricer.hpp>
 #include <boost/bind.hpp>
@@ -41,6 +42,15 @@ namespace QuantLib {
         by Simulation: A Simple Least-Squares Approach, The Review of
         Financial Studies, Volume 14, No. 1, 113-147
 
+        By default, the calibration paths are stored and regressed
+        upon when calibrate() is called. In streaming mode, enabled
+        by startStreamingCalibration(), they are not stored; instead,
+        the same calibration paths must be passed once for each
+        exercise date, going backwards, until nextCalibrationPass()
+        returns false. During each pass the normal equations of the
+        regression are accumulated, so that only the current price
+        of each path needs to be kept in memory.
+
         \ingroup mcarlo
 
         \test the correctness of the returned value is tested by
@@ -59,7 +69,21 @@ namespace QuantLib {
         Real operator()(const PathType& path) const;
         virtual void calibrate();
 
+        //! \name Streaming calibration
+        //@{
+        //! calibration paths will not be stored
+        void startStreamingCalibration();
+        /*! estimates the regression coefficients for the current
+            exercise date; returns true if the calibration paths must
+            be passed again for the previous one.
+        */
+        bool nextCalibrationPass();
+        //@}
+
       protected:
+        void accumulate(const PathType& path) const;
+        Real continuationValue(const PathType& path, Size i) const;
+
         bool  calibrationPhase_;
         const boost::shared_ptr<EarlyExercisePathPricer<PathType> >
             pathPricer_;
@@ -69,6 +93,12 @@ namespace QuantLib {
 
         mutable std::vector<PathType> paths_;
         const   std::vector<boost::function1<Real, StateType> > v_;
+
+        // streaming calibration
+        bool streaming_, firstPass_;
+        mutable Size calibrationDate_, pathIndex_;
+        mutable std::vector<Real> prices_;
+        mutable StreamingLinearLeastSquares lsq_;
     };
 
     template <class PathType> inline
@@ -81,7 +111,10 @@ namespace QuantLib {
       pathPricer_(pathPricer),
       coeff_     (new Array[times.size()-1]),
       dF_        (new DiscountFactor[times.size()-1]),
-      v_         (pathPricer_->basisSystem()) {
+      v_         (pathPricer_->basisSystem()),
+      streaming_(false), firstPass_(true),
+      calibrationDate_(Null<Size>()), pathIndex_(0),
+      lsq_(v_.size()) {
 
         for (Size i=0; i<times.size()-1; ++i) {
             dF_[i] =   termStructure->discount(times[i+1])
@@ -93,8 +126,11 @@ namespace QuantLib {
     Real LongstaffSchwartzPathPricer<PathType>::operator()
         (const PathType& path) const {
         if (calibrationPhase_) {
-            // store paths for the calibration
-            paths_.push_back(path);
+            if (streaming_)
+                accumulate(path);
+            else
+                // store paths for the calibration
+                paths_.push_back(path);
             // result doesn't matter
             return 0.0;
         }
@@ -105,25 +141,38 @@ namespace QuantLib {
             price*=dF_[i];
 
             const Real exercise = (*pathPricer_)(path, i);
-            if (exercise > 0.0) {
-                const StateType regValue = pathPricer_->state(path, i);
-
-                Real continuationValue = 0.0;
-                for (Size l=0; l<v_.size(); ++l) {
-                    continuationValue += coeff_[i][l] * v_[l](regValue);
-                }
-
-                if (continuationValue < exercise) {
-                    price = exercise;
-                }
+            if (exercise > 0.0 && continuationValue(path, i) < exercise) {
+                price = exercise;
             }
         }
 
         return price*dF_[0];
     }
 
+    template <class PathType> inline
+    Real LongstaffSchwartzPathPricer<PathType>::continuationValue(
+                                   const PathType& path, Size i) const {
+        const StateType regValue = pathPricer_->state(path, i);
+
+        Real value = 0.0;
+        for (Size l=0; l<v_.size(); ++l) {
+            value += coeff_[i][l] * v_[l](regValue);
+        }
+        return value;
+    }
+
     template <class PathType> inline
     void LongstaffSchwartzPathPricer<PathType>::calibrate() {
+        if (streaming_) {
+            QL_REQUIRE(calibrationDate_ == 0 ||
+                       (calibrationDate_ == Null<Size>() && !firstPass_),
+                       "streaming calibration not completed");
+            std::vector<Real> empty;
+            prices_.swap(empty);
+            calibrationPhase_ = false;
+            return;
+        }
+
         const Size n = paths_.size();
         Array prices(n), exercise(n);
         const Size len = EarlyExerciseTraits<PathType>::pathLength(paths_[0]);
@@ -177,6 +226,72 @@ namespace QuantLib {
         // entering the calculation phase
         calibrationPhase_ = false;
     }
+
+    template <class PathType> inline
+    void LongstaffSchwartzPathPricer<PathType>::startStreamingCalibration() {
+        QL_REQUIRE(calibrationPhase_ && paths_.empty(),
+                   "calibration already started");
+        streaming_ = true;
+    }
+
+    template <class PathType> inline
+    void LongstaffSchwartzPathPricer<PathType>::accumulate(
+                                               const PathType& path) const {
+        const Size len = EarlyExerciseTraits<PathType>::pathLength(path);
+        if (len < 3)
+            // no early-exercise dates to calibrate
+            return;
+
+        Real price;
+        if (firstPass_) {
+            calibrationDate_ = len-2;
+            price = (*pathPricer_)(path, len-1);
+            prices_.push_back(price);
+        } else {
+            QL_REQUIRE(pathIndex_ < prices_.size(),
+                       "more calibration paths than in the first pass");
+            // roll back the price from the exercise date
+            // calibrated by the previous pass
+            const Size i = calibrationDate_+1;
+            price = prices_[pathIndex_]*dF_[i];
+            const Real exercise = (*pathPricer_)(path, i);
+            if (exercise > 0.0 && continuationValue(path, i) < exercise)
+                price = exercise;
+            prices_[pathIndex_] = price;
+        }
+        ++pathIndex_;
+
+        const Size i = calibrationDate_;
+        if ((*pathPricer_)(path, i) > 0.0)
+            lsq_.add(pathPricer_->state(path, i), dF_[i]*price, v_);
+    }
+
+    template <class PathType> inline
+    bool LongstaffSchwartzPathPricer<PathType>::nextCalibrationPass() {
+        if (!streaming_ || !calibrationPhase_)
+            return false;
+        firstPass_ = false;
+        if (calibrationDate_ == Null<Size>() || calibrationDate_ == 0)
+            // nothing to calibrate
+            return false;
+
+        QL_REQUIRE(pathIndex_ == prices_.size(),
+                   pathIndex_ << " calibration paths passed, "
+                   << prices_.size() << " expected");
+        pathIndex_ = 0;
+
+        const Size i = calibrationDate_;
+        if (v_.size() <= lsq_.size()) {
+            coeff_[i] = lsq_.coefficients();
+        } else {
+            // if number of itm paths is smaller then the number of
+            // calibration functions then early exercise if exerciseValue > 0
+            coeff_[i] = Array(v_.size(), 0.0);
+        }
+        lsq_.reset();
+
+        return --calibrationDate_ > 0;
+    }
 }
 
 
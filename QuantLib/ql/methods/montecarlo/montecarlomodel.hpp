@@ -28,9 +28,24 @@
 #include <ql/methods/montecarlo/mctraits.hpp>
 #include <ql/math/statistics/statistics.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <algorithm>
+#include <vector>
+#include <string>
 
 namespace QuantLib {
 
+    namespace detail {
+
+        // path generators able to fill blocks of paths
+        template <class PathGenerator>
+        struct generates_blocks : boost::false_type {};
+
+        template <class GSG>
+        struct generates_blocks<PathGenerator<GSG> > : boost::true_type {};
+
+    }
+
     //! General-purpose Monte Carlo model for path samples
     /*! The template arguments of this class correspond to available
         policies for the particular model to be instantiated---i.e.,
@@ -45,6 +60,28 @@ namespace QuantLib {
         provide the additional control option, namely the option path
         pricer and the option value.
 
+        When the path pricers (and the control-variate ones, if any)
+        also implement BlockPathPricer<PathBlock>, single-factor paths
+        are generated and priced in blocks instead of one at a time.
+        The samples are the same and are added in the same order.
+
+        Samples can also be drawn on multiple threads by passing one
+        path generator and one path pricer per worker.  In this case,
+        each call to addSamples() splits the required samples in
+        contiguous chunks, one for each worker; the results of each
+        chunk are added to the accumulator in worker order, so that
+        the statistics only depend on the generators and on the number
+        of workers and not on thread scheduling.  With pseudo-random
+        numbers, the path generators must produce independent streams.
+        With low-discrepancy sequences, they must produce the same
+        sequence and support skipTo(); each worker is moved to the
+        start of its chunk, so that the points used are the same as
+        those drawn by a single generator.  The path pricers must be
+        safe to use concurrently with those of the other workers.
+        Threads are only spawned when the library is compiled with
+        OpenMP support; otherwise, the chunks are simulated serially
+        with the same results.
+
         \ingroup mcarlo
     */
     template <template <class> class MC, class RNG, class S = Statistics>
@@ -56,8 +93,9 @@ namespace QuantLib {
         typedef typename MC<RNG>::path_pricer_type path_pricer_type;
         typedef typename path_generator_type::sample_type sample_type;
         typedef typename path_pricer_type::result_type result_type;
+        typedef BlockPathPricer<PathBlock,result_type> block_pricer_type;
         typedef S stats_type;
-        // constructor
+        // constructors
         MonteCarloModel(
                   const boost::shared_ptr<path_generator_type>& pathGenerator,
                   const boost::shared_ptr<path_pricer_type>& pathPricer,
@@ -68,64 +106,295 @@ namespace QuantLib {
                   result_type cvOptionValue = result_type(),
                   const boost::shared_ptr<path_generator_type>& cvPathGenerator
                         = boost::shared_ptr<path_generator_type>())
-        : pathGenerator_(pathGenerator), pathPricer_(pathPricer),
+        : pathGenerators_(1, pathGenerator), pathPricers_(1, pathPricer),
           sampleAccumulator_(sampleAccumulator),
           isAntitheticVariate_(antitheticVariate),
-          cvPathPricer_(cvPathPricer), cvOptionValue_(cvOptionValue),
-          cvPathGenerator_(cvPathGenerator) {
-            if (!cvPathPricer_)
+          cvPathPricers_(1, cvPathPricer), cvOptionValue_(cvOptionValue),
+          cvPathGenerators_(1, cvPathGenerator), drawn_(0) {
+            if (!cvPathPricer)
                 isControlVariate_ = false;
             else
                 isControlVariate_ = true;
+            initializeBlockPricers();
+        }
+        //! multithreaded model with one generator and pricer per worker
+        MonteCarloModel(
+            const std::vector<boost::shared_ptr<path_generator_type> >&
+                                                              pathGenerators,
+            const std::vector<boost::shared_ptr<path_pricer_type> >&
+                                                              pathPricers,
+            const stats_type& sampleAccumulator,
+            bool antitheticVariate,
+            const std::vector<boost::shared_ptr<path_pricer_type> >&
+                cvPathPricers =
+                    std::vector<boost::shared_ptr<path_pricer_type> >(),
+            result_type cvOptionValue = result_type(),
+            const std::vector<boost::shared_ptr<path_generator_type> >&
+                cvPathGenerators =
+                    std::vector<boost::shared_ptr<path_generator_type> >())
+        : pathGenerators_(pathGenerators), pathPricers_(pathPricers),
+          sampleAccumulator_(sampleAccumulator),
+          isAntitheticVariate_(antitheticVariate),
+          cvPathPricers_(cvPathPricers), cvOptionValue_(cvOptionValue),
+          cvPathGenerators_(cvPathGenerators), drawn_(0) {
+            Size n = pathGenerators_.size();
+            QL_REQUIRE(n > 0, "no path generator given");
+            nextDraws_.resize(n, 0);
+            QL_REQUIRE(pathPricers_.size() == n,
+                       "wrong number of path pricers (" << pathPricers_.size()
+                       << ") given for " << n << " path generators");
+            isControlVariate_ = !cvPathPricers_.empty();
+            if (isControlVariate_) {
+                QL_REQUIRE(cvPathPricers_.size() == n,
+                           "wrong number of control-variate path pricers ("
+                           << cvPathPricers_.size() << ") given for "
+                           << n << " path generators");
+            }
+            if (cvPathGenerators_.empty())
+                cvPathGenerators_.resize(n);
+            QL_REQUIRE(cvPathGenerators_.size() == n,
+                       "wrong number of control-variate path generators ("
+                       << cvPathGenerators_.size() << ") given for "
+                       << n << " path generators");
+            initializeBlockPricers();
         }
         void addSamples(Size samples);
         const stats_type& sampleAccumulator(void) const;
+        //! number of workers among which samples are split
+        Size workers() const { return pathGenerators_.size(); }
       private:
-        boost::shared_ptr<path_generator_type> pathGenerator_;
-        boost::shared_ptr<path_pricer_type> pathPricer_;
+        enum { blockSize = 256 };
+        void initializeBlockPricers();
+        void nextSample(Size worker, result_type& price, Real& weight) const;
+        typedef std::vector<std::pair<result_type,Real> > samples_type;
+        void drawSamples(Size worker, Size samples,
+                         samples_type& results) const {
+            drawSamples(worker, samples, results,
+                        detail::generates_blocks<path_generator_type>());
+        }
+        void drawSamples(Size worker, Size samples, samples_type& results,
+                         boost::false_type) const;
+        void drawSamples(Size worker, Size samples, samples_type& results,
+                         boost::true_type) const;
+        void skipToChunks(Size samples, boost::false_type) {}
+        void skipToChunks(Size samples, boost::true_type);
+        std::vector<boost::shared_ptr<path_generator_type> > pathGenerators_;
+        std::vector<boost::shared_ptr<path_pricer_type> > pathPricers_;
         stats_type sampleAccumulator_;
         bool isAntitheticVariate_;
-        boost::shared_ptr<path_pricer_type> cvPathPricer_;
+        std::vector<boost::shared_ptr<path_pricer_type> > cvPathPricers_;
         result_type cvOptionValue_;
         bool isControlVariate_;
-        boost::shared_ptr<path_generator_type> cvPathGenerator_;
+        std::vector<boost::shared_ptr<path_generator_type> > cvPathGenerators_;
+        // empty unless all paths can be priced in blocks
+        std::vector<boost::shared_ptr<block_pricer_type> > blockPricers_;
+        std::vector<boost::shared_ptr<block_pricer_type> > cvBlockPricers_;
+        // position in the low-discrepancy sequence
+        unsigned long drawn_;
+        std::vector<unsigned long> nextDraws_;
     };
 
     // inline definitions
     template <template <class> class MC, class RNG, class S>
-    inline void MonteCarloModel<MC,RNG,S>::addSamples(Size samples) {
-        for(Size j = 1; j <= samples; j++) {
+    inline void MonteCarloModel<MC,RNG,S>::initializeBlockPricers() {
+        if (!detail::generates_blocks<path_generator_type>::value)
+            return;
+        for (Size i=0; i<pathPricers_.size(); ++i) {
+            blockPricers_.push_back(
+                boost::dynamic_pointer_cast<block_pricer_type>(
+                                                         pathPricers_[i]));
+            if (isControlVariate_) {
+                cvBlockPricers_.push_back(
+                    boost::dynamic_pointer_cast<block_pricer_type>(
+                                                       cvPathPricers_[i]));
+                if (!cvBlockPricers_.back() || cvPathGenerators_[i])
+                    blockPricers_.back().reset();
+            }
+            if (!blockPricers_.back()) {
+                blockPricers_.clear();
+                cvBlockPricers_.clear();
+                return;
+            }
+        }
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::nextSample(Size worker,
+                                                      result_type& price,
+                                                      Real& weight) const {
+        path_generator_type& pathGenerator = *pathGenerators_[worker];
+        const path_pricer_type& pathPricer = *pathPricers_[worker];
+        const boost::shared_ptr<path_generator_type>& cvPathGenerator =
+            cvPathGenerators_[worker];
 
-            sample_type path = pathGenerator_->next();
-            result_type price = (*pathPricer_)(path.value);
+        sample_type path = pathGenerator.next();
+        price = pathPricer(path.value);
 
+        if (isControlVariate_) {
+            const path_pricer_type& cvPathPricer = *cvPathPricers_[worker];
+            if (!cvPathGenerator) {
+                price += cvOptionValue_-cvPathPricer(path.value);
+            }
+            else {
+                sample_type cvPath = cvPathGenerator->next();
+                price += cvOptionValue_-cvPathPricer(cvPath.value);
+            }
+        }
+
+        if (isAntitheticVariate_) {
+            path = pathGenerator.antithetic();
+            result_type price2 = pathPricer(path.value);
             if (isControlVariate_) {
-                if (!cvPathGenerator_) {
-                    price += cvOptionValue_-(*cvPathPricer_)(path.value);
-                }
+                const path_pricer_type& cvPathPricer =
+                    *cvPathPricers_[worker];
+                if (!cvPathGenerator)
+                    price2 += cvOptionValue_-cvPathPricer(path.value);
                 else {
-                    sample_type cvPath = cvPathGenerator_->next();
-                    price += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
+                    sample_type cvPath = cvPathGenerator->antithetic();
+                    price2 += cvOptionValue_-cvPathPricer(cvPath.value);
                 }
             }
 
+            price = (price+price2)/2.0;
+        }
+        weight = path.weight;
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::drawSamples(
+                                                Size worker, Size samples,
+                                                samples_type& results,
+                                                boost::false_type) const {
+        result_type price;
+        Real weight;
+        for (Size j=0; j<samples; ++j) {
+            nextSample(worker, price, weight);
+            results.push_back(std::make_pair(price, weight));
+        }
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::drawSamples(
+                                                Size worker, Size samples,
+                                                samples_type& results,
+                                                boost::true_type) const {
+        if (blockPricers_.empty()) {
+            drawSamples(worker, samples, results, boost::false_type());
+            return;
+        }
+
+        const path_generator_type& pathGenerator = *pathGenerators_[worker];
+        const block_pricer_type& pathPricer = *blockPricers_[worker];
+        std::vector<result_type> prices, antitheticPrices, cvPrices;
+        while (samples > 0) {
+            const Size m = std::min<Size>(samples, blockSize);
+            PathBlock paths(pathGenerator.timeGrid(), m);
+
+            pathGenerator.nextBlock(paths);
+            pathPricer(paths, prices);
+            if (isControlVariate_) {
+                (*cvBlockPricers_[worker])(paths, cvPrices);
+                for (Size j=0; j<m; ++j)
+                    prices[j] += cvOptionValue_-cvPrices[j];
+            }
+
             if (isAntitheticVariate_) {
-                path = pathGenerator_->antithetic();
-                result_type price2 = (*pathPricer_)(path.value);
+                pathGenerator.antitheticBlock(paths);
+                pathPricer(paths, antitheticPrices);
                 if (isControlVariate_) {
-                    if (!cvPathGenerator_)
-                        price2 += cvOptionValue_-(*cvPathPricer_)(path.value);
-                    else {
-                        sample_type cvPath = cvPathGenerator_->antithetic();
-                        price2 += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
-                    }
+                    (*cvBlockPricers_[worker])(paths, cvPrices);
+                    for (Size j=0; j<m; ++j)
+                        antitheticPrices[j] += cvOptionValue_-cvPrices[j];
                 }
+                for (Size j=0; j<m; ++j)
+                    prices[j] = (prices[j]+antitheticPrices[j])/2.0;
+            }
+
+            for (Size j=0; j<m; ++j)
+                results.push_back(std::make_pair(prices[j],
+                                                 paths.weight(j)));
+            samples -= m;
+        }
+    }
 
-                sampleAccumulator_.add((price+price2)/2.0, path.weight);
-            } else {
-                sampleAccumulator_.add(price, path.weight);
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::skipToChunks(Size samples,
+                                                        boost::true_type) {
+        const Size n = pathGenerators_.size();
+        unsigned long first = drawn_;
+        for (Size i=0; i<n; ++i) {
+            const Size chunk = samples/n + (i < samples%n ? 1 : 0);
+            if (chunk == 0)
+                continue;
+            // as for SobolRsg, the first draw after construction
+            // returns the point skipped to; later ones the next point
+            if (nextDraws_[i] != first)
+                pathGenerators_[i]->skipTo(nextDraws_[i] == 0 ?
+                                           first : first-1);
+            first += chunk;
+            nextDraws_[i] = first;
+        }
+        drawn_ = first;
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::addSamples(Size samples) {
+        const Size n = pathGenerators_.size();
+
+        if (n == 1) {
+            samples_type results;
+            while (samples > 0) {
+                const Size m = std::min<Size>(samples, blockSize);
+                results.clear();
+                drawSamples(0, m, results);
+                for (Size j=0; j<m; ++j)
+                    sampleAccumulator_.add(results[j].first,
+                                           results[j].second);
+                samples -= m;
             }
+            return;
         }
+
+        // contiguous chunks, the first (samples % n) ones being one
+        // sample larger than the others
+        skipToChunks(samples,
+                     boost::integral_constant<bool,
+                                              !RNG::allowsErrorEstimate>());
+        std::vector<samples_type> results(n);
+        for (Size i=0; i<n; ++i)
+            results[i].reserve(samples/n + (i < samples%n ? 1 : 0));
+
+        // The first sample is drawn on the calling thread so that any
+        // lazy initialization in the underlying processes and term
+        // structures is performed before the workers are started.
+        if (samples > 0)
+            drawSamples(0, 1, results[0]);
+
+        std::vector<std::string> errors(n);
+        const long workers = static_cast<long>(n);
+        #if defined(_OPENMP)
+        #pragma omp parallel for schedule(static,1) num_threads(workers)
+        #endif
+        for (long w = 0; w < workers; ++w) {
+            const Size i = static_cast<Size>(w);
+            try {
+                const Size chunk = samples/n + (i < samples%n ? 1 : 0);
+                drawSamples(i, chunk - results[i].size(), results[i]);
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+            } catch (...) {
+                errors[i] = "unknown error";
+            }
+        }
+
+        for (Size i=0; i<n; ++i)
+            QL_REQUIRE(errors[i].empty(),
+                       "worker " << i << " failed: " << errors[i]);
+
+        for (Size i=0; i<n; ++i)
+            for (Size j=0; j<results[i].size(); ++j)
+                sampleAccumulator_.add(results[i][j].first,
+                                       results[i][j].second);
     }
 
     template <template <class> class MC, class RNG, class S>
@@ -56,6 +56,10 @@ namespace QuantLib {
                            bool brownianBridge = false);
         const sample_type& next() const;
         const sample_type& antithetic() const;
+        /*! skips to the n-th sample of the underlying sequence;
+            requires GSG to implement skipTo().
+        */
+        void skipTo(unsigned long n) { generator_.skipTo(n); }
       private:
         const sample_type& next(bool antithetic) const;
         bool brownianBridge_;
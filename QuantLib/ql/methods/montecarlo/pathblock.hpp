@@ -0,0 +1,139 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file pathblock.hpp
+    \brief block of single-factor random walks
+*/
+
+#ifndef quantlib_montecarlo_path_block_hpp
+#define quantlib_montecarlo_path_block_hpp
+
+#include <ql/methods/montecarlo/path.hpp>
+#include <ql/math/matrix.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! block of single-factor random walks
+    /*! The asset values are stored in a [time x path] matrix, so
+        that the values of all paths at a given time are contiguous
+        in memory; this allows the paths to be evolved and priced a
+        time step at a time instead of a path at a time.
+
+        \ingroup mcarlo
+
+        \note each path includes the initial asset value as its
+              first point.
+    */
+    class PathBlock {
+      public:
+        PathBlock(const TimeGrid& timeGrid, Size paths);
+        //! \name inspectors
+        //@{
+        bool empty() const;
+        //! number of points in each path
+        Size length() const;
+        //! number of paths in the block
+        Size size() const;
+        //! value of the \f$ j \f$-th path at the \f$ i \f$-th point
+        Real operator()(Size i, Size j) const;
+        Real& operator()(Size i, Size j);
+        //! values of all paths at the \f$ i \f$-th point
+        Matrix::const_row_iterator begin(Size i) const;
+        Matrix::const_row_iterator end(Size i) const;
+        Matrix::row_iterator begin(Size i);
+        Matrix::row_iterator end(Size i);
+        //! weight of the \f$ j \f$-th path
+        Real weight(Size j) const;
+        Real& weight(Size j);
+        //! copy of the \f$ j \f$-th path
+        Path path(Size j) const;
+        //! time grid
+        const TimeGrid& timeGrid() const;
+        //@}
+      private:
+        TimeGrid timeGrid_;
+        Matrix values_;
+        std::vector<Real> weights_;
+    };
+
+
+    // inline definitions
+
+    inline PathBlock::PathBlock(const TimeGrid& timeGrid, Size paths)
+    : timeGrid_(timeGrid), values_(timeGrid_.size(), paths),
+      weights_(paths, 1.0) {
+        QL_REQUIRE(paths > 0, "null number of paths given");
+    }
+
+    inline bool PathBlock::empty() const {
+        return timeGrid_.empty();
+    }
+
+    inline Size PathBlock::length() const {
+        return timeGrid_.size();
+    }
+
+    inline Size PathBlock::size() const {
+        return weights_.size();
+    }
+
+    inline Real PathBlock::operator()(Size i, Size j) const {
+        return values_[i][j];
+    }
+
+    inline Real& PathBlock::operator()(Size i, Size j) {
+        return values_[i][j];
+    }
+
+    inline Matrix::const_row_iterator PathBlock::begin(Size i) const {
+        return values_.row_begin(i);
+    }
+
+    inline Matrix::const_row_iterator PathBlock::end(Size i) const {
+        return values_.row_end(i);
+    }
+
+    inline Matrix::row_iterator PathBlock::begin(Size i) {
+        return values_.row_begin(i);
+    }
+
+    inline Matrix::row_iterator PathBlock::end(Size i) {
+        return values_.row_end(i);
+    }
+
+    inline Real PathBlock::weight(Size j) const {
+        return weights_[j];
+    }
+
+    inline Real& PathBlock::weight(Size j) {
+        return weights_[j];
+    }
+
+    inline Path PathBlock::path(Size j) const {
+        Array values(values_.column_begin(j), values_.column_end(j));
+        return Path(timeGrid_, values);
+    }
+
+    inline const TimeGrid& PathBlock::timeGrid() const {
+        return timeGrid_;
+    }
+
+}
+
+
+#endif
@@ -27,6 +27,7 @@
 #define quantlib_montecarlo_path_generator_hpp
 
 #include <ql/methods/montecarlo/brownianbridge.hpp>
+#include <ql/methods/montecarlo/pathblock.hpp>
 #include <ql/stochasticprocess.hpp>
 
 namespace QuantLib {
@@ -38,7 +39,10 @@ namespace QuantLib {
 
         \ingroup mcarlo
 
-        \test the generated paths are checked against cached results
+        \test
+        - the generated paths are checked against cached results
+        - the paths generated in blocks, and their antithetic
+          paths, are checked against the ones generated one by one
     */
     template <class GSG>
     class PathGenerator {
@@ -58,11 +62,27 @@ namespace QuantLib {
         //@{
         const sample_type& next() const;
         const sample_type& antithetic() const;
+        /*! fills the given block with the next paths, in the same
+            order in which they would be returned by next().  The
+            process is evolved a time step at a time for all the
+            paths in the block; no memory is allocated once the
+            block size is established.
+        */
+        void nextBlock(PathBlock& block) const;
+        /*! fills the given block with the antithetic paths of the
+            ones returned by the last call to nextBlock().
+        */
+        void antitheticBlock(PathBlock& block) const;
         Size size() const { return dimension_; }
         const TimeGrid& timeGrid() const { return timeGrid_; }
         //@}
+        /*! skips to the n-th sample of the underlying sequence;
+            requires GSG to implement skipTo().
+        */
+        void skipTo(unsigned long n) { generator_.skipTo(n); }
       private:
         const sample_type& next(bool antithetic) const;
+        void evolveBlock(PathBlock& block) const;
         bool brownianBridge_;
         GSG generator_;
         Size dimension_;
@@ -70,6 +90,8 @@ namespace QuantLib {
         boost::shared_ptr<StochasticProcess1D> process_;
         mutable sample_type next_;
         mutable std::vector<Real> temp_;
+        mutable Matrix increments_;
+        mutable std::vector<Real> weights_;
         BrownianBridge bb_;
     };
 
@@ -119,6 +141,73 @@ namespace QuantLib {
         return next(true);
     }
 
+    template <class GSG>
+    void PathGenerator<GSG>::nextBlock(PathBlock& block) const {
+        QL_REQUIRE(block.length() == timeGrid_.size(),
+                   "block length (" << block.length()
+                   << ") != time-grid size (" << timeGrid_.size() << ")");
+
+        typedef typename GSG::sample_type sequence_type;
+
+        Size n = block.size();
+        if (increments_.rows() != dimension_ || increments_.columns() != n) {
+            increments_ = Matrix(dimension_, n);
+            weights_.resize(n);
+        }
+
+        // draw the random numbers, one path at a time
+        for (Size j=0; j<n; j++) {
+            const sequence_type& sequence_ = generator_.nextSequence();
+            if (brownianBridge_) {
+                bb_.transform(sequence_.value.begin(),
+                              sequence_.value.end(),
+                              temp_.begin());
+            } else {
+                std::copy(sequence_.value.begin(),
+                          sequence_.value.end(),
+                          temp_.begin());
+            }
+            std::copy(temp_.begin(), temp_.end(),
+                      increments_.column_begin(j));
+            weights_[j] = sequence_.weight;
+        }
+
+        evolveBlock(block);
+    }
+
+    template <class GSG>
+    void PathGenerator<GSG>::antitheticBlock(PathBlock& block) const {
+        QL_REQUIRE(block.length() == timeGrid_.size(),
+                   "block length (" << block.length()
+                   << ") != time-grid size (" << timeGrid_.size() << ")");
+        QL_REQUIRE(increments_.rows() == dimension_ &&
+                   increments_.columns() == block.size(),
+                   "block size (" << block.size() << ") different "
+                   "from the one last passed to nextBlock()");
+
+        // flipping the sign is exact, so the increments can be
+        // restored afterwards
+        increments_ *= -1.0;
+        evolveBlock(block);
+        increments_ *= -1.0;
+    }
+
+    template <class GSG>
+    void PathGenerator<GSG>::evolveBlock(PathBlock& block) const {
+        Size n = block.size();
+        for (Size j=0; j<n; j++)
+            block.weight(j) = weights_[j];
+
+        // evolve all paths, one time step at a time
+        std::fill(block.begin(0), block.end(0), process_->x0());
+        for (Size i=1; i<block.length(); i++) {
+            Time t = timeGrid_[i-1];
+            Time dt = timeGrid_.dt(i-1);
+            process_->evolve(t, dt, n, block.begin(i-1),
+                             increments_.row_begin(i-1), block.begin(i));
+        }
+    }
+
     template <class GSG>
     const typename PathGenerator<GSG>::sample_type&
     PathGenerator<GSG>::next(bool antithetic) const {
@@ -28,6 +28,7 @@
 #include <ql/option.hpp>
 #include <ql/types.hpp>
 #include <functional>
+#include <vector>
 
 namespace QuantLib {
 
@@ -43,6 +44,23 @@ namespace QuantLib {
         virtual ValueType operator()(const PathType& path) const=0;
     };
 
+    //! base class for block path pricers
+    /*! Returns the values of an option on each path of a block,
+        storing them in the given vector, which is resized as needed.
+        This allows pricers to work on all paths a time step at a
+        time; MonteCarloModel uses this interface when the path
+        pricers of a single-factor model also implement it.
+
+        \ingroup mcarlo
+    */
+    template<class BlockType, class ValueType=Real>
+    class BlockPathPricer {
+      public:
+        virtual ~BlockPathPricer() {}
+        virtual void operator()(const BlockType& paths,
+                                std::vector<ValueType>& values) const=0;
+    };
+
 }
 
 
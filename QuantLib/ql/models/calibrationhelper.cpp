@@ -48,6 +48,11 @@ namespace QuantLib {
         return solver.solve(f,accuracy,volatility_->value(),minVol,maxVol);
     }
 
+    Disposable<Array> CalibrationHelper::modelValueGradient() const {
+        Array gradient;
+        return gradient;
+    }
+
     Real CalibrationHelper::calibrationError() {
         double error;
         
@@ -82,4 +87,46 @@ namespace QuantLib {
         
         return error;
     }
+
+    Disposable<Array> CalibrationHelper::calibrationErrorGradient() {
+        Array gradient = modelValueGradient();
+        if (gradient.empty())
+            return gradient;
+
+        switch (calibrationErrorType_) {
+          case RelativePriceError:
+            {
+              const Real diff = marketValue() - modelValue();
+              gradient *= (diff >= 0.0 ? -1.0 : 1.0)/marketValue();
+            }
+            break;
+          case PriceError:
+            gradient *= -1.0;
+            break;
+          case ImpliedVolError:
+            {
+              const Real lowerPrice = blackPrice(0.001);
+              const Real upperPrice = blackPrice(10);
+              const Real modelPrice = modelValue();
+
+              if (modelPrice <= lowerPrice || modelPrice >= upperPrice) {
+                  // the implied volatility is floored or capped
+                  std::fill(gradient.begin(), gradient.end(), 0.0);
+              } else {
+                  // d(implied)/d(params) = d(price)/d(params)/vega
+                  const Volatility implied = this->impliedVolatility(
+                                          modelPrice, 1e-12, 5000, 0.001, 10);
+                  const Volatility h = 1.0e-4*implied;
+                  const Real vega =
+                      (blackPrice(implied+h) - blackPrice(implied-h))/(2*h);
+                  gradient /= vega;
+              }
+            }
+            break;
+          default:
+            QL_FAIL("unknown Calibration Error Type");
+        }
+
+        return gradient;
+    }
 }
@@ -28,6 +28,7 @@
 #include <ql/quote.hpp>
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/patterns/lazyobject.hpp>
+#include <ql/math/array.hpp>
 #include <list>
 
 namespace QuantLib {
@@ -59,9 +60,23 @@ namespace QuantLib {
         //! returns the price of the instrument according to the model
         virtual Real modelValue() const = 0;
 
+        //! returns the derivatives of the model price
+        /*! The derivatives are taken with respect to the parameters
+            of the model, in the order given by
+            CalibratedModel::params().  An empty array is returned if
+            they are not available, which is the default.
+        */
+        virtual Disposable<Array> modelValueGradient() const;
+
         //! returns the error resulting from the model valuation
         virtual Real calibrationError();
 
+        //! returns the derivatives of the calibration error
+        /*! They are obtained from modelValueGradient(); an empty
+            array is returned if the latter is not available.
+        */
+        virtual Disposable<Array> calibrationErrorGradient();
+
         virtual void addTimesTo(std::list<Time>& times) const = 0;
 
         //! Black volatility implied by the model
@@ -77,6 +92,9 @@ namespace QuantLib {
         void setPricingEngine(const boost::shared_ptr<PricingEngine>& engine) {
             engine_ = engine;
         }
+        const boost::shared_ptr<PricingEngine>& pricingEngine() const {
+            return engine_;
+        }
 
       protected:
         mutable Real marketValue_;
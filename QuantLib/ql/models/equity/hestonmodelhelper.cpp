@@ -20,6 +20,7 @@
 
 #include <ql/models/equity/hestonmodelhelper.hpp>
 #include <ql/pricingengines/blackformula.hpp>
+#include <ql/pricingengines/vanilla/analytichestonengine.hpp>
 #include <ql/processes/hestonprocess.hpp>
 #include <ql/instruments/payoffs.hpp>
 #include <ql/quotes/simplequote.hpp>
@@ -61,6 +62,14 @@ namespace QuantLib {
         return option_->NPV();
     }
 
+    Disposable<Array> HestonModelHelper::modelValueGradient() const {
+        boost::shared_ptr<AnalyticHestonEngine> engine =
+            boost::dynamic_pointer_cast<AnalyticHestonEngine>(engine_);
+        if (!engine)
+            return CalibrationHelper::modelValueGradient();
+        return engine->parameterGradient(*option_);
+    }
+
     Real HestonModelHelper::blackPrice(Real sigma) const {
         const Real volatility = sigma*std::sqrt(maturity());
         return blackFormula(Option::Call,
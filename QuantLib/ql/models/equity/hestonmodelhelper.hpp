@@ -45,6 +45,9 @@ namespace QuantLib {
 
         void addTimesTo(std::list<Time>&) const {}
         Real modelValue() const;
+        /*! analytic derivatives are available when the helper is
+            priced by an AnalyticHestonEngine. */
+        Disposable<Array> modelValueGradient() const;
         Real blackPrice(Real volatility) const;
         Time maturity() const  { return tau_; }
       private:
@@ -29,7 +29,7 @@ namespace QuantLib {
         if (covariance_.empty()) {
             covariance_.resize(numberOfSteps());
             for (Size j=0; j<numberOfSteps(); ++j)
-                covariance_[j] = pseudoRoot(j) * transpose(pseudoRoot(j));
+                covariance_[j] = symmetricProduct(pseudoRoot(j));
         }
         QL_REQUIRE(i<covariance_.size(),
                    "i (" << i <<
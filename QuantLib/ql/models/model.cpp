@@ -19,11 +19,23 @@
 
 #include <ql/models/model.hpp>
 #include <ql/math/optimization/problem.hpp>
+#include <string>
+
+#if defined(_OPENMP) && defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN) \
+                     && !defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+#define QL_PARALLEL_CALIBRATION
+#endif
 
 namespace QuantLib {
 
     namespace {
         void no_deletion(CalibratedModel*) {}
+
+        // first instrument of the given worker's chunk
+        Size chunkStart(Size worker, Size instruments, Size workers) {
+            return worker*(instruments/workers)
+                 + std::min(worker, instruments%workers);
+        }
     }
 
     CalibratedModel::CalibratedModel(Size nArguments)
@@ -37,15 +49,24 @@ namespace QuantLib {
                   CalibratedModel* model,
                   const std::vector<boost::shared_ptr<CalibrationHelper> >&
                                                                   instruments,
-                  const std::vector<Real>& weights)
+                  const std::vector<Real>& weights,
+                  Size workers = 1)
         : model_(model, no_deletion), instruments_(instruments),
-          weights_(weights) {}
+          weights_(weights), workers_(workers) {}
 
         virtual ~CalibrationFunction() {}
 
         virtual Real value(const Array& params) const {
             model_->setParams(params);
 
+            if (workers_ > 1) {
+                Array errors = calibrationErrors();
+                Real value = 0.0;
+                for (Size i=0; i<instruments_.size(); i++)
+                    value += errors[i]*errors[i]*weights_[i];
+                return std::sqrt(value);
+            }
+
             Real value = 0.0;
             for (Size i=0; i<instruments_.size(); i++) {
                 Real diff = instruments_[i]->calibrationError();
@@ -58,6 +79,13 @@ namespace QuantLib {
         virtual Disposable<Array> values(const Array& params) const {
             model_->setParams(params);
 
+            if (workers_ > 1) {
+                Array values = calibrationErrors();
+                for (Size i=0; i<instruments_.size(); i++)
+                    values[i] *= std::sqrt(weights_[i]);
+                return values;
+            }
+
             Array values(instruments_.size());
             for (Size i=0; i<instruments_.size(); i++) {
                 values[i] = instruments_[i]->calibrationError()
@@ -67,11 +95,107 @@ namespace QuantLib {
             return values;
         }
 
+        virtual void jacobian(Matrix& jac, const Array& params) const {
+            model_->setParams(params);
+
+            // analytic derivatives are used if all the instruments
+            // provide them; otherwise, we fall back to finite
+            // differences.
+            if (!calibrationErrorGradients(jac)) {
+                CostFunction::jacobian(jac, params);
+                return;
+            }
+            for (Size i=0; i<instruments_.size(); i++) {
+                const Real w = std::sqrt(weights_[i]);
+                for (Size j=0; j<jac.columns(); j++)
+                    jac[i][j] *= w;
+            }
+        }
+
+        virtual void gradient(Array& grad, const Array& params) const {
+            model_->setParams(params);
+
+            Matrix jac(instruments_.size(), params.size());
+            if (!calibrationErrorGradients(jac)) {
+                CostFunction::gradient(grad, params);
+                return;
+            }
+            const Array errors = calibrationErrors();
+
+            // the gradient of sqrt(sum_i w_i e_i^2)
+            Real value = 0.0;
+            for (Size i=0; i<errors.size(); i++)
+                value += errors[i]*errors[i]*weights_[i];
+            value = std::sqrt(value);
+            std::fill(grad.begin(), grad.end(), 0.0);
+            if (value == 0.0)
+                return;
+            for (Size i=0; i<errors.size(); i++)
+                for (Size j=0; j<grad.size(); j++)
+                    grad[j] += weights_[i]*errors[i]*jac[i][j]/value;
+        }
+
         virtual Real finiteDifferenceEpsilon() const { return 1e-6; }
       private:
+        Disposable<Array> calibrationErrors() const {
+            Array errors(instruments_.size());
+            evaluate(&errors, 0);
+            return errors;
+        }
+
+        bool calibrationErrorGradients(Matrix& jac) const {
+            return evaluate(0, &jac);
+        }
+
+        // each worker prices its own chunk of instruments and fills
+        // either the errors or the rows of the jacobian; errors are
+        // collected and rethrown on the calling thread.  Returns
+        // false if any instrument doesn't provide a gradient.
+        bool evaluate(Array* errors, Matrix* jac) const {
+            const Size n = instruments_.size();
+            std::vector<std::string> failures(workers_);
+            std::vector<int> missingGradients(workers_, 0);
+            const long nw = static_cast<long>(workers_);
+            #if defined(QL_PARALLEL_CALIBRATION)
+            #pragma omp parallel for schedule(static,1) num_threads(nw)
+            #endif
+            for (long w = 0; w < nw; ++w) {
+                const Size k = static_cast<Size>(w);
+                try {
+                    const Size first = chunkStart(k, n, workers_),
+                               last = chunkStart(k+1, n, workers_);
+                    for (Size i=first; i<last; ++i) {
+                        if (errors != 0) {
+                            (*errors)[i] =
+                                instruments_[i]->calibrationError();
+                        } else {
+                            const Array g =
+                                instruments_[i]->calibrationErrorGradient();
+                            if (g.size() != jac->columns()) {
+                                missingGradients[k] = 1;
+                                break;
+                            }
+                            std::copy(g.begin(), g.end(), jac->row_begin(i));
+                        }
+                    }
+                } catch (std::exception& e) {
+                    failures[k] = e.what();
+                } catch (...) {
+                    failures[k] = "unknown error";
+                }
+            }
+            for (Size k=0; k<workers_; ++k)
+                QL_REQUIRE(failures[k].empty(), failures[k]);
+            for (Size k=0; k<workers_; ++k)
+                if (missingGradients[k] != 0)
+                    return false;
+            return true;
+        }
+
         boost::shared_ptr<CalibratedModel> model_;
         const std::vector<boost::shared_ptr<CalibrationHelper> >& instruments_;
         std::vector<Real> weights_;
+        Size workers_;
     };
 
     void CalibratedModel::calibrate(
@@ -80,6 +204,57 @@ namespace QuantLib {
         const EndCriteria& endCriteria,
         const Constraint& additionalConstraint,
         const std::vector<Real>& weights) {
+        performCalibration(instruments, method, endCriteria,
+                           additionalConstraint, weights, 1);
+    }
+
+    void CalibratedModel::calibrate(
+        const std::vector<boost::shared_ptr<CalibrationHelper> >& instruments,
+        const std::vector<boost::shared_ptr<PricingEngine> >& workerEngines,
+        OptimizationMethod& method,
+        const EndCriteria& endCriteria,
+        const Constraint& additionalConstraint,
+        const std::vector<Real>& weights) {
+
+        QL_REQUIRE(!workerEngines.empty(), "no worker engines given");
+        const Size n = instruments.size();
+        const Size workers = std::max<Size>(
+                                 std::min(workerEngines.size(), n), 1);
+
+        // market values, and the term structures they depend on,
+        // are calculated here rather than concurrently by the workers
+        std::vector<boost::shared_ptr<PricingEngine> > engines(n);
+        for (Size i=0; i<n; ++i) {
+            instruments[i]->marketValue();
+            engines[i] = instruments[i]->pricingEngine();
+        }
+
+        for (Size k=0; k<workers; ++k) {
+            const Size first = chunkStart(k, n, workers),
+                       last = chunkStart(k+1, n, workers);
+            for (Size i=first; i<last; ++i)
+                instruments[i]->setPricingEngine(workerEngines[k]);
+        }
+
+        try {
+            performCalibration(instruments, method, endCriteria,
+                               additionalConstraint, weights, workers);
+        } catch (...) {
+            for (Size i=0; i<n; ++i)
+                instruments[i]->setPricingEngine(engines[i]);
+            throw;
+        }
+        for (Size i=0; i<n; ++i)
+            instruments[i]->setPricingEngine(engines[i]);
+    }
+
+    void CalibratedModel::performCalibration(
+        const std::vector<boost::shared_ptr<CalibrationHelper> >& instruments,
+        OptimizationMethod& method,
+        const EndCriteria& endCriteria,
+        const Constraint& additionalConstraint,
+        const std::vector<Real>& weights,
+        Size workers) {
 
         QL_REQUIRE(weights.empty() ||
                    weights.size() == instruments.size(),
@@ -93,7 +268,7 @@ namespace QuantLib {
         std::vector<Real> w = weights.empty() ?
                               std::vector<Real>(instruments.size(), 1.0):
                               weights;
-        CalibrationFunction f(this, instruments, w);
+        CalibrationFunction f(this, instruments, w, workers);
 
         Problem prob(f, c, params());
         shortRateEndCriteria_ = method.minimize(prob, endCriteria);
@@ -88,9 +88,46 @@ namespace QuantLib {
         //! Calibrate to a set of market instruments (caps/swaptions)
         /*! An additional constraint can be passed which must be
             satisfied in addition to the constraints of the model.
+
+            If all the instruments provide the derivatives of their
+            model values (see CalibrationHelper::modelValueGradient)
+            the cost function returns an analytic jacobian and
+            gradient; they're used by optimization methods that ask
+            for them, e.g., LevenbergMarquardt when created with
+            useCostFunctionsJacobian = true.
+        */
+        void calibrate(
+                   const std::vector<boost::shared_ptr<CalibrationHelper> >&,
+                   OptimizationMethod& method,
+                   const EndCriteria& endCriteria,
+                   const Constraint& constraint = Constraint(),
+                   const std::vector<Real>& weights = std::vector<Real>());
+
+        //! Calibrate pricing the instruments on several workers
+        /*! The instruments are split in contiguous chunks, one for
+            each of the given engines; during the calibration, the
+            instruments in each chunk are priced with the
+            corresponding engine, and their own engines are restored
+            at the end. The engines must be distinct instances
+            pricing with this model.
+
+            The chunks are priced on separate threads when QuantLib is
+            compiled with OpenMP support and the thread-safe observer
+            pattern, but without thread-local sessions; otherwise,
+            they're priced in sequence on the calling thread. In
+            either case, the model parameters are only modified by
+            the calling thread between evaluations, and the results
+            don't depend on the number of workers.
+
+            \warning the instruments in different chunks must not
+                     share any lazy object, e.g., term structures,
+                     that is not calculated before the calibration
+                     starts; market values are calculated beforehand.
         */
         void calibrate(
                    const std::vector<boost::shared_ptr<CalibrationHelper> >&,
+                   const std::vector<boost::shared_ptr<PricingEngine> >&
+                                                               workerEngines,
                    OptimizationMethod& method,
                    const EndCriteria& endCriteria,
                    const Constraint& constraint = Constraint(),
@@ -114,6 +151,13 @@ namespace QuantLib {
         EndCriteria::Type shortRateEndCriteria_;
 
       private:
+        void performCalibration(
+                   const std::vector<boost::shared_ptr<CalibrationHelper> >&,
+                   OptimizationMethod& method,
+                   const EndCriteria& endCriteria,
+                   const Constraint& constraint,
+                   const std::vector<Real>& weights,
+                   Size workers);
         //! Constraint imposed on arguments
         class PrivateConstraint;
         //! Calibration cost function class
@@ -28,8 +28,17 @@
 
 #include <ql/errors.hpp>
 #include <ql/types.hpp>
+#include <ql/patterns/singleton.hpp>
 
 #include <boost/shared_ptr.hpp>
+#include <algorithm>
+#include <iterator>
+#include <vector>
+#if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN) || \
+    defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+#include <boost/thread/mutex.hpp>
+#include <boost/atomic.hpp>
+#endif
 
 #include <set>
 
@@ -37,10 +46,83 @@ namespace QuantLib {
 
     class Observer;
 
+    namespace detail {
+
+        //! flat hash set of observers
+        /*! Observables can be watched by a large number of
+            observers (think of a discount curve used by a whole
+            portfolio) which register and unregister as instruments
+            are created and destroyed. This set stores them in a
+            single array using open addressing with linear probing;
+            elements are removed by shifting back the ones following
+            them, so that no tombstones are left.  The array grows
+            and shrinks with the number of elements.
+        */
+        class ObserverSet {
+          public:
+            class const_iterator {
+              public:
+                typedef std::forward_iterator_tag iterator_category;
+                typedef Observer* value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef Observer* const* pointer;
+                typedef Observer* const& reference;
+                const_iterator() : slot_(0), end_(0) {}
+                const_iterator(Observer* const* slot, Observer* const* end)
+                : slot_(slot), end_(end) { skip(); }
+                reference operator*() const { return *slot_; }
+                const_iterator& operator++() { ++slot_; skip(); return *this; }
+                bool operator==(const const_iterator& i) const {
+                    return slot_ == i.slot_;
+                }
+                bool operator!=(const const_iterator& i) const {
+                    return slot_ != i.slot_;
+                }
+              private:
+                void skip() { while (slot_ != end_ && *slot_ == 0) ++slot_; }
+                Observer* const* slot_;
+                Observer* const* end_;
+            };
+            ObserverSet() : size_(0) {}
+            Size size() const { return size_; }
+            bool empty() const { return size_ == 0; }
+            bool contains(Observer*) const;
+            const_iterator begin() const;
+            const_iterator end() const;
+            //! returns true if the observer was not already in the set
+            bool insert(Observer*);
+            //! returns the number of removed observers (0 or 1)
+            Size erase(Observer*);
+          private:
+            static Size hash(const Observer*);
+            void rehash(Size capacity);
+            std::vector<Observer*> slots_;
+            Size size_;
+        };
+
+    }
+
     //! Object that notifies its changes to a set of observers
-    /*! \ingroup patterns */
+    /*! When the library is compiled with the
+        QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN macro defined, the
+        set of observers is protected by a lock, so that observers
+        can register and unregister from any thread while
+        notifications are being sent from another.  Notifications
+        are sent to a copy of the set taken when they start;
+        observers that unregister in the meantime (e.g., because
+        they were destroyed by the update of another observer) are
+        skipped.  The copy is taken into a buffer kept by the
+        observable and reused across notifications.
+
+        \warning even in thread-safe mode, observers must not be
+                 destroyed while an observable they're registered
+                 with is notifying its changes.
+
+        \ingroup patterns
+    */
     class Observable {
         friend class Observer;
+        friend class ObservableSettings;
       public:
         // constructors, assignment, destructor
         Observable() {}
@@ -52,10 +134,108 @@ namespace QuantLib {
         */
         void notifyObservers();
       private:
-        typedef std::set<Observer*>::iterator iterator;
-        std::pair<iterator, bool> registerObserver(Observer*);
+        typedef detail::ObserverSet set_type;
+        typedef set_type::const_iterator iterator;
+        bool registerObserver(Observer*);
         Size unregisterObserver(Observer*);
-        std::set<Observer*> observers_;
+        void notify(const std::vector<Observer*>& observers);
+        set_type observers_;
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+        mutable boost::mutex mutex_;
+        #endif
+        std::vector<Observer*> buffer_;
+    };
+
+    //! global settings for the observer pattern
+    /*! Notifications can be disabled, e.g., while a number of
+        quotes are being set.  If they are deferred rather than
+        discarded, the observers that would have been notified are
+        collected and each of them is notified once when updates
+        are enabled again:
+        \code
+        ObservableSettings::instance().disableUpdates(true);
+        for (Size i=0; i<quotes.size(); ++i)
+            quotes[i]->setValue(values[i]);
+        ObservableSettings::instance().enableUpdates();
+        \endcode
+        Only the direct observers of the changed observables are
+        collected; further notifications cascading from their
+        update() methods are sent as usual when updates are enabled.
+
+        As long as no instance has updates disabled, observables
+        notify their changes and observers are destroyed without
+        looking up the instance.
+
+        With thread-local sessions, each thread has its own instance
+        and collects the observers notified on that thread.  An
+        observer might be destroyed on a different thread, so it is
+        then removed from the observers collected by all instances,
+        which are kept until the end of the program.
+
+        \test deferred notifications are checked to reach each
+              observer once.
+
+        \ingroup patterns
+    */
+    class ObservableSettings : public Singleton<ObservableSettings> {
+        friend class Singleton<ObservableSettings>;
+        friend class Observable;
+        friend class Observer;
+      public:
+        /*! disables notifications. If \c deferred is true, the
+            observers to be notified are collected for later;
+            otherwise, notifications are discarded.
+        */
+        void disableUpdates(bool deferred = false);
+        /*! enables notifications and sends any deferred ones. */
+        void enableUpdates();
+        bool updatesEnabled() const { return updatesEnabled_; }
+        bool updatesDeferred() const { return updatesDeferred_; }
+      private:
+        ObservableSettings()
+        : updatesEnabled_(true), updatesDeferred_(false), counted_(false) {
+            #if defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+            boost::mutex::scoped_lock lock(instancesMutex());
+            instances().push_back(this);
+            #endif
+        }
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN) || \
+            defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+        typedef boost::atomic<bool> flag_type;
+        typedef boost::atomic<Size> counter_type;
+        #else
+        typedef bool flag_type;
+        typedef Size counter_type;
+        #endif
+        /* number of instances with updates disabled or with deferred
+           notifications still being sent; while it is null, no
+           instance needs to be looked up. */
+        static counter_type& disabledInstances() {
+            static counter_type n(0);
+            return n;
+        }
+        #if defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+        // the instances created by all threads
+        static std::vector<ObservableSettings*>& instances() {
+            static std::vector<ObservableSettings*> v;
+            return v;
+        }
+        static boost::mutex& instancesMutex() {
+            static boost::mutex m;
+            return m;
+        }
+        #endif
+        void registerDeferredObservers(const Observable::set_type&);
+        void unregisterDeferredObserver(Observer*);
+        std::set<Observer*> deferredObservers_;
+        flag_type updatesEnabled_, updatesDeferred_;
+        bool counted_;
+        // with thread-local sessions, the collected observers can
+        // be removed by other threads
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN) || \
+            defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+        boost::mutex mutex_;
+        #endif
     };
 
     //! Object that gets notified when a given observable changes
@@ -67,8 +247,18 @@ namespace QuantLib {
         Observer(const Observer&);
         Observer& operator=(const Observer&);
         virtual ~Observer();
+        /*! \deprecated the observables are no longer kept in a
+                        set; use container_type instead.
+        */
+        typedef std::set<boost::shared_ptr<Observable> > set_type;
+        /*! the observables are kept in a vector sorted by address,
+            which is smaller and faster than a tree for the handful
+            of observables most observers register with.
+        */
+        typedef std::vector<boost::shared_ptr<Observable> > container_type;
+        typedef container_type::iterator iterator;
         // observer interface
-        std::pair<std::set<boost::shared_ptr<Observable> >::iterator, bool>
+        std::pair<iterator, bool>
                             registerWith(const boost::shared_ptr<Observable>&);
         Size unregisterWith(const boost::shared_ptr<Observable>&);
         /*! This method must be implemented in derived classes. An
@@ -79,8 +269,8 @@ namespace QuantLib {
         void unregisterWithAll();
         virtual void update() = 0;
       private:
-        std::set<boost::shared_ptr<Observable> > observables_;
-        typedef std::set<boost::shared_ptr<Observable> >::iterator iterator;
+        iterator find(const boost::shared_ptr<Observable>&);
+        container_type observables_;
     };
 
 
@@ -107,21 +297,172 @@ namespace QuantLib {
         return *this;
     }
 
-    inline std::pair<std::set<Observer*>::iterator, bool>
-    Observable::registerObserver(Observer* o) {
+    namespace detail {
+
+        inline ObserverSet::const_iterator ObserverSet::begin() const {
+            if (slots_.empty())
+                return const_iterator();
+            return const_iterator(&slots_[0], &slots_[0]+slots_.size());
+        }
+
+        inline ObserverSet::const_iterator ObserverSet::end() const {
+            if (slots_.empty())
+                return const_iterator();
+            Observer* const* end = &slots_[0]+slots_.size();
+            return const_iterator(end, end);
+        }
+
+        inline bool ObserverSet::contains(Observer* o) const {
+            if (size_ == 0)
+                return false;
+            Size mask = slots_.size()-1;
+            for (Size i = hash(o) & mask; slots_[i] != 0; i = (i+1) & mask) {
+                if (slots_[i] == o)
+                    return true;
+            }
+            return false;
+        }
+
+        inline Size ObserverSet::hash(const Observer* o) {
+            // the lower bits of addresses are mostly zero
+            std::size_t h = reinterpret_cast<std::size_t>(o) >> 3;
+            h ^= h >> 15;
+            h *= 2246822519U;
+            h ^= h >> 13;
+            return h;
+        }
+
+        inline bool ObserverSet::insert(Observer* o) {
+            // keep the load factor below 1/2
+            if (2*(size_+1) > slots_.size())
+                rehash(std::max<Size>(4, 2*slots_.size()));
+            Size mask = slots_.size()-1;
+            for (Size i = hash(o) & mask; ; i = (i+1) & mask) {
+                if (slots_[i] == o)
+                    return false;
+                if (slots_[i] == 0) {
+                    slots_[i] = o;
+                    ++size_;
+                    return true;
+                }
+            }
+        }
+
+        inline Size ObserverSet::erase(Observer* o) {
+            if (size_ == 0)
+                return 0;
+            Size mask = slots_.size()-1;
+            Size i = hash(o) & mask;
+            while (slots_[i] != o) {
+                if (slots_[i] == 0)
+                    return 0;
+                i = (i+1) & mask;
+            }
+            // shift back the following elements that would have been
+            // placed at or before the freed slot
+            for (Size j = (i+1) & mask; slots_[j] != 0; j = (j+1) & mask) {
+                Size k = hash(slots_[j]) & mask;
+                bool inPlace = (i <= j) ? (i < k && k <= j)
+                                        : (i < k || k <= j);
+                if (!inPlace) {
+                    slots_[i] = slots_[j];
+                    i = j;
+                }
+            }
+            slots_[i] = 0;
+            --size_;
+            // release memory as the set empties
+            if (size_ == 0)
+                std::vector<Observer*>().swap(slots_);
+            else if (slots_.size() > 4 && 8*size_ < slots_.size())
+                rehash(slots_.size()/2);
+            return 1;
+        }
+
+        inline void ObserverSet::rehash(Size capacity) {
+            std::vector<Observer*> slots(capacity, (Observer*)(0));
+            slots_.swap(slots);
+            Size mask = capacity-1;
+            for (Size j=0; j<slots.size(); ++j) {
+                if (slots[j] != 0) {
+                    Size i = hash(slots[j]) & mask;
+                    while (slots_[i] != 0)
+                        i = (i+1) & mask;
+                    slots_[i] = slots[j];
+                }
+            }
+        }
+
+    }
+
+
+    inline bool Observable::registerObserver(Observer* o) {
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+        boost::mutex::scoped_lock lock(mutex_);
+        #endif
         return observers_.insert(o);
     }
 
     inline Size Observable::unregisterObserver(Observer* o) {
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+        boost::mutex::scoped_lock lock(mutex_);
+        #endif
         return observers_.erase(o);
     }
 
     inline void Observable::notifyObservers() {
+        if (ObservableSettings::disabledInstances() != 0) {
+            ObservableSettings& settings = ObservableSettings::instance();
+            if (!settings.updatesEnabled()) {
+                // if updates are only deferred, flag this for later
+                if (settings.updatesDeferred()) {
+                    #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+                    boost::mutex::scoped_lock lock(mutex_);
+                    #endif
+                    settings.registerDeferredObservers(observers_);
+                }
+                return;
+            }
+        }
+
+        // observers might register or unregister while being
+        // notified, so we iterate over a copy of the set
+        // kept in the storage used by previous notifications.  A
+        // notification sent while another one is using the buffer
+        // (e.g., from the update() of an observer) finds it empty
+        // and allocates its own.
+        std::vector<Observer*> observers;
+        {
+            #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+            boost::mutex::scoped_lock lock(mutex_);
+            #endif
+            observers.swap(buffer_);
+            observers.assign(observers_.begin(), observers_.end());
+        }
+        notify(observers);
+        observers.clear();
+        {
+            #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+            boost::mutex::scoped_lock lock(mutex_);
+            #endif
+            buffer_.swap(observers);
+        }
+    }
+
+    inline void Observable::notify(const std::vector<Observer*>& observers) {
         bool successful = true;
         std::string errMsg;
-        for (iterator i=observers_.begin(); i!=observers_.end(); ++i) {
+        for (Size i=0; i<observers.size(); ++i) {
+            {
+                // skip the observers unregistered by previous updates
+                #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+                boost::mutex::scoped_lock lock(mutex_);
+                #endif
+                if (!observers_.contains(observers[i]))
+                    continue;
+            }
             try {
-                (*i)->update();
+                observers[i]->update();
             } catch (std::exception& e) {
                 // quite a dilemma. If we don't catch the exception,
                 // other observers will not receive the notification
@@ -141,6 +482,89 @@ namespace QuantLib {
     }
 
 
+    inline void ObservableSettings::disableUpdates(bool deferred) {
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN) || \
+            defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+        boost::mutex::scoped_lock lock(mutex_);
+        #endif
+        // the instance stays counted until its deferred
+        // notifications are sent
+        if (!counted_) {
+            counted_ = true;
+            ++disabledInstances();
+        }
+        updatesEnabled_ = false;
+        updatesDeferred_ = deferred;
+    }
+
+    inline void ObservableSettings::enableUpdates() {
+        {
+            #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN) || \
+                defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+            boost::mutex::scoped_lock lock(mutex_);
+            #endif
+            if (updatesEnabled_)
+                return;
+            updatesEnabled_ = true;
+            updatesDeferred_ = false;
+        }
+
+        // observers are removed one at a time, so that those
+        // destroyed by other observers' updates are skipped
+        bool successful = true;
+        std::string errMsg;
+        for (;;) {
+            Observer* o;
+            {
+                #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN) || \
+                    defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+                boost::mutex::scoped_lock lock(mutex_);
+                #endif
+                if (deferredObservers_.empty()) {
+                    // unless updates were disabled again by one of
+                    // the observers
+                    if (updatesEnabled_ && counted_) {
+                        counted_ = false;
+                        --disabledInstances();
+                    }
+                    break;
+                }
+                o = *deferredObservers_.begin();
+                deferredObservers_.erase(deferredObservers_.begin());
+            }
+            try {
+                o->update();
+            } catch (std::exception& e) {
+                successful = false;
+                errMsg = e.what();
+            } catch (...) {
+                successful = false;
+            }
+        }
+        QL_ENSURE(successful,
+                  "could not notify one or more observers: " << errMsg);
+    }
+
+    inline void ObservableSettings::registerDeferredObservers(
+                                    const Observable::set_type& observers) {
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN) || \
+            defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+        boost::mutex::scoped_lock lock(mutex_);
+        #endif
+        for (Observable::iterator i=observers.begin();
+             i!=observers.end(); ++i)
+            deferredObservers_.insert(*i);
+    }
+
+    inline void ObservableSettings::unregisterDeferredObserver(Observer* o) {
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN) || \
+            defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+        boost::mutex::scoped_lock lock(mutex_);
+        #endif
+        deferredObservers_.erase(o);
+    }
+
+
     inline Observer::Observer(const Observer& o)
     : observables_(o.observables_) {
         for (iterator i=observables_.begin(); i!=observables_.end(); ++i)
@@ -160,13 +584,55 @@ namespace QuantLib {
     inline Observer::~Observer() {
         for (iterator i=observables_.begin(); i!=observables_.end(); ++i)
             (*i)->unregisterObserver(this);
+        // deferred notifications can only be pending while some
+        // instance has updates disabled or is still sending them
+        if (ObservableSettings::disabledInstances() != 0) {
+            #if defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+            // the observer might have been collected by the instance
+            // of another thread
+            std::vector<ObservableSettings*> instances;
+            {
+                boost::mutex::scoped_lock lock(
+                                    ObservableSettings::instancesMutex());
+                instances = ObservableSettings::instances();
+            }
+            for (Size i=0; i<instances.size(); ++i)
+                instances[i]->unregisterDeferredObserver(this);
+            #else
+            ObservableSettings::instance().unregisterDeferredObserver(this);
+            #endif
+        }
+    }
+
+    namespace detail {
+
+        inline bool lessByAddress(const boost::shared_ptr<Observable>& h1,
+                                  const boost::shared_ptr<Observable>& h2) {
+            return h1.get() < h2.get();
+        }
+
+    }
+
+    inline Observer::iterator
+    Observer::find(const boost::shared_ptr<Observable>& h) {
+        iterator i = std::lower_bound(observables_.begin(),
+                                      observables_.end(), h,
+                                      detail::lessByAddress);
+        if (i != observables_.end() && i->get() == h.get())
+            return i;
+        return observables_.end();
     }
 
-    inline std::pair<std::set<boost::shared_ptr<Observable> >::iterator, bool>
+    inline std::pair<Observer::iterator, bool>
     Observer::registerWith(const boost::shared_ptr<Observable>& h) {
         if (h) {
             h->registerObserver(this);
-            return observables_.insert(h);
+            iterator i = std::lower_bound(observables_.begin(),
+                                          observables_.end(), h,
+                                          detail::lessByAddress);
+            if (i != observables_.end() && i->get() == h.get())
+                return std::make_pair(i, false);
+            return std::make_pair(observables_.insert(i, h), true);
         }
         return std::make_pair(observables_.end(), false);
     }
@@ -175,7 +641,11 @@ namespace QuantLib {
     Size Observer::unregisterWith(const boost::shared_ptr<Observable>& h) {
         if (h)
             h->unregisterObserver(this);
-        return observables_.erase(h);
+        iterator i = find(h);
+        if (i == observables_.end())
+            return 0;
+        observables_.erase(i);
+        return 1;
     }
 
     inline void Observer::unregisterWithAll() {
@@ -29,6 +29,19 @@
 #include <boost/noncopyable.hpp>
 #include <map>
 
+#if defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+    #if defined(QL_ENABLE_SESSIONS)
+        #error sessions and thread-local sessions cannot be both enabled
+    #endif
+    #if defined(BOOST_MSVC)
+        #define QL_THREAD_LOCAL __declspec(thread)
+    #else
+        #define QL_THREAD_LOCAL __thread
+    #endif
+    #include <boost/thread/mutex.hpp>
+    #include <vector>
+#endif
+
 namespace QuantLib {
 
     #if defined(QL_ENABLE_SESSIONS)
@@ -60,6 +73,24 @@ namespace QuantLib {
         as a single implemementation point should synchronization
         features be added.
 
+        When QuantLib is compiled with the
+        QL_ENABLE_THREAD_LOCAL_SESSIONS macro defined, each thread
+        gets its own instance, which is found through a thread-local
+        pointer without locking.  This allows different threads to
+        work with different settings (e.g., evaluation dates) at the
+        same time.
+
+        \warning In thread-local mode, a new thread starts with
+                 default-constructed instances rather than with copies
+                 of the ones used by the thread that created it.
+                 Objects should be used in the thread in which they
+                 were created, since they register with the instances
+                 of that thread.  Instances are kept until the end of
+                 the program, so threads should be pooled rather than
+                 created for each task.  The seed generators of
+                 different threads are initialized differently, so
+                 that they return different seeds.
+
         \ingroup patterns
     */
     template <class T>
@@ -69,12 +100,22 @@ namespace QuantLib {
         static T& instance();
       protected:
         Singleton() {}
+      #if defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+      private:
+        static T* createInstance();
+      #endif
     };
 
     // template definitions
 
     template <class T>
     T& Singleton<T>::instance() {
+        #if defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+        static QL_THREAD_LOCAL T* instance_ = 0;
+        if (!instance_)
+            instance_ = createInstance();
+        return *instance_;
+        #else
         static std::map<Integer, boost::shared_ptr<T> > instances_;
         #if defined(QL_ENABLE_SESSIONS)
         Integer id = sessionId();
@@ -85,7 +126,22 @@ namespace QuantLib {
         if (!instance)
             instance = boost::shared_ptr<T>(new T);
         return *instance;
+        #endif
+    }
+
+    #if defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+    template <class T>
+    T* Singleton<T>::createInstance() {
+        // called once per thread; the instances are owned here so
+        // that they are destroyed at the end of the program.
+        static boost::mutex mutex;
+        static std::vector<boost::shared_ptr<T> > instances;
+        boost::shared_ptr<T> instance(new T);
+        boost::mutex::scoped_lock lock(mutex);
+        instances.push_back(instance);
+        return instance.get();
     }
+    #endif
 
     // reverts the change above
     #if defined(QL_PATCH_MSVC71)
@@ -51,4 +51,33 @@ namespace QuantLib {
         return discount_ * payoff_(averagePrice);
     }
 
+    void ArithmeticAPOPathPricer::operator()(
+                                        const PathBlock& paths,
+                                        std::vector<Real>& values) const {
+        Size n = paths.length();
+        QL_REQUIRE(n>1, "the paths cannot be empty");
+
+        // sum the fixings of all paths a time step at a time
+        Size first, fixings;
+        if (paths.timeGrid().mandatoryTimes()[0]==0.0) {
+            // include initial fixing
+            first = 0;
+            fixings = pastFixings_ + n;
+        } else {
+            first = 1;
+            fixings = pastFixings_ + n - 1;
+        }
+        values.assign(paths.size(), runningSum_);
+        for (Size i=first; i<n; ++i) {
+            Matrix::const_row_iterator fixing = paths.begin(i);
+            for (Size j=0; j<values.size(); ++j)
+                values[j] += fixing[j];
+        }
+
+        for (Size j=0; j<values.size(); ++j) {
+            Real averagePrice = values[j]/fixings;
+            values[j] = discount_ * payoff_(averagePrice);
+        }
+    }
+
 }
@@ -27,6 +27,7 @@
 #define quantlib_mcdiscreteasian_engine_hpp
 
 #include <ql/pricingengines/mcsimulation.hpp>
+#include <ql/math/randomnumbers/seedgenerator.hpp>
 #include <ql/instruments/asianoption.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 
@@ -58,7 +59,8 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed);
+             BigNatural seed,
+             Size nThreads = 1);
         void calculate() const {
             McSimulation<SingleVariate,RNG,S>::calculate(requiredTolerance_,
                                                          requiredSamples_,
@@ -79,10 +81,26 @@ namespace QuantLib {
         // McSimulation implementation
         TimeGrid timeGrid() const;
         boost::shared_ptr<path_generator_type> pathGenerator() const {
+            return pathGenerator(seed_, 0, 1);
+        }
+        std::vector<boost::shared_ptr<path_generator_type> >
+        workerPathGenerators(Size workers) const {
+            // all workers must use the same seed
+            BigNatural seed =
+                seed_ != 0 ? seed_ : SeedGenerator::instance().get();
+            std::vector<boost::shared_ptr<path_generator_type> > generators;
+            for (Size i=0; i<workers; ++i)
+                generators.push_back(pathGenerator(seed, i, workers));
+            return generators;
+        }
+        boost::shared_ptr<path_generator_type>
+        pathGenerator(BigNatural seed, Size stream, Size streams) const {
 
             TimeGrid grid = this->timeGrid();
-            typename RNG::rsg_type gen =
-                RNG::make_sequence_generator(grid.size()-1,seed_);
+            typename RNG::rsg_type gen = (streams == 1) ?
+                RNG::make_sequence_generator(grid.size()-1, seed) :
+                detail::substreamGenerator<RNG>(grid.size()-1, seed,
+                                                stream, streams);
             return boost::shared_ptr<path_generator_type>(
                          new path_generator_type(process_, grid,
                                                  gen, brownianBridge_));
@@ -109,8 +127,10 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed)
-    : McSimulation<SingleVariate,RNG,S>(antitheticVariate, controlVariate),
+             BigNatural seed,
+             Size nThreads)
+    : McSimulation<SingleVariate,RNG,S>(antitheticVariate, controlVariate,
+                                        nThreads),
       process_(process), requiredSamples_(requiredSamples),
       maxSamples_(maxSamples), requiredTolerance_(requiredTolerance),
       brownianBridge_(brownianBridge), seed_(seed) {
@@ -57,7 +57,8 @@ namespace QuantLib {
                                Real requiredTolerance,
                                Size maxSamples,
                                BigNatural seed,
-                               Size nCalibrationSamples = Null<Size>());
+                               Size nCalibrationSamples = Null<Size>(),
+                               bool streamingCalibration = false);
       protected:
         boost::shared_ptr<LongstaffSchwartzPathPricer<MultiPath> >
             lsmPathPricer() const;
@@ -80,6 +81,7 @@ namespace QuantLib {
         MakeMCAmericanBasketEngine& withMaxSamples(Size samples);
         MakeMCAmericanBasketEngine& withSeed(BigNatural seed);
         MakeMCAmericanBasketEngine& withCalibrationSamples(Size samples);
+        MakeMCAmericanBasketEngine& withStreamingCalibration(bool b = true);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
       private:
@@ -88,6 +90,7 @@ namespace QuantLib {
         Size steps_, stepsPerYear_, samples_, maxSamples_, calibrationSamples_;
         Real tolerance_;
         BigNatural seed_;
+        bool streamingCalibration_;
     };
 
 
@@ -126,7 +129,8 @@ namespace QuantLib {
                    Real requiredTolerance,
                    Size maxSamples,
                    BigNatural seed,
-                   Size nCalibrationSamples)
+                   Size nCalibrationSamples,
+                   bool streamingCalibration)
         : MCLongstaffSchwartzEngine<BasketOption::engine,
                                     MultiVariate,RNG>(processes,
                                                       timeSteps,
@@ -138,7 +142,9 @@ namespace QuantLib {
                                                       requiredTolerance,
                                                       maxSamples,
                                                       seed,
-                                                      nCalibrationSamples) {}
+                                                      nCalibrationSamples,
+                                                      1,
+                                                      streamingCalibration) {}
 
     template <class RNG>
     inline boost::shared_ptr<LongstaffSchwartzPathPricer<MultiPath> >
@@ -181,7 +187,7 @@ namespace QuantLib {
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
       calibrationSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), seed_(0) {}
+      tolerance_(Null<Real>()), seed_(0), streamingCalibration_(false) {}
 
     template <class RNG>
     inline MakeMCAmericanBasketEngine<RNG>&
@@ -253,6 +259,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG>
+    inline MakeMCAmericanBasketEngine<RNG>&
+    MakeMCAmericanBasketEngine<RNG>::withStreamingCalibration(bool b) {
+        streamingCalibration_ = b;
+        return *this;
+    }
+
     template <class RNG>
     inline
     MakeMCAmericanBasketEngine<RNG>::operator
@@ -271,7 +284,8 @@ namespace QuantLib {
                                         tolerance_,
                                         maxSamples_,
                                         seed_,
-                                        calibrationSamples_));
+                                        calibrationSamples_,
+                                        streamingCalibration_));
     }
 
 }
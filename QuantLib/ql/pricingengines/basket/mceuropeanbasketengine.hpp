@@ -27,6 +27,7 @@
 
 #include <ql/instruments/basketoption.hpp>
 #include <ql/pricingengines/mcsimulation.hpp>
+#include <ql/math/randomnumbers/seedgenerator.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/processes/stochasticprocessarray.hpp>
 #include <ql/exercise.hpp>
@@ -58,7 +59,8 @@ namespace QuantLib {
                                Size requiredSamples,
                                Real requiredTolerance,
                                Size maxSamples,
-                               BigNatural seed);
+                               BigNatural seed,
+                               Size nThreads = 1);
         void calculate() const {
             McSimulation<MultiVariate,RNG,S>::calculate(requiredTolerance_,
                                                         requiredSamples_,
@@ -72,6 +74,20 @@ namespace QuantLib {
         // McSimulation implementation
         TimeGrid timeGrid() const;
         boost::shared_ptr<path_generator_type> pathGenerator() const {
+            return pathGenerator(seed_, 0, 1);
+        }
+        std::vector<boost::shared_ptr<path_generator_type> >
+        workerPathGenerators(Size workers) const {
+            // all workers must use the same seed
+            BigNatural seed =
+                seed_ != 0 ? seed_ : SeedGenerator::instance().get();
+            std::vector<boost::shared_ptr<path_generator_type> > generators;
+            for (Size i=0; i<workers; ++i)
+                generators.push_back(pathGenerator(seed, i, workers));
+            return generators;
+        }
+        boost::shared_ptr<path_generator_type>
+        pathGenerator(BigNatural seed, Size stream, Size streams) const {
 
             boost::shared_ptr<BasketPayoff> payoff =
                 boost::dynamic_pointer_cast<BasketPayoff>(
@@ -81,8 +97,11 @@ namespace QuantLib {
             Size numAssets = processes_->size();
 
             TimeGrid grid = timeGrid();
-            typename RNG::rsg_type gen =
-                RNG::make_sequence_generator(numAssets*(grid.size()-1),seed_);
+            Size dimension = numAssets*(grid.size()-1);
+            typename RNG::rsg_type gen = (streams == 1) ?
+                RNG::make_sequence_generator(dimension, seed) :
+                detail::substreamGenerator<RNG>(dimension, seed,
+                                                stream, streams);
 
             return boost::shared_ptr<path_generator_type>(
                          new path_generator_type(processes_,
@@ -115,6 +134,7 @@ namespace QuantLib {
         MakeMCEuropeanBasketEngine& withAbsoluteTolerance(Real tolerance);
         MakeMCEuropeanBasketEngine& withMaxSamples(Size samples);
         MakeMCEuropeanBasketEngine& withSeed(BigNatural seed);
+        MakeMCEuropeanBasketEngine& withThreads(Size n);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
       private:
@@ -123,6 +143,7 @@ namespace QuantLib {
         Size steps_, stepsPerYear_, samples_, maxSamples_;
         Real tolerance_;
         BigNatural seed_;
+        Size nThreads_;
     };
 
 
@@ -149,8 +170,9 @@ namespace QuantLib {
                    Size requiredSamples,
                    Real requiredTolerance,
                    Size maxSamples,
-                   BigNatural seed)
-    : McSimulation<MultiVariate,RNG,S>(antitheticVariate, false),
+                   BigNatural seed,
+                   Size nThreads)
+    : McSimulation<MultiVariate,RNG,S>(antitheticVariate, false, nThreads),
       processes_(processes), timeSteps_(timeSteps),
       timeStepsPerYear_(timeStepsPerYear),
       requiredSamples_(requiredSamples), maxSamples_(maxSamples),
@@ -214,7 +236,7 @@ namespace QuantLib {
     : process_(process), brownianBridge_(false), antithetic_(false),
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), seed_(0) {}
+      tolerance_(Null<Real>()), seed_(0), nThreads_(1) {}
 
     template <class RNG, class S>
     inline MakeMCEuropeanBasketEngine<RNG,S>&
@@ -279,6 +301,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCEuropeanBasketEngine<RNG,S>&
+    MakeMCEuropeanBasketEngine<RNG,S>::withThreads(Size n) {
+        nThreads_ = n;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCEuropeanBasketEngine<RNG,S>::operator
@@ -295,7 +324,8 @@ namespace QuantLib {
                                           antithetic_,
                                           samples_, tolerance_,
                                           maxSamples_,
-                                          seed_));
+                                          seed_,
+                                          nThreads_));
     }
 
 }
@@ -26,6 +26,7 @@
 #define quantlib_mc_longstaff_schwartz_engine_hpp
 
 #include <ql/pricingengines/mcsimulation.hpp>
+#include <ql/math/randomnumbers/seedgenerator.hpp>
 #include <ql/methods/montecarlo/longstaffschwartzpathpricer.hpp>
 
 namespace QuantLib {
@@ -37,6 +38,19 @@ namespace QuantLib {
         by Simulation: A Simple Least-Squares Approach, The Review of
         Financial Studies, Volume 14, No. 1, 113-147
 
+        The calibration samples are always drawn on the calling
+        thread; when more than one thread is requested, the pricing
+        samples are split among workers sharing the calibrated path
+        pricer.
+
+        If streaming calibration is requested, the calibration paths
+        are not stored; instead, they are generated again from the
+        same seed for each exercise date (see
+        LongstaffSchwartzPathPricer) so that memory use doesn't grow
+        with the number of calibration samples, at the price of a
+        larger number of generated paths.  When no seed is given,
+        one is drawn once per calculation and used for all passes.
+
         \test the correctness of the returned value is tested by
               reproducing results available in web/literature
     */
@@ -64,7 +78,9 @@ namespace QuantLib {
             Real requiredTolerance,
             Size maxSamples,
             BigNatural seed,
-            Size nCalibrationSamples = Null<Size>());
+            Size nCalibrationSamples = Null<Size>(),
+            Size nThreads = 1,
+            bool streamingCalibration = false);
 
         void calculate() const;
 
@@ -75,6 +91,10 @@ namespace QuantLib {
         TimeGrid timeGrid() const;
         boost::shared_ptr<path_pricer_type> pathPricer() const;
         boost::shared_ptr<path_generator_type> pathGenerator() const;
+        std::vector<boost::shared_ptr<path_generator_type> >
+        workerPathGenerators(Size workers) const;
+        boost::shared_ptr<path_generator_type>
+        pathGenerator(BigNatural seed, Size stream, Size streams) const;
 
         boost::shared_ptr<StochasticProcess> process_;
         const Size timeSteps_;
@@ -85,6 +105,7 @@ namespace QuantLib {
         const Size maxSamples_;
         const Size seed_;
         const Size nCalibrationSamples_;
+        const bool streamingCalibration_;
 
         mutable boost::shared_ptr<LongstaffSchwartzPathPricer<path_type> >
             pathPricer_;
@@ -104,8 +125,10 @@ namespace QuantLib {
             Real requiredTolerance,
             Size maxSamples,
             BigNatural seed,
-            Size nCalibrationSamples)
-    : McSimulation<MC,RNG,S> (antitheticVariate, controlVariate),
+            Size nCalibrationSamples,
+            Size nThreads,
+            bool streamingCalibration)
+    : McSimulation<MC,RNG,S> (antitheticVariate, controlVariate, nThreads),
       process_            (process),
       timeSteps_          (timeSteps),
       timeStepsPerYear_   (timeStepsPerYear),
@@ -115,7 +138,8 @@ namespace QuantLib {
       maxSamples_         (maxSamples),
       seed_               (seed),
       nCalibrationSamples_( (nCalibrationSamples == Null<Size>())
-                            ? 2048 : nCalibrationSamples) {
+                            ? 2048 : nCalibrationSamples),
+      streamingCalibration_(streamingCalibration) {
         QL_REQUIRE(timeSteps != Null<Size>() ||
                    timeStepsPerYear != Null<Size>(),
                    "no time steps provided");
@@ -147,12 +171,21 @@ namespace QuantLib {
     inline
     void MCLongstaffSchwartzEngine<GenericEngine,MC,RNG,S>::calculate() const {
         pathPricer_ = this->lsmPathPricer();
-        this->mcModel_ = boost::shared_ptr<MonteCarloModel<MC,RNG,S> >(
-                          new MonteCarloModel<MC,RNG,S>
-                              (pathGenerator(), pathPricer_,
-                               stats_type(), this->antitheticVariate_));
+        if (streamingCalibration_)
+            pathPricer_->startStreamingCalibration();
 
-        this->mcModel_->addSamples(nCalibrationSamples_);
+        // in streaming mode, each pass replays the same paths; a
+        // null seed would give a new one to each pass, so that one is
+        // drawn here for all of them
+        BigNatural seed =
+            seed_ != 0 ? seed_ : SeedGenerator::instance().get();
+        do {
+            this->mcModel_ = boost::shared_ptr<MonteCarloModel<MC,RNG,S> >(
+                              new MonteCarloModel<MC,RNG,S>
+                                  (pathGenerator(seed, 0, 1), pathPricer_,
+                                   stats_type(), this->antitheticVariate_));
+            this->mcModel_->addSamples(nCalibrationSamples_);
+        } while (pathPricer_->nextCalibrationPass());
         this->pathPricer_->calibrate();
 
         McSimulation<MC,RNG,S>::calculate(requiredTolerance_,
@@ -188,11 +221,42 @@ namespace QuantLib {
     boost::shared_ptr<typename
     MCLongstaffSchwartzEngine<GenericEngine,MC,RNG,S>::path_generator_type>
     MCLongstaffSchwartzEngine<GenericEngine,MC,RNG,S>::pathGenerator() const {
+        return pathGenerator(seed_, 0, 1);
+    }
+
+    template <class GenericEngine, template <class> class MC,
+              class RNG, class S>
+    inline
+    std::vector<boost::shared_ptr<typename
+    MCLongstaffSchwartzEngine<GenericEngine,MC,RNG,S>::path_generator_type> >
+    MCLongstaffSchwartzEngine<GenericEngine,MC,RNG,S>::workerPathGenerators(
+                                                         Size workers) const {
+        // all workers must use the same seed
+        BigNatural seed =
+            seed_ != 0 ? seed_ : SeedGenerator::instance().get();
+        std::vector<boost::shared_ptr<path_generator_type> > generators;
+        for (Size i=0; i<workers; ++i)
+            generators.push_back(pathGenerator(seed, i, workers));
+        return generators;
+    }
+
+    template <class GenericEngine, template <class> class MC,
+              class RNG, class S>
+    inline
+    boost::shared_ptr<typename
+    MCLongstaffSchwartzEngine<GenericEngine,MC,RNG,S>::path_generator_type>
+    MCLongstaffSchwartzEngine<GenericEngine,MC,RNG,S>::pathGenerator(
+                                              BigNatural seed,
+                                              Size stream,
+                                              Size streams) const {
 
         Size dimensions = process_->factors();
         TimeGrid grid = this->timeGrid();
-        typename RNG::rsg_type generator =
-            RNG::make_sequence_generator(dimensions*(grid.size()-1),seed_);
+        Size dimension = dimensions*(grid.size()-1);
+        typename RNG::rsg_type generator = (streams == 1) ?
+            RNG::make_sequence_generator(dimension, seed) :
+            detail::substreamGenerator<RNG>(dimension, seed,
+                                            stream, streams);
         return boost::shared_ptr<path_generator_type>(
                    new path_generator_type(process_,
                                            grid, generator, brownianBridge_));
@@ -28,15 +28,71 @@
 
 #include <ql/grid.hpp>
 #include <ql/methods/montecarlo/montecarlomodel.hpp>
+#include <boost/type_traits/integral_constant.hpp>
 
 namespace QuantLib {
 
+    namespace detail {
+
+        // whether the random-number traits provide the substream
+        // factory make_sequence_generator(dimension, seed, i, n)
+        template <class RNG>
+        class HasSubstreams {
+            typedef char yes;
+            typedef char (&no)[2];
+            template <class T,
+                      typename T::rsg_type (*)(Size, BigNatural, Size, Size)>
+            struct check;
+            template <class T>
+            static yes test(check<T, &T::make_sequence_generator>*);
+            template <class T> static no test(...);
+          public:
+            static const bool value = sizeof(test<RNG>(0)) == sizeof(yes);
+        };
+
+        template <class RNG>
+        inline typename RNG::rsg_type substreamGenerator(
+                        Size dimension, BigNatural seed,
+                        Size stream, Size streams, boost::true_type) {
+            return RNG::make_sequence_generator(dimension, seed,
+                                                stream, streams);
+        }
+
+        template <class RNG>
+        inline typename RNG::rsg_type substreamGenerator(
+                        Size, BigNatural, Size, Size, boost::false_type) {
+            QL_FAIL("substreams not provided by the random-number traits");
+        }
+
+        /* generator for the i-th worker; the substream factory is
+           only required from the traits when workers are used */
+        template <class RNG>
+        inline typename RNG::rsg_type substreamGenerator(
+                        Size dimension, BigNatural seed,
+                        Size stream, Size streams) {
+            return substreamGenerator<RNG>(
+                dimension, seed, stream, streams,
+                boost::integral_constant<bool,
+                                         HasSubstreams<RNG>::value>());
+        }
+
+    }
+
     //! base class for Monte Carlo engines
     /*! Eventually this class might offer greeks methods.  Deriving a
         class from McSimulation gives an easy way to write a Monte
         Carlo engine.
 
         See McVanillaEngine as an example.
+
+        Samples can be drawn on several threads by passing a number
+        of threads greater than one to the constructor; in this case,
+        derived engines should implement workerPathGenerators() so
+        that each worker draws from its own substream of the random
+        sequence.  Results are reproducible for a given seed and
+        number of threads.  Engines that don't implement it, or whose
+        random-number traits don't provide substreams, are run on a
+        single thread.
     */
 
     template <template <class> class MC, class RNG, class S = Statistics>
@@ -67,12 +123,26 @@ namespace QuantLib {
                        Size maxSamples) const;
       protected:
         McSimulation(bool antitheticVariate,
-                     bool controlVariate)
+                     bool controlVariate,
+                     Size nThreads = 1)
         : antitheticVariate_(antitheticVariate),
-          controlVariate_(controlVariate) {}
+          controlVariate_(controlVariate), nThreads_(nThreads) {
+            QL_REQUIRE(nThreads_ > 0, "at least one thread required");
+        }
         virtual boost::shared_ptr<path_pricer_type> pathPricer() const = 0;
         virtual boost::shared_ptr<path_generator_type> pathGenerator()
                                                                    const = 0;
+        //! path generators for the workers in multithreaded mode
+        /*! The returned generators must be built by means of the
+            substream factories of the random-number traits, with the
+            same seed for all workers; engines with a null seed must
+            draw a random one only once.  An empty vector, returned by
+            default, causes the simulation to run on a single thread.
+        */
+        virtual std::vector<boost::shared_ptr<path_generator_type> >
+        workerPathGenerators(Size) const {
+            return std::vector<boost::shared_ptr<path_generator_type> >();
+        }
         virtual TimeGrid timeGrid() const = 0;
         virtual boost::shared_ptr<path_pricer_type> controlPathPricer() const {
             return boost::shared_ptr<path_pricer_type>();
@@ -94,9 +164,10 @@ namespace QuantLib {
         static Real maxError(Real error) {
             return error;
         }
-        
+
         mutable boost::shared_ptr<MonteCarloModel<MC,RNG,S> > mcModel_;
         bool antitheticVariate_, controlVariate_;
+        Size nThreads_;
     };
 
 
@@ -164,8 +235,48 @@ namespace QuantLib {
                    requiredSamples != Null<Size>(),
                    "neither tolerance nor number of samples set");
 
+        // engines without worker generators, or traits without
+        // substreams, run on a single thread
+        std::vector<boost::shared_ptr<path_generator_type> > generators;
+        if (this->nThreads_ > 1 && detail::HasSubstreams<RNG>::value)
+            generators = this->workerPathGenerators(this->nThreads_);
+
         //! Initialize the one-factor Monte Carlo
-        if (this->controlVariate_) {
+        if (!generators.empty()) {
+
+            QL_REQUIRE(generators.size() == this->nThreads_,
+                       "wrong number of worker path generators ("
+                       << generators.size() << ") given for "
+                       << this->nThreads_ << " threads");
+            std::vector<boost::shared_ptr<path_pricer_type> >
+                pricers(this->nThreads_), controlPricers;
+            for (Size i=0; i<this->nThreads_; ++i)
+                pricers[i] = this->pathPricer();
+
+            result_type controlVariateValue = result_type();
+            if (this->controlVariate_) {
+                controlVariateValue = this->controlVariateValue();
+                QL_REQUIRE(controlVariateValue != Null<result_type>(),
+                           "engine does not provide "
+                           "control-variation price");
+                QL_REQUIRE(!this->controlPathGenerator(),
+                           "control-variation path generators are not "
+                           "supported in multithreaded mode");
+                for (Size i=0; i<this->nThreads_; ++i) {
+                    controlPricers.push_back(this->controlPathPricer());
+                    QL_REQUIRE(controlPricers.back(),
+                               "engine does not provide "
+                               "control-variation path pricer");
+                }
+            }
+
+            this->mcModel_ =
+                boost::shared_ptr<MonteCarloModel<MC,RNG,S> >(
+                    new MonteCarloModel<MC,RNG,S>(
+                           generators, pricers, stats_type(),
+                           this->antitheticVariate_, controlPricers,
+                           controlVariateValue));
+        } else if (this->controlVariate_) {
 
             result_type controlVariateValue = this->controlVariateValue();
             QL_REQUIRE(controlVariateValue != Null<result_type>(),
@@ -28,8 +28,11 @@
 #include <ql/math/integrals/kronrodintegral.hpp>
 #include <ql/math/integrals/trapezoidintegral.hpp>
 #include <ql/math/integrals/gausslobattointegral.hpp>
+#include <ql/math/interpolations/cubicinterpolation.hpp>
+#include <ql/experimental/math/fastfouriertransform.hpp>
 
 #include <ql/instruments/payoffs.hpp>
+#include <ql/exercise.hpp>
 #include <ql/pricingengines/vanilla/analytichestonengine.hpp>
 
 #if defined(QL_PATCH_MSVC)
@@ -39,6 +42,7 @@
 #include <boost/lambda/if.hpp>
 #include <boost/lambda/bind.hpp>
 #include <boost/lambda/lambda.hpp>
+#include <map>
 
 using namespace boost::lambda;
 
@@ -75,6 +79,9 @@ namespace QuantLib {
         Real operator()(Real phi)      const;
 
     private:
+        // strike-independent exponent of the integrand
+        std::complex<Real> exponent(Real phi) const;
+
         const Size j_;
         //     const VanillaOption::arguments& arg_;
         const Real kappa_, theta_, sigma_, v0_;
@@ -91,6 +98,7 @@ namespace QuantLib {
         mutable Real g_km1_; // imag part of last log value
 
         const AnalyticHestonEngine* const engine_;
+        Exponents* const exponents_;
     };
 
 
@@ -112,7 +120,7 @@ namespace QuantLib {
         rsigma_(model->rho()*sigma_),
         t0_(kappa_ - ((j_== 1)? model->rho()*sigma_ : 0)),
         b_(0), g_km1_(0),
-        engine_(engine)
+        engine_(engine), exponents_(0)
     {
     }
 
@@ -140,7 +148,11 @@ namespace QuantLib {
         t0_(kappa - ((j== 1)? rho*sigma : 0)),
         b_(0),
         g_km1_(0),
-        engine_(engine)
+        engine_(engine),
+        exponents_(engine != 0
+                   ? engine->exponents(term, j, kappa, theta, sigma,
+                                       v0, rho, dd_)
+                   : 0)
     {
     }
 
@@ -167,12 +179,65 @@ namespace QuantLib {
         t0_(kappa - ((j== 1)? rho*sigma : 0)),
         b_(0),
         g_km1_(0),
-        engine_(0)
+        engine_(0),
+        exponents_(0)
     {
     }
 
 
     Real AnalyticHestonEngine::Fj_Helper::operator()(Real phi) const
+    {
+        if (cpxLog_ == Gatheral && phi == 0.0) {
+            // use l'Hospital's rule to get lim_{phi->0}
+            if (j_ == 1) {
+                const Real kmr = rsigma_-kappa_;
+                if (std::fabs(kmr) > 1e-7) {
+                    return dd_-sx_
+                        + (std::exp(kmr*term_)*kappa_*theta_
+                           -kappa_*theta_*(kmr*term_+1.0) ) / (2*kmr*kmr)
+                        - v0_*(1.0-std::exp(kmr*term_)) / (2.0*kmr);
+                }
+                else
+                    // \kappa = \rho * \sigma
+                    return dd_-sx_ + 0.25*kappa_*theta_*term_*term_
+                                   + 0.5*v0_*term_;
+            }
+            else {
+                return dd_-sx_
+                    - (std::exp(-kappa_*term_)*kappa_*theta_
+                       +kappa_*theta_*(kappa_*term_-1.0))/(2*kappa_*kappa_)
+                    - v0_*(1.0-std::exp(-kappa_*term_))/(2*kappa_);
+            }
+        }
+
+        // the exponent doesn't depend on the strike; if the engine
+        // keeps it, it's calculated once for all options with the
+        // same exercise date.  The branch correction state is kept
+        // with it, so that nodes not calculated yet follow from the
+        // right branch.
+        std::complex<Real> e;
+        if (exponents_ != 0) {
+            Exponents::const_iterator i = exponents_->find(phi);
+            if (i != exponents_->end()) {
+                e = i->second.value;
+                b_ = i->second.branch;
+                g_km1_ = i->second.lastImag;
+            } else {
+                e = exponent(phi);
+                Exponent& cached = (*exponents_)[phi];
+                cached.value = e;
+                cached.branch = b_;
+                cached.lastImag = g_km1_;
+            }
+        } else {
+            e = exponent(phi);
+        }
+
+        return std::exp(e + std::complex<Real>(0.0, -phi*sx_)).imag()/phi;
+    }
+
+    std::complex<Real>
+    AnalyticHestonEngine::Fj_Helper::exponent(Real phi) const
     {
         const Real rpsig(rsigma_*phi);
 
@@ -182,57 +247,29 @@ namespace QuantLib {
                       *std::complex<Real>(-phi, (j_== 1)? 1 : -1));
         const std::complex<Real> ex = std::exp(-d*term_);
         const std::complex<Real> addOnTerm
-            = engine_ > 0 ? engine_->addOnTerm(phi, term_, j_) : 0.0;
+            = engine_ != 0 ? engine_->addOnTerm(phi, term_, j_) : 0.0;
 
         if (cpxLog_ == Gatheral) {
-            if (phi != 0.0) {
-                if (sigma_ > 1e-5) {
-                    const std::complex<Real> p = (t1-d)/(t1+d);
-                    const std::complex<Real> g
-                                            = std::log((1.0 - p*ex)/(1.0 - p));
-
-                    return
-                        std::exp(v0_*(t1-d)*(1.0-ex)/(sigma2_*(1.0-ex*p))
-                                 + (kappa_*theta_)/sigma2_*((t1-d)*term_-2.0*g)
-                                 + std::complex<Real>(0.0, phi*(dd_-sx_))
-                                 + addOnTerm
-                                 ).imag()/phi;
-                }
-                else {
-                    const std::complex<Real> td = phi/(2.0*t1)
-                                   *std::complex<Real>(-phi, (j_== 1)? 1 : -1);
-                    const std::complex<Real> p = td*sigma2_/(t1+d);
-                    const std::complex<Real> g = p*(1.0-ex);
-
-                    return
-                        std::exp(v0_*td*(1.0-ex)/(1.0-p*ex)
-                                 + (kappa_*theta_)*(td*term_-2.0*g/sigma2_)
-                                 + std::complex<Real>(0.0, phi*(dd_-sx_))
-                                 + addOnTerm
-                                 ).imag()/phi;
-                }
+            if (sigma_ > 1e-5) {
+                const std::complex<Real> p = (t1-d)/(t1+d);
+                const std::complex<Real> g
+                                        = std::log((1.0 - p*ex)/(1.0 - p));
+
+                return v0_*(t1-d)*(1.0-ex)/(sigma2_*(1.0-ex*p))
+                     + (kappa_*theta_)/sigma2_*((t1-d)*term_-2.0*g)
+                     + std::complex<Real>(0.0, phi*dd_)
+                     + addOnTerm;
             }
             else {
-                // use l'Hospital's rule to get lim_{phi->0}
-                if (j_ == 1) {
-                    const Real kmr = rsigma_-kappa_;
-                    if (std::fabs(kmr) > 1e-7) {
-                        return dd_-sx_
-                            + (std::exp(kmr*term_)*kappa_*theta_
-                               -kappa_*theta_*(kmr*term_+1.0) ) / (2*kmr*kmr)
-                            - v0_*(1.0-std::exp(kmr*term_)) / (2.0*kmr);
-                    }
-                    else
-                        // \kappa = \rho * \sigma
-                        return dd_-sx_ + 0.25*kappa_*theta_*term_*term_
-                                       + 0.5*v0_*term_;
-                }
-                else {
-                    return dd_-sx_
-                        - (std::exp(-kappa_*term_)*kappa_*theta_
-                           +kappa_*theta_*(kappa_*term_-1.0))/(2*kappa_*kappa_)
-                        - v0_*(1.0-std::exp(-kappa_*term_))/(2*kappa_);
-                }
+                const std::complex<Real> td = phi/(2.0*t1)
+                               *std::complex<Real>(-phi, (j_== 1)? 1 : -1);
+                const std::complex<Real> p = td*sigma2_/(t1+d);
+                const std::complex<Real> g = p*(1.0-ex);
+
+                return v0_*td*(1.0-ex)/(1.0-p*ex)
+                     + (kappa_*theta_)*(td*term_-2.0*g/sigma2_)
+                     + std::complex<Real>(0.0, phi*dd_)
+                     + addOnTerm;
             }
         }
         else if (cpxLog_ == BranchCorrection) {
@@ -278,17 +315,305 @@ namespace QuantLib {
             g_km1_ = g.imag();
             g += std::complex<Real>(0, 2*b_*M_PI);
 
-            return std::exp(v0_*(t1+d)*(ex-1.0)/(sigma2_*(ex-p))
-                            + (kappa_*theta_)/sigma2_*((t1+d)*term_-2.0*g)
-                            + std::complex<Real>(0,phi*(dd_-sx_))
-                            + addOnTerm
-                            ).imag()/phi;
+            return v0_*(t1+d)*(ex-1.0)/(sigma2_*(ex-p))
+                 + (kappa_*theta_)/sigma2_*((t1+d)*term_-2.0*g)
+                 + std::complex<Real>(0,phi*dd_)
+                 + addOnTerm;
         }
         else {
             QL_FAIL("unknown complex logarithm formula");
         }
     }
 
+    namespace {
+
+        /* complex number together with its derivatives with respect
+           to the Heston parameters theta, kappa, sigma, rho and v0
+           and to the integration variable phi, propagated by
+           forward-mode differentiation. */
+        class HestonDual {
+          public:
+            static const Size size = 6;
+            // index of the derivative with respect to phi
+            static const Size phi = 5;
+
+            HestonDual(const std::complex<Real>& value = 0.0)
+            : value_(value) {
+                std::fill(d_, d_+size, std::complex<Real>(0.0));
+            }
+            HestonDual(Real value)
+            : value_(value) {
+                std::fill(d_, d_+size, std::complex<Real>(0.0));
+            }
+            // the i-th parameter, with unit derivative with respect to it
+            static HestonDual parameter(Real value, Size i) {
+                HestonDual x(value);
+                x.d_[i] = 1.0;
+                return x;
+            }
+
+            const std::complex<Real>& value() const { return value_; }
+            const std::complex<Real>& derivative(Size i) const {
+                return d_[i];
+            }
+
+            HestonDual& operator+=(const HestonDual& y) {
+                value_ += y.value_;
+                for (Size i=0; i<size; ++i)
+                    d_[i] += y.d_[i];
+                return *this;
+            }
+            HestonDual& operator-=(const HestonDual& y) {
+                value_ -= y.value_;
+                for (Size i=0; i<size; ++i)
+                    d_[i] -= y.d_[i];
+                return *this;
+            }
+            HestonDual& operator*=(const HestonDual& y) {
+                for (Size i=0; i<size; ++i)
+                    d_[i] = d_[i]*y.value_ + value_*y.d_[i];
+                value_ *= y.value_;
+                return *this;
+            }
+            HestonDual& operator/=(const HestonDual& y) {
+                const std::complex<Real> r = 1.0/y.value_;
+                value_ *= r;
+                for (Size i=0; i<size; ++i)
+                    d_[i] = (d_[i] - value_*y.d_[i])*r;
+                return *this;
+            }
+            HestonDual operator-() const {
+                HestonDual x(*this);
+                x.value_ = -x.value_;
+                for (Size i=0; i<size; ++i)
+                    x.d_[i] = -x.d_[i];
+                return x;
+            }
+
+            // f(x) given f(x.value) and f'(x.value)
+            HestonDual chain(const std::complex<Real>& f,
+                             const std::complex<Real>& df) const {
+                HestonDual x(f);
+                for (Size i=0; i<size; ++i)
+                    x.d_[i] = df*d_[i];
+                return x;
+            }
+          private:
+            std::complex<Real> value_;
+            std::complex<Real> d_[size];
+        };
+
+        HestonDual operator+(HestonDual x, const HestonDual& y) {
+            return x += y;
+        }
+
+        HestonDual operator-(HestonDual x, const HestonDual& y) {
+            return x -= y;
+        }
+
+        HestonDual operator*(HestonDual x, const HestonDual& y) {
+            return x *= y;
+        }
+
+        HestonDual operator/(HestonDual x, const HestonDual& y) {
+            return x /= y;
+        }
+
+        HestonDual exp(const HestonDual& x) {
+            const std::complex<Real> e = std::exp(x.value());
+            return x.chain(e, e);
+        }
+
+        HestonDual log(const HestonDual& x) {
+            return x.chain(std::log(x.value()), 1.0/x.value());
+        }
+
+        HestonDual sqrt(const HestonDual& x) {
+            const std::complex<Real> s = std::sqrt(x.value());
+            return x.chain(s, 0.5/s);
+        }
+
+    }
+
+
+    // derivatives of the Fj_Helper integrand
+    class AnalyticHestonEngine::Fj_Gradient {
+      public:
+        Fj_Gradient(Real kappa, Real theta, Real sigma,
+                    Real v0, Real s0, Real rho,
+                    ComplexLogFormula cpxLog,
+                    Time term, Real strike, Real ratio, Size j);
+
+        // derivative of the integrand w.r.t. the i-th parameter;
+        // for i == 5, derivative of phi times the integrand w.r.t. phi
+        Real derivative(Real phi, Size i) const;
+
+      private:
+        Disposable<Array> derivatives(Real phi) const;
+
+        const Size j_;
+        const HestonDual kappa_, theta_, sigma_, v0_, rho_;
+        const ComplexLogFormula cpxLog_;
+        const Time term_;
+        const Real dx_;
+        const HestonDual sigma2_, rsigma_, t0_;
+
+        // log branch counter
+        mutable int  b_;
+        mutable Real g_km1_;
+
+        // integrals of the different derivatives are evaluated on
+        // the same nodes; each node is only calculated once, and the
+        // branch correction state after it is kept as well
+        struct Node {
+            Array derivatives;
+            int branch;
+            Real lastImag;
+        };
+        mutable std::map<Real, Node> cache_;
+    };
+
+    AnalyticHestonEngine::Fj_Gradient::Fj_Gradient(
+        Real kappa, Real theta, Real sigma, Real v0, Real s0, Real rho,
+        ComplexLogFormula cpxLog, Time term, Real strike, Real ratio,
+        Size j)
+    : j_(j),
+      kappa_(HestonDual::parameter(kappa, 1)),
+      theta_(HestonDual::parameter(theta, 0)),
+      sigma_(HestonDual::parameter(sigma, 2)),
+      v0_(HestonDual::parameter(v0, 4)),
+      rho_(HestonDual::parameter(rho, 3)),
+      cpxLog_(cpxLog), term_(term),
+      dx_(std::log(s0) - std::log(ratio) - std::log(strike)),
+      sigma2_(sigma_*sigma_), rsigma_(rho_*sigma_),
+      t0_(j == 1 ? kappa_ - rsigma_ : kappa_),
+      b_(0), g_km1_(0) {}
+
+    Real AnalyticHestonEngine::Fj_Gradient::derivative(Real phi,
+                                                       Size i) const {
+        std::map<Real, Node>::iterator c = cache_.find(phi);
+        if (c != cache_.end()) {
+            b_ = c->second.branch;
+            g_km1_ = c->second.lastImag;
+        } else {
+            c = cache_.insert(std::make_pair(phi, Node())).first;
+            c->second.derivatives = derivatives(phi);
+            c->second.branch = b_;
+            c->second.lastImag = g_km1_;
+        }
+        return c->second.derivatives[i];
+    }
+
+    Disposable<Array>
+    AnalyticHestonEngine::Fj_Gradient::derivatives(Real phi) const {
+        // same formulas as in Fj_Helper::operator()
+        const HestonDual& kappa = kappa_;
+        const HestonDual& theta = theta_;
+        const HestonDual& v0 = v0_;
+        const HestonDual& sigma2 = sigma2_;
+
+        Array result(HestonDual::size);
+
+        if (cpxLog_ == Gatheral && phi == 0.0) {
+            // use l'Hospital's rule to get lim_{phi->0}
+            HestonDual f;
+            if (j_ == 1) {
+                const HestonDual kmr = rsigma_ - kappa;
+                if (std::fabs(kmr.value().real()) > 1e-7) {
+                    const HestonDual ekt = exp(kmr*term_);
+                    f = (ekt*kappa*theta - kappa*theta*(kmr*term_+1.0))
+                                                          / (2.0*kmr*kmr)
+                        - v0*(1.0-ekt) / (2.0*kmr);
+                } else {
+                    f = 0.25*kappa*theta*term_*term_ + 0.5*v0*term_;
+                }
+            } else {
+                const HestonDual ekt = exp(-kappa*term_);
+                f = - (ekt*kappa*theta + kappa*theta*(kappa*term_-1.0))
+                                                      / (2.0*kappa*kappa)
+                    - v0*(1.0-ekt)/(2.0*kappa);
+            }
+            for (Size i=0; i<HestonDual::phi; ++i)
+                result[i] = f.derivative(i).real();
+            // the derivative of phi times the integrand at phi = 0
+            // is the limit of the integrand
+            result[HestonDual::phi] = f.value().real();
+            return result;
+        }
+
+        const HestonDual x = HestonDual::parameter(phi, HestonDual::phi);
+        const std::complex<Real> ij(0.0, (j_== 1)? 1 : -1);
+        const HestonDual t1 =
+            t0_ + std::complex<Real>(0, -1)*rsigma_*x;
+        const HestonDual d =
+            sqrt(t1*t1 - sigma2*x*(ij - x));
+        const HestonDual ex = exp(-d*term_);
+        const HestonDual iphix = std::complex<Real>(0.0, dx_)*x;
+
+        HestonDual f;
+        if (cpxLog_ == Gatheral) {
+            if (sigma_.value().real() > 1e-5) {
+                const HestonDual p = (t1-d)/(t1+d);
+                const HestonDual g = log((1.0 - p*ex)/(1.0 - p));
+
+                f = exp(v0*(t1-d)*(1.0-ex)/(sigma2*(1.0-ex*p))
+                        + (kappa*theta)/sigma2*((t1-d)*term_-2.0*g)
+                        + iphix);
+            } else {
+                const HestonDual td = x/(2.0*t1)*(ij - x);
+                const HestonDual p = td*sigma2/(t1+d);
+                const HestonDual g = p*(1.0-ex);
+
+                f = exp(v0*td*(1.0-ex)/(1.0-p*ex)
+                        + (kappa*theta)*(td*term_-2.0*g/sigma2)
+                        + iphix);
+            }
+        } else if (cpxLog_ == BranchCorrection) {
+            const HestonDual p = (t1+d)/(t1-d);
+            HestonDual g;
+            const std::complex<Real> e =
+                std::log(p.value()) + d.value()*term_;
+            if (std::exp(-e.real()) > QL_EPSILON) {
+                g = log((1.0 - p/ex)/(1.0 - p));
+            } else {
+                // use a "big phi" approximation; moving the value
+                // back to the principal branch doesn't change the
+                // derivatives
+                g = d*term_ + log(p/(p - 1.0));
+                const Real gi = g.value().imag();
+                if (gi > M_PI || gi <= -M_PI) {
+                    Real im = std::fmod(gi, 2*M_PI);
+                    if (im > M_PI)
+                        im -= 2*M_PI;
+                    else if (im <= -M_PI)
+                        im += 2*M_PI;
+                    g += std::complex<Real>(0.0, im - gi);
+                }
+            }
+
+            const Real tmp = g.value().imag() - g_km1_;
+            if (tmp <= -M_PI)
+                ++b_;
+            else if (tmp > M_PI)
+                --b_;
+
+            g_km1_ = g.value().imag();
+            g += std::complex<Real>(0, 2*b_*M_PI);
+
+            f = exp(v0*(t1+d)*(ex-1.0)/(sigma2*(ex-p))
+                    + (kappa*theta)/sigma2*((t1+d)*term_-2.0*g)
+                    + iphix);
+        } else {
+            QL_FAIL("unknown complex logarithm formula");
+        }
+
+        for (Size i=0; i<HestonDual::phi; ++i)
+            result[i] = f.derivative(i).imag()/phi;
+        result[HestonDual::phi] = f.derivative(HestonDual::phi).imag();
+        return result;
+    }
+
+
     AnalyticHestonEngine::AnalyticHestonEngine(
                               const boost::shared_ptr<HestonModel>& model,
                               Size integrationOrder)
@@ -420,6 +745,321 @@ namespace QuantLib {
     }
 
 
+    void AnalyticHestonEngine::update() {
+        exponents_.clear();
+        GenericModelEngine<HestonModel,
+                           VanillaOption::arguments,
+                           VanillaOption::results>::update();
+    }
+
+    AnalyticHestonEngine::Exponents* AnalyticHestonEngine::exponents(
+                                        Time term, Size j,
+                                        Real kappa, Real theta, Real sigma,
+                                        Real v0, Real rho,
+                                        Real logForward) const {
+        std::vector<Real> parameters(6);
+        parameters[0] = kappa;
+        parameters[1] = theta;
+        parameters[2] = sigma;
+        parameters[3] = v0;
+        parameters[4] = rho;
+        parameters[5] = logForward;
+
+        // the model notifies the engine when its parameters or the
+        // market data change; the check is for doCalculation()
+        // being called with different values.
+        std::pair<std::vector<Real>, Exponents>& cached =
+            exponents_[std::make_pair(term, j)];
+        if (cached.first != parameters) {
+            cached.first = parameters;
+            cached.second.clear();
+        }
+        return &cached.second;
+    }
+
+    Disposable<Array> AnalyticHestonEngine::values(
+            const Date& exerciseDate,
+            const std::vector<boost::shared_ptr<StrikedTypePayoff> >&
+                                                           payoffs) const {
+        const boost::shared_ptr<HestonProcess>& process = model_->process();
+
+        const Real riskFreeDiscount =
+            process->riskFreeRate()->discount(exerciseDate);
+        const Real dividendDiscount =
+            process->dividendYield()->discount(exerciseDate);
+
+        const Real spotPrice = process->s0()->value();
+        QL_REQUIRE(spotPrice > 0.0, "negative or null underlying given");
+
+        const Real term = process->time(exerciseDate);
+
+        Array result(payoffs.size());
+        for (Size i=0; i<payoffs.size(); ++i) {
+            boost::shared_ptr<PlainVanillaPayoff> payoff =
+                boost::dynamic_pointer_cast<PlainVanillaPayoff>(payoffs[i]);
+            QL_REQUIRE(payoff, "non-plain payoff given");
+
+            doCalculation(riskFreeDiscount,
+                          dividendDiscount,
+                          spotPrice,
+                          payoff->strike(),
+                          term,
+                          model_->kappa(),
+                          model_->theta(),
+                          model_->sigma(),
+                          model_->v0(),
+                          model_->rho(),
+                          *payoff,
+                          *integration_,
+                          cpxLog_,
+                          this,
+                          result[i],
+                          evaluations_);
+        }
+        return result;
+    }
+
+    std::complex<Real> AnalyticHestonEngine::chF(const std::complex<Real>& z,
+                                                 Time t) const {
+        const Real kappa = model_->kappa(), theta = model_->theta(),
+                   sigma = model_->sigma(), v0 = model_->v0(),
+                   rho = model_->rho();
+        const Real sigma2 = sigma*sigma;
+
+        // same formulas as in Fj_Helper for j = 2, with complex
+        // argument and without the forward term
+        const std::complex<Real> t1 =
+            kappa - std::complex<Real>(0.0, rho*sigma)*z;
+        const std::complex<Real> zz = z*(z + std::complex<Real>(0.0, 1.0));
+        const std::complex<Real> d = std::sqrt(t1*t1 + sigma2*zz);
+        const std::complex<Real> ex = std::exp(-d*t);
+
+        if (sigma > 1e-5) {
+            const std::complex<Real> p = (t1-d)/(t1+d);
+            const std::complex<Real> g = std::log((1.0 - p*ex)/(1.0 - p));
+
+            return std::exp(v0*(t1-d)*(1.0-ex)/(sigma2*(1.0-ex*p))
+                            + (kappa*theta)/sigma2*((t1-d)*t-2.0*g));
+        }
+        else {
+            const std::complex<Real> td = -zz/(2.0*t1);
+            const std::complex<Real> p = td*sigma2/(t1+d);
+            const std::complex<Real> g = p*(1.0-ex);
+
+            return std::exp(v0*td*(1.0-ex)/(1.0-p*ex)
+                            + (kappa*theta)*(td*t-2.0*g/sigma2));
+        }
+    }
+
+    Disposable<Array> AnalyticHestonEngine::fftValues(
+            const Date& exerciseDate,
+            const std::vector<boost::shared_ptr<StrikedTypePayoff> >&
+                                                                  payoffs,
+            Size fftOrder,
+            Real logStrikeSpacing,
+            Real alpha) const {
+        QL_REQUIRE(fftOrder > 0, "null FFT order given");
+        QL_REQUIRE(logStrikeSpacing > 0.0,
+                   "non-positive log-strike spacing given");
+        QL_REQUIRE(alpha > 0.0, "non-positive damping factor given");
+
+        const boost::shared_ptr<HestonProcess>& process = model_->process();
+
+        const Real riskFreeDiscount =
+            process->riskFreeRate()->discount(exerciseDate);
+        const Real dividendDiscount =
+            process->dividendYield()->discount(exerciseDate);
+
+        const Real spotPrice = process->s0()->value();
+        QL_REQUIRE(spotPrice > 0.0, "negative or null underlying given");
+
+        const Real term = process->time(exerciseDate);
+        const Real forward = spotPrice*dividendDiscount/riskFreeDiscount;
+
+        // Carr-Madan grids (equations 19, 20 and 23)
+        const Size n = Size(1) << fftOrder;
+        const Real lambda = logStrikeSpacing;
+        const Real b = 0.5*n*lambda;
+        const Real eta = 2.0*M_PI/(lambda*n);
+
+        const std::complex<Real> i1(0.0, 1.0);
+        std::vector<std::complex<Real> > fti(n), results(n);
+        for (Size j=0; j<n; ++j) {
+            const Real v = eta*j;
+            // Simpson weights
+            const Real sw =
+                eta*(3.0 + ((j % 2) == 0 ? -1.0 : 1.0)
+                         - ((j == 0) ? 1.0 : 0.0))/3.0;
+
+            const std::complex<Real> psi =
+                chF(v - (alpha+1.0)*i1, term)
+                / (alpha*alpha + alpha - v*v + i1*(2*alpha+1.0)*v);
+
+            fti[j] = std::exp(i1*b*v)*sw*psi;
+        }
+
+        FastFourierTransform fft(fftOrder);
+        fft.transform(fti.begin(), fti.end(), results.begin());
+
+        // undiscounted call prices for a unit forward
+        std::vector<Real> logStrikes(n), calls(n);
+        for (Size u=0; u<n; ++u) {
+            logStrikes[u] = -b + lambda*u;
+            calls[u] = std::exp(-alpha*logStrikes[u])/M_PI
+                     * results[u].real();
+        }
+
+        // only the part of the grid around the given strikes is
+        // interpolated; values far in the wings are less accurate.
+        std::vector<Real> k(payoffs.size());
+        Real kMin = QL_MAX_REAL, kMax = QL_MIN_REAL;
+        for (Size i=0; i<payoffs.size(); ++i) {
+            QL_REQUIRE(boost::dynamic_pointer_cast<PlainVanillaPayoff>(
+                                                                 payoffs[i]),
+                       "non-plain payoff given");
+            QL_REQUIRE(payoffs[i]->strike() > 0.0,
+                       "non-positive strike given");
+            k[i] = std::log(payoffs[i]->strike()/forward);
+            QL_REQUIRE(std::fabs(k[i]) < 0.5*b,
+                       "strike " << payoffs[i]->strike()
+                       << " outside of the FFT grid");
+            kMin = std::min(kMin, k[i]);
+            kMax = std::max(kMax, k[i]);
+        }
+
+        Array result(payoffs.size());
+        if (payoffs.empty())
+            return result;
+
+        const Integer margin = 8;
+        const Size first = static_cast<Size>(std::max<Integer>(
+            Integer(std::floor((kMin + b)/lambda)) - margin, 0));
+        const Size last = static_cast<Size>(std::min<Integer>(
+            Integer(std::ceil((kMax + b)/lambda)) + margin + 1,
+            Integer(n)));
+        CubicNaturalSpline interpolation(logStrikes.begin() + first,
+                                         logStrikes.begin() + last,
+                                         calls.begin() + first);
+
+        for (Size i=0; i<payoffs.size(); ++i) {
+            const Real strike = payoffs[i]->strike();
+            const Real call =
+                riskFreeDiscount*forward*interpolation(k[i], true);
+            switch (payoffs[i]->optionType()) {
+              case Option::Call:
+                result[i] = call;
+                break;
+              case Option::Put:
+                result[i] = call - riskFreeDiscount*(forward - strike);
+                break;
+              default:
+                QL_FAIL("unknown option type");
+            }
+        }
+        return result;
+    }
+
+
+    namespace {
+
+        // adaptor for the integration of a single derivative
+        template <class F>
+        class ComponentIntegrand
+            : public std::unary_function<Real, Real> {
+          public:
+            ComponentIntegrand(const boost::shared_ptr<F>& f, Size i)
+            : f_(f), i_(i) {}
+            Real operator()(Real phi) const {
+                return f_->derivative(phi, i_);
+            }
+          private:
+            boost::shared_ptr<F> f_;
+            Size i_;
+        };
+
+    }
+
+    Disposable<Array> AnalyticHestonEngine::parameterGradient(
+                                       const VanillaOption& option) const {
+        VanillaOption::arguments arguments;
+        option.setupArguments(&arguments);
+        arguments.validate();
+
+        QL_REQUIRE(arguments.exercise->type() == Exercise::European,
+                   "not an European option");
+        boost::shared_ptr<PlainVanillaPayoff> payoff =
+            boost::dynamic_pointer_cast<PlainVanillaPayoff>(arguments.payoff);
+        QL_REQUIRE(payoff, "non-striked payoff given");
+
+        const boost::shared_ptr<HestonProcess>& process = model_->process();
+
+        const Real riskFreeDiscount = process->riskFreeRate()->discount(
+                                            arguments.exercise->lastDate());
+        const Real dividendDiscount = process->dividendYield()->discount(
+                                            arguments.exercise->lastDate());
+
+        const Real spotPrice = process->s0()->value();
+        QL_REQUIRE(spotPrice > 0.0, "negative or null underlying given");
+
+        const Real strikePrice = payoff->strike();
+        const Real term = process->time(arguments.exercise->lastDate());
+
+        Array gradient;
+        if (addOnTerm(1.0, term, 1) != 0.0 || addOnTerm(1.0, term, 2) != 0.0)
+            return gradient;
+
+        const Real kappa = model_->kappa(), theta = model_->theta(),
+                   sigma = model_->sigma(), v0 = model_->v0(),
+                   rho = model_->rho();
+        const Real ratio = riskFreeDiscount/dividendDiscount;
+        const Real sqrtOneMinusRho2 = std::sqrt(1.0-square<Real>()(rho));
+        const Real a = sqrtOneMinusRho2/sigma;
+        const Real c_inf = std::min(10.0, std::max(0.0001, a))
+                *(v0 + kappa*theta*term);
+
+        // Gauss-Legendre and Gauss-Chebyshev quadratures are applied
+        // after scaling phi by c_inf, so that the integrals depend on
+        // it through their nodes; its derivatives are needed too
+        Array dc(5, 0.0);
+        if (integration_->dependsOnScale()) {
+            const Real clampedA = std::min(10.0, std::max(0.0001, a));
+            dc[0] = clampedA*kappa*term;
+            dc[1] = clampedA*theta*term;
+            if (a > 0.0001 && a < 10.0) {
+                dc[2] = -a/sigma*(v0 + kappa*theta*term);
+                dc[3] = -rho/(sqrtOneMinusRho2*sigma)
+                        *(v0 + kappa*theta*term);
+            }
+            dc[4] = clampedA;
+        }
+
+        // the value is S D_q (p1 -/+ 0.5) - K D_r (p2 -/+ 0.5)
+        // for both calls and puts, so are its derivatives
+        gradient = Array(5, 0.0);
+        for (Size j=1; j<=2; ++j) {
+            const boost::shared_ptr<Fj_Gradient> f(
+                new Fj_Gradient(kappa, theta, sigma, v0, spotPrice, rho,
+                                cpxLog_, term, strikePrice, ratio, j));
+            const Real factor = (j == 1)
+                ?  spotPrice*dividendDiscount/M_PI
+                : -strikePrice*riskFreeDiscount/M_PI;
+            for (Size i=0; i<gradient.size(); ++i)
+                gradient[i] += factor*integration_->calculate(
+                    c_inf, ComponentIntegrand<Fj_Gradient>(f, i));
+
+            if (integration_->dependsOnScale()) {
+                // with phi = -log(u)/c, the derivative of the integrand
+                // f(phi)/(u c) w.r.t. c is -(phi f(phi))'/(u c^2)
+                const Real dIdc = -integration_->calculate(
+                    c_inf, ComponentIntegrand<Fj_Gradient>(
+                                                 f, HestonDual::phi))/c_inf;
+                for (Size i=0; i<gradient.size(); ++i)
+                    gradient[i] += factor*dIdc*dc[i];
+            }
+        }
+        return gradient;
+    }
+
     AnalyticHestonEngine::Integration::Integration(
             Algorithm intAlgo,
             const boost::shared_ptr<Integrator>& integrator)
@@ -512,6 +1152,12 @@ namespace QuantLib {
         }
     }
 
+    bool AnalyticHestonEngine::Integration::dependsOnScale() const {
+        return intAlgo_ == GaussLegendre
+            || intAlgo_ == GaussChebyshev
+            || intAlgo_ == GaussChebyshev2nd;
+    }
+
     bool AnalyticHestonEngine::Integration::isAdaptiveIntegration() const {
         return intAlgo_ == GaussLobatto
             || intAlgo_ == GaussKronrod
@@ -33,6 +33,8 @@
 
 #include <boost/function.hpp>
 #include <complex>
+#include <map>
+#include <vector>
 
 namespace QuantLib {
 
@@ -49,6 +51,17 @@ namespace QuantLib {
         routines and should be preferred over the original Heston version.
     */
 
+    /*! Batch pricing:
+        For a given exercise date, the characteristic function in the
+        integrands doesn't depend on the strike. The engine keeps its
+        exponent on each integration node until the model or the
+        market data change, so that options with the same exercise
+        date priced in sequence (e.g., calibration helpers, or a
+        strike slice passed to values()) only evaluate it once.
+        For dense strike grids, fftValues() prices a whole slice with
+        a single fast Fourier transform instead (Carr and Madan, 1998).
+    */
+
     /*! References:
 
         Heston, Steven L., 1993. A Closed-Form Solution for Options
@@ -69,11 +82,18 @@ namespace QuantLib {
         J. Gatheral, The Volatility Surface: A Practitioner's Guide,
         Wiley Finance
 
+        P. Carr and D. B. Madan, Option Valuation using the fast
+        Fourier transform, Journal of Computational Finance, 2,
+        61-73, 1998.
+
         \ingroup vanillaengines
 
-        \test the correctness of the returned value is tested by
-              reproducing results available in web/literature
-              and comparison with Black pricing.
+        \test
+        - the correctness of the returned value is tested by
+          reproducing results available in web/literature
+          and comparison with Black pricing.
+        - batch and FFT prices of strike slices are tested against
+          single-option prices.
     */
     class AnalyticHestonEngine
         : public GenericModelEngine<HestonModel,
@@ -103,8 +123,70 @@ namespace QuantLib {
 
 
         void calculate() const;
+        void update();
         Size numberOfEvaluations() const;
 
+        //! \name Batch pricing
+        //@{
+        //! values of European options with the given exercise date
+        /*! The options are priced with the engine's integration
+            algorithm; the characteristic function is evaluated once
+            on each integration node and shared by all the strikes.
+
+            \warning the add-on terms of derived engines must not
+                     depend on the exercise date of the option last
+                     priced by calculate().
+        */
+        Disposable<Array> values(
+            const Date& exerciseDate,
+            const std::vector<boost::shared_ptr<StrikedTypePayoff> >&
+                                                           payoffs) const;
+        //! values of European options given by a fast Fourier transform
+        /*! Undiscounted call prices are calculated on an equally
+            spaced grid of \f$ 2^{fftOrder} \f$ log-strikes centered
+            on the forward, with Carr-Madan damping factor
+            \f$ \alpha \f$; put prices are obtained by put-call
+            parity. The given strikes are interpolated on the grid
+            with a cubic spline. The cost doesn't depend on the number
+            of options, but is higher than that of values() for a
+            handful of strikes.
+
+            The grid must be wide enough for the prices to decay:
+            the discretization error is of the order of
+            \f$ \exp(-\alpha b) \f$, where \f$ b \f$ is half the
+            width of the log-strike grid.
+
+            \warning the add-on terms of derived engines are not
+                     supported.
+        */
+        Disposable<Array> fftValues(
+            const Date& exerciseDate,
+            const std::vector<boost::shared_ptr<StrikedTypePayoff> >&
+                                                                  payoffs,
+            Size fftOrder = 13,
+            Real logStrikeSpacing = 0.005,
+            Real alpha = 1.25) const;
+        //@}
+
+        //! derivatives of the option value w.r.t. the model parameters
+        /*! The characteristic function is differentiated under the
+            integral, and the resulting integrals are evaluated with
+            the same algorithm used for the option value.  The
+            derivatives are returned in the order of the model
+            parameters, i.e., theta, kappa, sigma, rho and v0.
+
+            When the integration depends on the scale c_inf of the
+            integration variable (Gauss-Legendre and Gauss-Chebyshev
+            quadratures) the derivatives of the latter are taken
+            into account as well, so that the gradient is the one of
+            the discretized value.
+
+            The add-on terms of derived engines are not
+            differentiated; if they're not null, an empty array is
+            returned.
+        */
+        Disposable<Array> parameterGradient(const VanillaOption& option) const;
+
         static void doCalculation(Real riskFreeDiscount,
                                              Real dividendDiscount,
                                              Real spotPrice,
@@ -127,10 +209,28 @@ namespace QuantLib {
 
       private:
         class Fj_Helper;
+        class Fj_Gradient;
+
+        // exponents of the integrands by integration node, together
+        // with the state of the log branch correction after the node
+        struct Exponent {
+            std::complex<Real> value;
+            int branch;
+            Real lastImag;
+        };
+        typedef std::map<Real, Exponent> Exponents;
+        Exponents* exponents(Time term, Size j,
+                             Real kappa, Real theta, Real sigma,
+                             Real v0, Real rho, Real logForward) const;
+        // characteristic function of log(S_t/F_t)
+        std::complex<Real> chF(const std::complex<Real>& z, Time t) const;
 
         mutable Size evaluations_;
         const ComplexLogFormula cpxLog_;
         const boost::shared_ptr<Integration> integration_;
+        // by term and j, together with the parameters they're valid for
+        mutable std::map<std::pair<Time, Size>,
+                         std::pair<std::vector<Real>, Exponents> > exponents_;
 
 
 
@@ -165,6 +265,9 @@ namespace QuantLib {
 
         Size numberOfEvaluations() const;
         bool isAdaptiveIntegration() const;
+        // whether the integral depends on the c_inf scaling of the
+        // integration variable through the quadrature nodes
+        bool dependsOnScale() const;
 
       private:
         enum Algorithm
@@ -61,7 +61,9 @@ namespace QuantLib {
              BigNatural seed,
              Size polynomOrder,
              LsmBasisSystem::PolynomType polynomType,
-             Size nCalibrationSamples = Null<Size>());
+             Size nCalibrationSamples = Null<Size>(),
+             Size nThreads = 1,
+             bool streamingCalibration = false);
 
         void calculate() const;
         
@@ -116,6 +118,8 @@ namespace QuantLib {
         MakeMCAmericanEngine& withPolynomOrder(Size polynomOrer);
         MakeMCAmericanEngine& withBasisSystem(LsmBasisSystem::PolynomType);
         MakeMCAmericanEngine& withCalibrationSamples(Size calibrationSamples);
+        MakeMCAmericanEngine& withThreads(Size n);
+        MakeMCAmericanEngine& withStreamingCalibration(bool b = true);
 
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
@@ -128,6 +132,8 @@ namespace QuantLib {
         BigNatural seed_;
         Size polynomOrder_;
         LsmBasisSystem::PolynomType polynomType_;
+        Size nThreads_;
+        bool streamingCalibration_;
     };
 
     template <class RNG, class S> inline
@@ -138,14 +144,16 @@ namespace QuantLib {
         Size requiredSamples, Real requiredTolerance,
         Size maxSamples,BigNatural seed,
         Size polynomOrder, LsmBasisSystem::PolynomType polynomType,
-        Size nCalibrationSamples)
+        Size nCalibrationSamples, Size nThreads,
+        bool streamingCalibration)
     : MCLongstaffSchwartzEngine<VanillaOption::engine,
                                 SingleVariate,RNG,S>(
                                          process, timeSteps, timeStepsPerYear,
                                          false, antitheticVariate,
                                          controlVariate, requiredSamples,
                                          requiredTolerance, maxSamples,
-                                         seed, nCalibrationSamples),
+                                         seed, nCalibrationSamples,
+                                         nThreads, streamingCalibration),
       polynomOrder_(polynomOrder),
       polynomType_(polynomType) {}
 
@@ -252,7 +260,8 @@ namespace QuantLib {
       calibrationSamples_(2048),
       tolerance_(Null<Real>()), seed_(0),
       polynomOrder_(2),
-      polynomType_ (LsmBasisSystem::Monomial) {}
+      polynomType_ (LsmBasisSystem::Monomial),
+      nThreads_(1), streamingCalibration_(false) {}
 
     template <class RNG, class S>
     inline MakeMCAmericanEngine<RNG,S>&
@@ -340,6 +349,20 @@ namespace QuantLib {
     }
 
 
+    template <class RNG, class S>
+    inline MakeMCAmericanEngine<RNG,S>&
+    MakeMCAmericanEngine<RNG,S>::withThreads(Size n) {
+        nThreads_ = n;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMCAmericanEngine<RNG,S>&
+    MakeMCAmericanEngine<RNG,S>::withStreamingCalibration(bool b) {
+        streamingCalibration_ = b;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCAmericanEngine<RNG,S>::operator boost::shared_ptr<PricingEngine>()
@@ -359,7 +382,9 @@ namespace QuantLib {
                                      seed_,
                                      polynomOrder_,
                                      polynomType_,
-                                     calibrationSamples_));
+                                     calibrationSamples_,
+                                     nThreads_,
+                                     streamingCalibration_));
     }
 
 }
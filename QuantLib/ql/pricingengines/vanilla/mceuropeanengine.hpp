@@ -36,8 +36,11 @@ namespace QuantLib {
     //! European option pricing engine using Monte Carlo simulation
     /*! \ingroup vanillaengines
 
-        \test the correctness of the returned value is tested by
-              checking it against analytic results.
+        \test
+        - the correctness of the returned value is tested by
+          checking it against analytic results.
+        - the reproducibility of multithreaded results for a given
+          seed and number of threads is tested.
     */
     template <class RNG = PseudoRandom, class S = Statistics>
     class MCEuropeanEngine : public MCVanillaEngine<SingleVariate,RNG,S> {
@@ -60,7 +63,8 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed);
+             BigNatural seed,
+             Size nThreads = 1);
       protected:
         boost::shared_ptr<path_pricer_type> pathPricer() const;
     };
@@ -80,6 +84,7 @@ namespace QuantLib {
         MakeMCEuropeanEngine& withMaxSamples(Size samples);
         MakeMCEuropeanEngine& withSeed(BigNatural seed);
         MakeMCEuropeanEngine& withAntitheticVariate(bool b = true);
+        MakeMCEuropeanEngine& withThreads(Size n);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
       private:
@@ -89,14 +94,18 @@ namespace QuantLib {
         Real tolerance_;
         bool brownianBridge_;
         BigNatural seed_;
+        Size nThreads_;
     };
 
-    class EuropeanPathPricer : public PathPricer<Path> {
+    class EuropeanPathPricer : public PathPricer<Path>,
+                               public BlockPathPricer<PathBlock> {
       public:
         EuropeanPathPricer(Option::Type type,
                            Real strike,
                            DiscountFactor discount);
         Real operator()(const Path& path) const;
+        void operator()(const PathBlock& paths,
+                        std::vector<Real>& values) const;
       private:
         PlainVanillaPayoff payoff_;
         DiscountFactor discount_;
@@ -116,7 +125,8 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed)
+             BigNatural seed,
+             Size nThreads)
     : MCVanillaEngine<SingleVariate,RNG,S>(process,
                                            timeSteps,
                                            timeStepsPerYear,
@@ -126,7 +136,8 @@ namespace QuantLib {
                                            requiredSamples,
                                            requiredTolerance,
                                            maxSamples,
-                                           seed) {}
+                                           seed,
+                                           nThreads) {}
 
 
     template <class RNG, class S>
@@ -159,7 +170,8 @@ namespace QuantLib {
     : process_(process), antithetic_(false),
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), brownianBridge_(false), seed_(0) {}
+      tolerance_(Null<Real>()), brownianBridge_(false), seed_(0),
+      nThreads_(1) {}
 
     template <class RNG, class S>
     inline MakeMCEuropeanEngine<RNG,S>&
@@ -224,6 +236,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCEuropeanEngine<RNG,S>&
+    MakeMCEuropeanEngine<RNG,S>::withThreads(Size n) {
+        nThreads_ = n;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCEuropeanEngine<RNG,S>::operator boost::shared_ptr<PricingEngine>()
@@ -240,7 +259,8 @@ namespace QuantLib {
                                     antithetic_,
                                     samples_, tolerance_,
                                     maxSamples_,
-                                    seed_));
+                                    seed_,
+                                    nThreads_));
     }
 
 
@@ -258,6 +278,16 @@ namespace QuantLib {
         return payoff_(path.back()) * discount_;
     }
 
+    inline void EuropeanPathPricer::operator()(
+                                        const PathBlock& paths,
+                                        std::vector<Real>& values) const {
+        QL_REQUIRE(paths.length() > 0, "the paths cannot be empty");
+        values.resize(paths.size());
+        Matrix::const_row_iterator last = paths.begin(paths.length()-1);
+        for (Size j=0; j<values.size(); ++j)
+            values[j] = payoff_(last[j]) * discount_;
+    }
+
 }
 
 
@@ -26,6 +26,7 @@
 #define quantlib_mcvanilla_engine_hpp
 
 #include <ql/pricingengines/mcsimulation.hpp>
+#include <ql/math/randomnumbers/seedgenerator.hpp>
 #include <ql/instruments/vanillaoption.hpp>
 
 namespace QuantLib {
@@ -65,15 +66,33 @@ namespace QuantLib {
                         Size requiredSamples,
                         Real requiredTolerance,
                         Size maxSamples,
-                        BigNatural seed);
+                        BigNatural seed,
+                        Size nThreads = 1);
         // McSimulation implementation
         TimeGrid timeGrid() const;
         boost::shared_ptr<path_generator_type> pathGenerator() const {
+            return pathGenerator(seed_, 0, 1);
+        }
+        std::vector<boost::shared_ptr<path_generator_type> >
+        workerPathGenerators(Size workers) const {
+            // all workers must use the same seed
+            BigNatural seed =
+                seed_ != 0 ? seed_ : SeedGenerator::instance().get();
+            std::vector<boost::shared_ptr<path_generator_type> > generators;
+            for (Size i=0; i<workers; ++i)
+                generators.push_back(pathGenerator(seed, i, workers));
+            return generators;
+        }
+        boost::shared_ptr<path_generator_type>
+        pathGenerator(BigNatural seed, Size stream, Size streams) const {
 
             Size dimensions = process_->factors();
             TimeGrid grid = this->timeGrid();
-            typename RNG::rsg_type generator =
-                RNG::make_sequence_generator(dimensions*(grid.size()-1),seed_);
+            Size dimension = dimensions*(grid.size()-1);
+            typename RNG::rsg_type generator = (streams == 1) ?
+                RNG::make_sequence_generator(dimension, seed) :
+                detail::substreamGenerator<RNG>(dimension, seed,
+                                                stream, streams);
             return boost::shared_ptr<path_generator_type>(
                    new path_generator_type(process_, grid,
                                            generator, brownianBridge_));
@@ -102,8 +121,9 @@ namespace QuantLib {
                           Size requiredSamples,
                           Real requiredTolerance,
                           Size maxSamples,
-                          BigNatural seed)
-    : McSimulation<MC,RNG,S>(antitheticVariate, controlVariate),
+                          BigNatural seed,
+                          Size nThreads)
+    : McSimulation<MC,RNG,S>(antitheticVariate, controlVariate, nThreads),
       process_(process), timeSteps_(timeSteps),
       timeStepsPerYear_(timeStepsPerYear),
       requiredSamples_(requiredSamples), maxSamples_(maxSamples),
@@ -78,6 +78,35 @@ namespace QuantLib {
                          stdDeviation(t0,x0,dt)*dw);
     }
 
+    void GeneralizedBlackScholesProcess::evolve(Time t0, Time dt, Size n,
+                                                const Real* x0,
+                                                const Real* dw,
+                                                Real* x) const {
+        if (n == 0)
+            return;
+
+        boost::shared_ptr<LocalVolTermStructure> localVol =
+            localVolatility().currentLink();
+        bool stateIndependent = false;
+        if (boost::dynamic_pointer_cast<LocalConstantVol>(localVol) ||
+            boost::dynamic_pointer_cast<LocalVolCurve>(localVol))
+            stateIndependent = true;
+        bool euler = false;
+        if (boost::dynamic_pointer_cast<EulerDiscretization>(discretization_))
+            euler = true;
+
+        if (stateIndependent && euler) {
+            // same drift and standard deviation for all values
+            Real drift = discretization_->drift(*this,t0,x0[0],dt);
+            Real stdDev = stdDeviation(t0,x0[0],dt);
+            for (Size i=0; i<n; ++i)
+                x[i] = GeneralizedBlackScholesProcess::apply(
+                                                x0[i], drift + stdDev*dw[i]);
+        } else {
+            StochasticProcess1D::evolve(t0, dt, n, x0, dw, x);
+        }
+    }
+
     Time GeneralizedBlackScholesProcess::time(const Date& d) const {
         return riskFreeRate_->dayCounter().yearFraction(
                                            riskFreeRate_->referenceDate(), d);
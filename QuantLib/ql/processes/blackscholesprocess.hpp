@@ -67,6 +67,16 @@ namespace QuantLib {
         */
         Real expectation(Time t0, Real x0, Time dt) const;
         Real evolve(Time t0, Real x0, Time dt, Real dw) const;
+        /*! when the local volatility doesn't depend on the asset
+            value and the Euler discretization is used, drift and
+            diffusion are calculated once for the whole block.
+
+            \warning derived classes overriding drift(), diffusion()
+                     or the single-value evolve() must override this
+                     method as well.
+        */
+        void evolve(Time t0, Time dt, Size n,
+                    const Real* x0, const Real* dw, Real* x) const;
         //@}
         Time time(const Date&) const;
         //! \name Observer interface
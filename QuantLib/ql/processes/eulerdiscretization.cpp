@@ -50,7 +50,7 @@ namespace QuantLib {
                                       Time t0, const Array& x0,
                                       Time dt) const {
         Matrix sigma = process.diffusion(t0, x0);
-        Matrix result = sigma*transpose(sigma)*dt;
+        Matrix result = symmetricProduct(sigma)*dt;
         return result;
     }
 
@@ -94,7 +94,7 @@ namespace QuantLib {
                                                           const Array& x0,
                                                           Time dt) const {
         Matrix tmp = stdDeviation(t0, x0, dt);
-        return tmp*transpose(tmp);
+        return symmetricProduct(tmp);
     }
 
     Disposable<Array> StochasticProcessArray::evolve(
@@ -125,7 +125,7 @@ namespace QuantLib {
     }
 
     Disposable<Matrix> StochasticProcessArray::correlation() const {
-        return sqrtCorrelation_ * transpose(sqrtCorrelation_);
+        return symmetricProduct(sqrtCorrelation_);
     }
 
 }
@@ -98,6 +98,13 @@ namespace QuantLib {
         return apply(expectation(t0,x0,dt), stdDeviation(t0,x0,dt)*dw);
     }
 
+    void StochasticProcess1D::evolve(Time t0, Time dt, Size n,
+                                     const Real* x0, const Real* dw,
+                                     Real* x) const {
+        for (Size i=0; i<n; ++i)
+            x[i] = evolve(t0, x0[i], dt, dw[i]);
+    }
+
     Real StochasticProcess1D::apply(Real x0, Real dx) const {
         return x0 + dx;
     }
@@ -216,6 +216,14 @@ namespace QuantLib {
             standard deviation.
         */
         virtual Real evolve(Time t0, Real x0, Time dt, Real dw) const;
+        /*! evolves a block of \f$ n \f$ asset values over the same
+            time interval, i.e., sets \f$ x_i \f$ to the result of
+            <tt>evolve(t0, x0[i], dt, dw[i])</tt>.  By default, it
+            calls the above method for each value; derived classes
+            can override it to share calculations across the block.
+        */
+        virtual void evolve(Time t0, Time dt, Size n,
+                            const Real* x0, const Real* dw, Real* x) const;
         /*! applies a change to the asset value. By default, it
             returns \f$ x + \Delta x \f$.
         */
@@ -0,0 +1,369 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file globalbootstrap.hpp
+    \brief global (all pillars at once) term-structure bootstrapper
+*/
+
+#ifndef quantlib_global_bootstrap_hpp
+#define quantlib_global_bootstrap_hpp
+
+#include <ql/termstructures/bootstraphelper.hpp>
+#include <ql/math/matrixutilities/qrdecomposition.hpp>
+#include <ql/utilities/dataformatters.hpp>
+#include <boost/shared_ptr.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace QuantLib {
+
+    //! Global term-structure bootstrapper
+    /*! All the pillars are solved at once with a Newton method on
+        the vector of helper quote errors. This avoids the outer
+        convergence loop that IterativeBootstrap needs for global
+        interpolations (e.g., cubic or convex-monotone) in which
+        each pillar is solved again at every iteration.
+
+        The helpers don't provide analytic sensitivities, so the
+        Jacobian of the quote errors with respect to the pillar
+        values is calculated by central finite differences. This is
+        only done if the current pillar values don't already match
+        the quotes; the Jacobian is then kept up to date with
+        Broyden's rank-one updates and calculated again only if
+        the updated one fails to reduce the errors.
+
+        The sensitivities of the pillar values to the helper quotes
+        are available after the bootstrap without rebuilding the
+        curve. They need the Jacobian at the solution; unless the
+        last one was calculated there, it is calculated when the
+        sensitivities are first asked for.
+
+        \ingroup yieldtermstructures
+    */
+    template <class Curve>
+    class GlobalBootstrap {
+        typedef typename Curve::traits_type Traits;
+        typedef typename Curve::interpolator_type Interpolator;
+        typedef typename Traits::helper helper;
+      public:
+        GlobalBootstrap(Size maxIterations = 100,
+                        Real relativeBump = 1.0e-6);
+        void setup(Curve* ts);
+        void calculate() const;
+        //! sensitivities of the pillar values to the helper quotes
+        /*! The element \f$ (i,j) \f$ is the derivative of the
+            \f$ (i+1) \f$-th curve datum, i.e., the value at the
+            \f$ (i+1) \f$-th curve date, with respect to the quote
+            of the \f$ j \f$-th helper in the order in which the
+            helpers were passed to the curve. Expired helpers have
+            null columns.
+
+            \warning the curve must be calculated before calling
+                     this method; use PiecewiseYieldCurve::jacobian()
+                     instead, which takes care of it.
+        */
+        const Matrix& jacobian() const;
+      private:
+        void initialize() const;
+        void setupHelpers() const;
+        void setData(const Array& x) const;
+        void errors(const Array& x, Array& result) const;
+        void errorJacobian(const Array& x, Matrix& result) const;
+        void sensitivities(const Matrix& errorJacobian) const;
+        Curve* ts_;
+        Size n_;
+        Size maxIterations_;
+        Real relativeBump_;
+        mutable bool validCurve_, jacobianCalculated_;
+        mutable Size firstAliveHelper_, alive_;
+        std::vector<boost::shared_ptr<helper> > helpers_;
+        mutable Matrix jacobian_;
+    };
+
+
+    // template definitions
+
+    template <class Curve>
+    GlobalBootstrap<Curve>::GlobalBootstrap(Size maxIterations,
+                                            Real relativeBump)
+    : ts_(0), n_(0), maxIterations_(maxIterations),
+      relativeBump_(relativeBump), validCurve_(false),
+      jacobianCalculated_(false), firstAliveHelper_(0), alive_(0) {}
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::setup(Curve* ts) {
+
+        ts_ = ts;
+        n_ = ts_->instruments_.size();
+        QL_REQUIRE(n_+1 >= Interpolator::requiredPoints,
+                   "not enough instruments: " << n_ << " provided, " <<
+                   Interpolator::requiredPoints-1 << " required");
+
+        for (Size j=0; j<n_; ++j)
+            ts_->registerWith(ts_->instruments_[j]);
+
+        // the order in which the helpers were given, used for the
+        // columns of the Jacobian
+        helpers_ = ts_->instruments_;
+    }
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::initialize() const {
+        // ensure helpers are sorted
+        std::sort(ts_->instruments_.begin(), ts_->instruments_.end(),
+                  detail::BootstrapHelperSorter());
+
+        // skip expired helpers
+        Date firstDate = Traits::initialDate(ts_);
+        QL_REQUIRE(ts_->instruments_[n_-1]->latestDate()>firstDate,
+                   "all instruments expired");
+        firstAliveHelper_ = 0;
+        while (ts_->instruments_[firstAliveHelper_]->latestDate() <= firstDate)
+            ++firstAliveHelper_;
+        alive_ = n_-firstAliveHelper_;
+        QL_REQUIRE(alive_>=Interpolator::requiredPoints-1,
+                   "not enough alive instruments: " << alive_ <<
+                   " provided, " << Interpolator::requiredPoints-1 <<
+                   " required");
+
+        // calculate dates and times
+        std::vector<Date>& dates = ts_->dates_;
+        std::vector<Time>& times = ts_->times_;
+        dates.resize(alive_+1);
+        times.resize(alive_+1);
+        dates[0] = firstDate;
+        times[0] = ts_->timeFromReference(dates[0]);
+        for (Size i=1, j=firstAliveHelper_; j<n_; ++i, ++j) {
+            dates[i] = ts_->instruments_[j]->latestDate();
+            times[i] = ts_->timeFromReference(dates[i]);
+            // check for duplicated maturity
+            QL_REQUIRE(dates[i-1]!=dates[i],
+                       "more than one instrument with maturity " << dates[i]);
+        }
+
+        // set the initial guess only if the current curve cannot be
+        // used as guess; the traits guess pillar by pillar by
+        // flat extrapolation of the previous one.
+        if (!validCurve_ || ts_->data_.size()!=alive_+1) {
+            ts_->data_ = std::vector<Real>(alive_+1,
+                                           Traits::initialValue(ts_));
+            // some traits extrapolate the curve itself, which must
+            // then be usable while the guess is being built
+            ts_->interpolation_ = ts_->interpolator_.interpolate(
+                                      times.begin(), times.end(),
+                                      ts_->data_.begin());
+            for (Size i=1; i<=alive_; ++i) {
+                Traits::updateGuess(ts_->data_,
+                                    Traits::guess(i, ts_, false,
+                                                  firstAliveHelper_),
+                                    i);
+                ts_->interpolation_.update();
+            }
+        }
+
+        ts_->interpolation_ = ts_->interpolator_.interpolate(
+                                  times.begin(), times.end(),
+                                  ts_->data_.begin());
+    }
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::setData(const Array& x) const {
+        for (Size i=0; i<alive_; ++i)
+            Traits::updateGuess(ts_->data_, x[i], i+1);
+        ts_->interpolation_.update();
+    }
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::errors(const Array& x,
+                                        Array& result) const {
+        setData(x);
+        for (Size i=0; i<alive_; ++i)
+            result[i] = ts_->instruments_[firstAliveHelper_+i]->quoteError();
+    }
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::errorJacobian(const Array& x,
+                                               Matrix& result) const {
+        Array y = x, up(alive_), down(alive_);
+        for (Size j=0; j<alive_; ++j) {
+            Real h = relativeBump_ * std::max(std::fabs(x[j]), 1.0);
+            y[j] = x[j] + h;
+            errors(y, up);
+            y[j] = x[j] - h;
+            errors(y, down);
+            y[j] = x[j];
+            for (Size i=0; i<alive_; ++i)
+                result[i][j] = (up[i]-down[i])/(2.0*h);
+        }
+        setData(x);
+    }
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::setupHelpers() const {
+        for (Size j=firstAliveHelper_; j<n_; ++j) {
+            const boost::shared_ptr<helper>& h = ts_->instruments_[j];
+            // check for valid quote
+            QL_REQUIRE(h->quote()->isValid(),
+                       io::ordinal(j+1) << " instrument (maturity: " <<
+                       h->latestDate() << ") has an invalid quote");
+            // don't try this at home!
+            // This call creates helpers, and removes "const".
+            // There is a significant interaction with observability.
+            h->setTermStructure(const_cast<Curve*>(ts_));
+        }
+    }
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::calculate() const {
+
+        // the dates are recalculated at each call since helpers
+        // might be date-relative
+        initialize();
+        setupHelpers();
+
+        Real accuracy = ts_->accuracy_;
+        validCurve_ = false;
+        jacobianCalculated_ = false;
+
+        Array x(alive_), f(alive_), trialErrors(alive_);
+        for (Size i=0; i<alive_; ++i)
+            x[i] = ts_->data_[i+1];
+        errors(x, f);
+        Real error = std::sqrt(DotProduct(f, f));
+
+        // the Jacobian is only calculated if a Newton step is needed;
+        // fresh tells whether it was calculated at the current point
+        // or obtained by Broyden updates.
+        Matrix J;
+        bool fresh = false;
+        for (Size iteration=0; error > accuracy; ++iteration) {
+            QL_REQUIRE(iteration < maxIterations_,
+                       "convergence not reached after " << iteration <<
+                       " iterations; last error " << error <<
+                       ", required accuracy " << accuracy);
+
+            if (J.rows() == 0) {
+                J = Matrix(alive_, alive_);
+                errorJacobian(x, J);
+                fresh = true;
+            }
+
+            // Newton step on the quote errors, halved until the
+            // errors decrease
+            Array step = qrSolve(J, -f);
+            Real trialError = error;
+            bool accepted = false;
+            for (Size k=0; k<30 && !accepted; ++k) {
+                if (k > 0)
+                    step /= 2.0;
+                Array trial = x + step;
+                try {
+                    errors(trial, trialErrors);
+                } catch (std::exception& e) {
+                    QL_FAIL(io::ordinal(iteration+1) << " iteration: "
+                            "failed to evaluate the helpers with "
+                            "reference date " << ts_->dates_[0] <<
+                            ": " << e.what());
+                }
+                trialError = std::sqrt(DotProduct(trialErrors,
+                                                  trialErrors));
+                accepted = (trialError < error);
+            }
+
+            if (!accepted) {
+                QL_REQUIRE(!fresh,
+                           io::ordinal(iteration+1) << " iteration: "
+                           "failed to reduce the errors (" << error <<
+                           ") with reference date " << ts_->dates_[0]);
+                // the updated Jacobian drifted too far; try again
+                // from the exact one at the current point
+                errorJacobian(x, J);
+                fresh = true;
+                continue;
+            }
+
+            // Broyden's update: J += (df - J s) s^T / (s^T s)
+            Array y = trialErrors - f - J*step;
+            Real s2 = DotProduct(step, step);
+            for (Size i=0; i<alive_; ++i)
+                for (Size j=0; j<alive_; ++j)
+                    J[i][j] += y[i]*step[j]/s2;
+            bool stepFromFresh = fresh;
+            fresh = false;
+
+            x += step;
+            f = trialErrors;
+            error = trialError;
+
+            // the curve is only accepted when the errors are within
+            // accuracy; steps that no longer move it mean a stall
+            if (error > accuracy && std::sqrt(s2) <= accuracy) {
+                QL_REQUIRE(!stepFromFresh,
+                           io::ordinal(iteration+1) << " iteration: "
+                           "stalled with error " << error <<
+                           ", required accuracy " << accuracy <<
+                           ", reference date " << ts_->dates_[0]);
+                // as above, retry from the exact Jacobian
+                errorJacobian(x, J);
+                fresh = true;
+            }
+        }
+        setData(x);
+        validCurve_ = true;
+    }
+
+    template <class Curve>
+    const Matrix& GlobalBootstrap<Curve>::jacobian() const {
+        QL_REQUIRE(validCurve_, "curve not bootstrapped");
+        if (!jacobianCalculated_) {
+            // the helpers might have been linked to another curve
+            // since the bootstrap
+            setupHelpers();
+            Array x(alive_);
+            for (Size i=0; i<alive_; ++i)
+                x[i] = ts_->data_[i+1];
+            Matrix J(alive_, alive_);
+            errorJacobian(x, J);
+            sensitivities(J);
+        }
+        return jacobian_;
+    }
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::sensitivities(const Matrix& J) const {
+        // The pillar values solve errors(x, q) = 0; their
+        // sensitivities to the quotes are therefore -J^{-1} dE/dq,
+        // and dE/dq is the identity since the errors are the quotes
+        // minus the implied quotes.
+        jacobian_ = Matrix(alive_, n_, 0.0);
+        for (Size j=0; j<alive_; ++j) {
+            Array e(alive_, 0.0);
+            e[j] = -1.0;
+            Array column = qrSolve(J, e);
+            const boost::shared_ptr<helper>& h =
+                ts_->instruments_[firstAliveHelper_+j];
+            Size k = std::find(helpers_.begin(), helpers_.end(), h)
+                   - helpers_.begin();
+            for (Size i=0; i<alive_; ++i)
+                jacobian_[i][k] = column[i];
+        }
+        jacobianCalculated_ = true;
+    }
+
+}
+
+#endif
@@ -36,32 +36,106 @@
 namespace QuantLib {
 
     //! Universal piecewise-term-structure boostrapper.
+    /*! When the curve uses a local interpolation, the pillars
+        before the first helper that changed since the last
+        calculation are not affected by the change. Unless
+        incremental updates are disabled, the bootstrap then
+        restarts from the first affected pillar and uses the
+        previous pillar values as guesses.
+
+        \note a full bootstrap is still performed when no helper
+              notified a change, when any other observable the
+              curve was registered with at construction (e.g., a
+              jump quote) notified a change, when the pillar dates
+              moved, or when the previous bootstrap failed.
+    */
     template <class Curve>
     class IterativeBootstrap {
         typedef typename Curve::traits_type Traits;
         typedef typename Curve::interpolator_type Interpolator;
       public:
-        IterativeBootstrap();
+        explicit IterativeBootstrap(bool incrementalUpdates = true);
         void setup(Curve* ts);
         void calculate() const;
       private:
+        class HelperTracker;
+        class InputTracker;
+        struct TrackerSorter;
         void initialize() const;
         Curve* ts_;
         Size n_;
         Brent firstSolver_;
         FiniteDifferenceNewtonSafe solver_;
-        mutable bool initialized_, validCurve_;
+        bool incrementalUpdates_;
+        mutable bool initialized_, validCurve_, fullBootstrap_;
         mutable Size firstAliveHelper_, alive_;
         mutable std::vector<Real> previousData_;
         mutable std::vector<boost::shared_ptr<BootstrapError<Curve> > > errors_;
+        mutable std::vector<boost::shared_ptr<HelperTracker> > trackers_;
+        boost::shared_ptr<InputTracker> otherInputs_;
+    };
+
+
+    //! records whether a helper notified a change
+    template <class Curve>
+    class IterativeBootstrap<Curve>::HelperTracker : public Observer {
+      public:
+        explicit HelperTracker(
+               const boost::shared_ptr<typename Traits::helper>& helper)
+        : helper_(helper), changed_(false) {
+            registerWith(helper_);
+        }
+        void update() { changed_ = true; }
+        bool changed() const { return changed_; }
+        void reset() { changed_ = false; }
+        const boost::shared_ptr<typename Traits::helper>& helper() const {
+            return helper_;
+        }
+      private:
+        boost::shared_ptr<typename Traits::helper> helper_;
+        bool changed_;
+    };
+
+    //! records whether any other input of the curve notified a change
+    /*! It registers with the same observables as the curve, except
+        for the helpers; changes in these (e.g., in the jumps of a
+        yield curve) can affect any pillar.
+    */
+    template <class Curve>
+    class IterativeBootstrap<Curve>::InputTracker : public Observer {
+      public:
+        InputTracker(
+             const Curve& ts,
+             const std::vector<boost::shared_ptr<typename Traits::helper> >&
+                                                                   helpers)
+        : Observer(ts), changed_(false) {
+            for (Size j=0; j<helpers.size(); ++j)
+                unregisterWith(helpers[j]);
+        }
+        void update() { changed_ = true; }
+        bool changed() const { return changed_; }
+        void reset() { changed_ = false; }
+      private:
+        bool changed_;
+    };
+
+    template <class Curve>
+    struct IterativeBootstrap<Curve>::TrackerSorter {
+        bool operator()(const boost::shared_ptr<HelperTracker>& t1,
+                        const boost::shared_ptr<HelperTracker>& t2) const {
+            return detail::BootstrapHelperSorter()(t1->helper(),
+                                                   t2->helper());
+        }
     };
 
 
     // template definitions
 
     template <class Curve>
-    IterativeBootstrap<Curve>::IterativeBootstrap()
-        : ts_(0), initialized_(false), validCurve_(false) {}
+    IterativeBootstrap<Curve>::IterativeBootstrap(bool incrementalUpdates)
+    : ts_(0), incrementalUpdates_(incrementalUpdates),
+      initialized_(false), validCurve_(false), fullBootstrap_(true),
+      firstAliveHelper_(0), alive_(0) {}
 
     template <class Curve>
     void IterativeBootstrap<Curve>::setup(Curve* ts) {
@@ -71,6 +145,15 @@ namespace QuantLib {
         for (Size j=0; j<n_; ++j)
             ts_->registerWith(ts_->instruments_[j]);
 
+        if (incrementalUpdates_ && !Interpolator::global) {
+            trackers_.resize(n_);
+            for (Size j=0; j<n_; ++j)
+                trackers_[j] = boost::shared_ptr<HelperTracker>(
+                                 new HelperTracker(ts_->instruments_[j]));
+            otherInputs_ = boost::shared_ptr<InputTracker>(
+                             new InputTracker(*ts_, ts_->instruments_));
+        }
+
         // do not initialize yet: instruments could be invalid here
         // but valid later when bootstrapping is actually required
     }
@@ -80,9 +163,12 @@ namespace QuantLib {
         // ensure helpers are sorted
         std::sort(ts_->instruments_.begin(), ts_->instruments_.end(),
                   detail::BootstrapHelperSorter());
+        std::sort(trackers_.begin(), trackers_.end(), TrackerSorter());
 
         // skip expired helpers
         Date firstDate = Traits::initialDate(ts_);
+        Size previousFirstAliveHelper = firstAliveHelper_;
+        std::vector<Date> previousDates = ts_->dates_;
         QL_REQUIRE(ts_->instruments_[n_-1]->latestDate()>firstDate,
                    "all instruments expired");
         firstAliveHelper_ = 0;
@@ -123,7 +209,13 @@ namespace QuantLib {
             // because, e.g., of interpolation's early checks
             ts_->data_ = std::vector<Real>(alive_+1, Traits::initialValue(ts_));
             previousData_.resize(alive_+1);
+            fullBootstrap_ = true;
         }
+        // the previous pillar values can only be kept if the
+        // pillars didn't move
+        if (!initialized_ || firstAliveHelper_ != previousFirstAliveHelper
+            || dates != previousDates)
+            fullBootstrap_ = true;
         initialized_ = true;
     }
 
@@ -138,6 +230,19 @@ namespace QuantLib {
         if (!initialized_ || ts_->moving_)
             initialize();
 
+        // with a local interpolation, the pillars before the first
+        // changed helper are not affected and can be kept
+        Size firstPillar = 1;
+        if (!trackers_.empty() && validCurve_ && !fullBootstrap_
+            && !otherInputs_->changed()) {
+            Size j = firstAliveHelper_;
+            while (j<n_ && !trackers_[j]->changed())
+                ++j;
+            if (j<n_)
+                firstPillar = j-firstAliveHelper_+1;
+        }
+        fullBootstrap_ = true;
+
         // setup helpers
         for (Size j=firstAliveHelper_; j<n_; ++j) {
             const boost::shared_ptr<typename Traits::helper>& helper =
@@ -161,7 +266,7 @@ namespace QuantLib {
         for (Size iteration=0; ; ++iteration) {
             previousData_ = ts_->data_;
 
-            for (Size i=1; i<=alive_; ++i) { // pillar loop
+            for (Size i=firstPillar; i<=alive_; ++i) { // pillar loop
 
                 bool validData = validCurve_ || iteration>0;
 
@@ -229,6 +334,15 @@ namespace QuantLib {
                        ", required accuracy " << accuracy);
         }
         validCurve_ = true;
+
+        // changes are tracked from here on; notifications sent while
+        // bootstrapping (e.g., when helpers were linked to the curve)
+        // are discarded
+        for (Size j=0; j<trackers_.size(); ++j)
+            trackers_[j]->reset();
+        if (otherInputs_)
+            otherInputs_->reset();
+        fullBootstrap_ = false;
     }
 
 }
@@ -72,6 +72,7 @@ namespace QuantLib {
         const std::vector<DiscountFactor>& discounts() const;
         std::vector<std::pair<Date, Real> > nodes() const;
         //@}
+        using YieldTermStructure::discounts;
       protected:
         InterpolatedDiscountCurve(
             const DayCounter&,
@@ -94,6 +95,7 @@ namespace QuantLib {
         //! \name YieldTermStructure implementation
         //@{
         DiscountFactor discountImpl(Time) const;
+        void discountsImpl(const std::vector<Time>&, Array&) const;
         //@}
         mutable std::vector<Date> dates_;
       private:
@@ -165,6 +167,23 @@ namespace QuantLib {
         return dMax * std::exp(- instFwdMax * (t-tMax));
     }
 
+    template <class T>
+    void InterpolatedDiscountCurve<T>::discountsImpl(
+                                            const std::vector<Time>& times,
+                                            Array& result) const {
+        // as in discountImpl; the interval found for each time is
+        // the starting point for the next, so that sorted times are
+        // located in a single walk over the interpolation grid
+        Size hint = 0;
+        for (Size i=0; i<times.size(); ++i) {
+            if (times[i] <= this->times_.back())
+                result[i] = this->interpolation_.value(times[i], hint, true);
+            else
+                result[i] =
+                    InterpolatedDiscountCurve<T>::discountImpl(times[i]);
+        }
+    }
+
     template <class T>
     InterpolatedDiscountCurve<T>::InterpolatedDiscountCurve(
                                     const DayCounter& dayCounter,
@@ -84,6 +84,7 @@ namespace QuantLib {
         //! \name YieldTermStructure implementation
         //@{
         DiscountFactor discountImpl(Time) const;
+        void discountsImpl(const std::vector<Time>&, Array&) const;
         //@}
 
         Handle<Quote> forward_;
@@ -103,6 +104,13 @@ namespace QuantLib {
         calculate();
         return rate_.discountFactor(t);
     }
+
+    inline void FlatForward::discountsImpl(const std::vector<Time>& times,
+                                           Array& result) const {
+        calculate();
+        for (Size i=0; i<times.size(); ++i)
+            result[i] = rate_.discountFactor(times[i]);
+    }
   
     inline void FlatForward::performCalculations() const {
         rate_ = InterestRate(forward_->value(), dayCounter(),
@@ -28,6 +28,7 @@
 
 #include <ql/termstructures/iterativebootstrap.hpp>
 #include <ql/termstructures/localbootstrap.hpp>
+#include <ql/termstructures/globalbootstrap.hpp>
 #include <ql/termstructures/yield/bootstraptraits.hpp>
 #include <ql/patterns/lazyobject.hpp>
 
@@ -167,6 +168,14 @@ namespace QuantLib {
         const std::vector<Real>& data() const;
         std::vector<std::pair<Date, Real> > nodes() const;
         //@}
+        //! \name Bootstrap results
+        //@{
+        /*! sensitivities of the curve data to the helper quotes;
+            only available with bootstrappers providing them, e.g.,
+            GlobalBootstrap.
+        */
+        const Matrix& jacobian() const;
+        //@}
         //! \name Observer interface
         //@{
         void update();
@@ -178,6 +187,7 @@ namespace QuantLib {
         //@}
         // methods
         DiscountFactor discountImpl(Time) const;
+        void discountsImpl(const std::vector<Time>&, Array&) const;
         // data members
         std::vector<boost::shared_ptr<typename Traits::helper> > instruments_;
         Real accuracy_;
@@ -226,6 +236,12 @@ namespace QuantLib {
         return base_curve::nodes();
     }
 
+    template <class C, class I, template <class> class B>
+    inline const Matrix& PiecewiseYieldCurve<C,I,B>::jacobian() const {
+        calculate();
+        return bootstrap_.jacobian();
+    }
+
     template <class C, class I, template <class> class B>
     inline void PiecewiseYieldCurve<C,I,B>::update() {
 
@@ -247,6 +263,14 @@ namespace QuantLib {
         return base_curve::discountImpl(t);
     }
 
+    template <class C, class I, template <class> class B>
+    inline void PiecewiseYieldCurve<C,I,B>::discountsImpl(
+                                            const std::vector<Time>& times,
+                                            Array& result) const {
+        calculate();
+        base_curve::discountsImpl(times, result);
+    }
+
     template <class C, class I, template <class> class B>
     inline void PiecewiseYieldCurve<C,I,B>::performCalculations() const {
         // just delegate to the bootstrapper
@@ -73,6 +73,7 @@ namespace QuantLib {
         const std::vector<Rate>& zeroRates() const;
         std::vector<std::pair<Date, Real> > nodes() const;
         //@}
+        using YieldTermStructure::zeroRates;
       protected:
         InterpolatedZeroCurve(
             const DayCounter&,
@@ -96,6 +97,10 @@ namespace QuantLib {
         //@{
         Rate zeroYieldImpl(Time t) const;
         //@}
+        //! \name YieldTermStructure implementation
+        //@{
+        void discountsImpl(const std::vector<Time>&, Array&) const;
+        //@}
         mutable std::vector<Date> dates_;
       private:
         void initialize();
@@ -160,6 +165,28 @@ namespace QuantLib {
         return (zMax * tMax + instFwdMax * (t-tMax)) / t;
     }
 
+    template <class T>
+    void InterpolatedZeroCurve<T>::discountsImpl(
+                                            const std::vector<Time>& times,
+                                            Array& result) const {
+        // as in ZeroYieldStructure::discountImpl, with non-virtual
+        // calls; the interval found for each time is the starting
+        // point for the next, so that sorted times are located in a
+        // single walk over the interpolation grid
+        Size hint = 0;
+        for (Size i=0; i<times.size(); ++i) {
+            Time t = times[i];
+            if (t == 0.0) {
+                result[i] = 1.0;
+            } else {
+                Rate r = (t <= this->times_.back()) ?
+                    this->interpolation_.value(t, hint, true) :
+                    InterpolatedZeroCurve<T>::zeroYieldImpl(t);
+                result[i] = DiscountFactor(std::exp(-r*t));
+            }
+        }
+    }
+
     template <class T>
     InterpolatedZeroCurve<T>::InterpolatedZeroCurve(
                                     const DayCounter& dayCounter,
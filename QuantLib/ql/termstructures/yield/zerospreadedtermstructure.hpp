@@ -65,6 +65,8 @@ namespace QuantLib {
         //! returns the spreaded forward rate
         /* This method must disappear should the spread become a curve */
         Rate forwardImpl(Time) const;
+        //! returns the spreaded discount factors
+        void discountsImpl(const std::vector<Time>&, Array&) const;
       private:
         Handle<YieldTermStructure> originalCurve_;
         Handle<Quote> spread_;
@@ -124,6 +126,27 @@ namespace QuantLib {
         return spreadedRate.equivalentRate(Continuous, NoFrequency, t);
     }
 
+    inline void ZeroSpreadedTermStructure::discountsImpl(
+                                            const std::vector<Time>& times,
+                                            Array& result) const {
+        // the zero rates of the original curve are fetched at once
+        originalCurve_->zeroRates(times, result, comp_, freq_, true);
+        DayCounter dc = originalCurve_->dayCounter();
+        Spread spread = spread_->value();
+        for (Size i=0; i<times.size(); ++i) {
+            Time t = times[i];
+            if (t == 0.0) {
+                result[i] = 1.0;
+            } else {
+                InterestRate spreadedRate(result[i] + spread,
+                                          dc, comp_, freq_);
+                Rate r = spreadedRate.equivalentRate(Continuous,
+                                                     NoFrequency, t);
+                result[i] = DiscountFactor(std::exp(-r*t));
+            }
+        }
+    }
+
     inline Rate ZeroSpreadedTermStructure::forwardImpl(Time t) const {
         return originalCurve_->forwardRate(t, t, comp_, freq_, true)
             + spread_->value();
@@ -21,6 +21,7 @@
 
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -93,6 +94,37 @@ namespace QuantLib {
         if (jumps_.empty())
             return discountImpl(t);
 
+        return jumpEffect(t) * discountImpl(t);
+    }
+
+    void YieldTermStructure::discounts(const std::vector<Time>& times,
+                                       Array& result,
+                                       bool extrapolate) const {
+        if (result.size() != times.size())
+            result = Array(times.size());
+        if (times.empty())
+            return;
+
+        checkRange(*std::min_element(times.begin(), times.end()),
+                   extrapolate);
+        checkRange(*std::max_element(times.begin(), times.end()),
+                   extrapolate);
+
+        discountsImpl(times, result);
+
+        if (!jumps_.empty()) {
+            for (Size i=0; i<times.size(); ++i)
+                result[i] *= jumpEffect(times[i]);
+        }
+    }
+
+    void YieldTermStructure::discountsImpl(const std::vector<Time>& times,
+                                           Array& result) const {
+        for (Size i=0; i<times.size(); ++i)
+            result[i] = discountImpl(times[i]);
+    }
+
+    DiscountFactor YieldTermStructure::jumpEffect(Time t) const {
         DiscountFactor jumpEffect = 1.0;
         for (Size i=0; i<nJumps_; ++i) {
             if (jumpTimes_[i]>0 && jumpTimes_[i]<t) {
@@ -105,8 +137,7 @@ namespace QuantLib {
                 jumpEffect *= thisJump;
             }
         }
-        return jumpEffect * discountImpl(t);
-
+        return jumpEffect;
     }
 
     InterestRate YieldTermStructure::zeroRate(const Date& d,
@@ -139,6 +170,23 @@ namespace QuantLib {
                                          t);
     }
 
+    void YieldTermStructure::zeroRates(const std::vector<Time>& times,
+                                       Array& result,
+                                       Compounding comp,
+                                       Frequency freq,
+                                       bool extrapolate) const {
+        std::vector<Time> t(times);
+        for (Size i=0; i<t.size(); ++i) {
+            if (t[i]==0.0)
+                t[i] = dt;
+        }
+        discounts(t, result, extrapolate);
+        DayCounter dc = dayCounter();
+        for (Size i=0; i<t.size(); ++i)
+            result[i] = InterestRate::impliedRate(1.0/result[i],
+                                                  dc, comp, freq, t[i]);
+    }
+
     InterestRate YieldTermStructure::forwardRate(const Date& d1,
                                                  const Date& d2,
                                                  const DayCounter& dayCounter,
@@ -184,4 +232,31 @@ namespace QuantLib {
                                          t2-t1);
     }
 
+    void YieldTermStructure::forwardRates(const std::vector<Time>& times,
+                                          Array& result,
+                                          Compounding comp,
+                                          Frequency freq,
+                                          bool extrapolate) const {
+        Size n = times.size() > 1 ? times.size()-1 : 0;
+        if (result.size() != n)
+            result = Array(n);
+        if (n == 0)
+            return;
+
+        Array d;
+        discounts(times, d, extrapolate);
+        DayCounter dc = dayCounter();
+        for (Size i=0; i<n; ++i) {
+            Time t1 = times[i], t2 = times[i+1];
+            if (t2==t1) {
+                result[i] = forwardRate(t1, t2, comp, freq, extrapolate);
+            } else {
+                QL_REQUIRE(t2>t1, "t2 (" << t2 << ") < t1 (" << t1 << ")");
+                result[i] = InterestRate::impliedRate(
+                                         d[i]/d[i+1],
+                                         dc, comp, freq, t2-t1);
+            }
+        }
+    }
+
 }
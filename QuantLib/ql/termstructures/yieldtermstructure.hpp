@@ -29,6 +29,7 @@
 #include <ql/termstructure.hpp>
 #include <ql/interestrate.hpp>
 #include <ql/quote.hpp>
+#include <ql/math/array.hpp>
 #include <vector>
 
 namespace QuantLib {
@@ -77,6 +78,15 @@ namespace QuantLib {
         */
         DiscountFactor discount(Time t,
                                 bool extrapolate = false) const;
+        /*! Discount factors for a set of times, stored in the
+            result array which is resized if needed.  The range is
+            checked once for the whole set, and derived classes can
+            override the batch calculation; it is most efficient
+            when the times are sorted.
+        */
+        void discounts(const std::vector<Time>& times,
+                       Array& result,
+                       bool extrapolate = false) const;
         //@}
 
         /*! \name Zero-yield rates
@@ -103,6 +113,16 @@ namespace QuantLib {
                               Compounding comp,
                               Frequency freq = Annual,
                               bool extrapolate = false) const;
+
+        /*! Zero-yield rates for a set of times, stored in the result
+            array which is resized if needed. The rates have the
+            same day-counting rule used by the term structure.
+        */
+        void zeroRates(const std::vector<Time>& times,
+                       Array& result,
+                       Compounding comp,
+                       Frequency freq = Annual,
+                       bool extrapolate = false) const;
         //@}
 
         /*! \name Forward rates
@@ -144,6 +164,18 @@ namespace QuantLib {
                                  Compounding comp,
                                  Frequency freq = Annual,
                                  bool extrapolate = false) const;
+
+        /*! Forward rates between consecutive times of a set, stored
+            in the result array which is resized if needed; the
+            i-th rate is the one between the i-th and the (i+1)-th
+            time. The rates have the same day-counting rule used by
+            the term structure.
+        */
+        void forwardRates(const std::vector<Time>& times,
+                          Array& result,
+                          Compounding comp,
+                          Frequency freq = Annual,
+                          bool extrapolate = false) const;
         //@}
 
         //! \name Jump inspectors
@@ -167,10 +199,17 @@ namespace QuantLib {
         //@{
         //! discount factor calculation
         virtual DiscountFactor discountImpl(Time) const = 0;
+        /*! discount factors for a set of times; the result array
+            has already the correct size. The default implementation
+            calls discountImpl for each time.
+        */
+        virtual void discountsImpl(const std::vector<Time>& times,
+                                   Array& result) const;
         //@}
       private:
         // methods
         void setJumps();
+        DiscountFactor jumpEffect(Time t) const;
         // data members
         std::vector<Handle<Quote> > jumps_;
         std::vector<Date> jumpDates_;
@@ -21,9 +21,144 @@
 
 #include <ql/time/calendar.hpp>
 #include <ql/errors.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
+    namespace detail {
+
+        namespace {
+
+            Size bitCount(boost::uint64_t x) {
+                x = x - ((x >> 1) & UINT64_C(0x5555555555555555));
+                x = (x & UINT64_C(0x3333333333333333))
+                    + ((x >> 2) & UINT64_C(0x3333333333333333));
+                x = (x + (x >> 4)) & UINT64_C(0x0f0f0f0f0f0f0f0f);
+                return Size((x * UINT64_C(0x0101010101010101)) >> 56);
+            }
+
+        }
+
+        BusinessDayCache::BusinessDayCache()
+        : first_(Date::minDate().serialNumber()) {
+            // one more bit than the number of dates, so that
+            // rank() can be called on the date after the last one
+            const BigInteger n = Date::maxDate().serialNumber() - first_ + 2;
+            bits_.resize((n + 63)/64, 0);
+            counts_.resize(bits_.size() + 1, 0);
+        }
+
+        void BusinessDayCache::set(const Date& d, bool isBusinessDay) {
+            const BigInteger i = d.serialNumber() - first_;
+            const boost::uint64_t mask = boost::uint64_t(1) << (i & 63);
+            const bool wasBusinessDay = (bits_[i >> 6] & mask) != 0;
+            if (wasBusinessDay == isBusinessDay)
+                return;
+            assign(d, isBusinessDay);
+            updateCounts(Size(i >> 6));
+        }
+
+        void BusinessDayCache::assign(const Date& d, bool isBusinessDay) {
+            const BigInteger i = d.serialNumber() - first_;
+            const boost::uint64_t mask = boost::uint64_t(1) << (i & 63);
+            if (isBusinessDay)
+                bits_[i >> 6] |= mask;
+            else
+                bits_[i >> 6] &= ~mask;
+        }
+
+        void BusinessDayCache::recount() {
+            updateCounts(0);
+        }
+
+        BigInteger BusinessDayCache::rank(BigInteger serialNumber) const {
+            const BigInteger i = serialNumber - first_;
+            const boost::uint64_t mask = (boost::uint64_t(1) << (i & 63)) - 1;
+            return counts_[i >> 6] + BigInteger(bitCount(bits_[i >> 6] & mask));
+        }
+
+        Date BusinessDayCache::select(BigInteger rank) const {
+            QL_REQUIRE(rank >= 0 && rank < size(),
+                       "business day out of the range of valid dates");
+            // last block starting with at most 'rank' business days
+            const Size block = Size(std::upper_bound(counts_.begin(),
+                                                     counts_.end()-1,
+                                                     rank)
+                                    - counts_.begin()) - 1;
+            boost::uint64_t bits = bits_[block];
+            for (BigInteger k = counts_[block]; k < rank; ++k)
+                bits &= bits - 1;   // clear the lowest set bit
+            Size bit = 0;
+            while (((bits >> bit) & 1) == 0)
+                ++bit;
+            return Date(first_ + BigInteger(block)*64 + BigInteger(bit));
+        }
+
+        BigInteger BusinessDayCache::size() const {
+            return counts_.back();
+        }
+
+        void BusinessDayCache::intersect(const BusinessDayCache& other) {
+            for (Size i=0; i<bits_.size(); ++i)
+                bits_[i] &= other.bits_[i];
+            recount();
+        }
+
+        void BusinessDayCache::unite(const BusinessDayCache& other) {
+            for (Size i=0; i<bits_.size(); ++i)
+                bits_[i] |= other.bits_[i];
+            recount();
+        }
+
+        void BusinessDayCache::updateCounts(Size fromBlock) {
+            for (Size i=fromBlock; i<bits_.size(); ++i)
+                counts_[i+1] = counts_[i] + BigInteger(bitCount(bits_[i]));
+        }
+
+    }
+
+    boost::shared_ptr<detail::BusinessDayCache>
+    Calendar::Impl::businessDays() const {
+        boost::shared_ptr<detail::BusinessDayCache> cache(
+                                              new detail::BusinessDayCache);
+        // fill the bitmap first and count once; updating the counts
+        // at each date would take quadratic time
+        const Date last = Date::maxDate();
+        for (Date d = Date::minDate(); d < last; ++d)
+            cache->assign(d, isBusinessDay(d));
+        cache->assign(last, isBusinessDay(last));
+        cache->recount();
+        return cache;
+    }
+
+    boost::shared_ptr<detail::BusinessDayCache>
+    Calendar::businessDays(const Calendar& c) {
+        if (c.impl_->businessDayCache)
+            return c.impl_->businessDayCache;
+        boost::shared_ptr<detail::BusinessDayCache> cache =
+            c.impl_->businessDays();
+        std::set<Date>::const_iterator i;
+        for (i = c.impl_->addedHolidays.begin();
+             i != c.impl_->addedHolidays.end(); ++i)
+            cache->assign(*i, false);
+        for (i = c.impl_->removedHolidays.begin();
+             i != c.impl_->removedHolidays.end(); ++i)
+            cache->assign(*i, true);
+        cache->recount();
+        return cache;
+    }
+
+    void Calendar::enableBusinessDayCache() {
+        QL_REQUIRE(impl_, "no implementation provided");
+        if (!impl_->businessDayCache)
+            impl_->businessDayCache = businessDays(*this);
+    }
+
+    void Calendar::disableBusinessDayCache() {
+        QL_REQUIRE(impl_, "no implementation provided");
+        impl_->businessDayCache.reset();
+    }
+
     void Calendar::addHoliday(const Date& d) {
         // if d was a genuine holiday previously removed, revert the change
         impl_->removedHolidays.erase(d);
@@ -31,6 +166,9 @@ namespace QuantLib {
         // Otherwise, add it.
         if (impl_->isBusinessDay(d))
             impl_->addedHolidays.insert(d);
+        if (impl_->businessDayCache)
+            impl_->businessDayCache->set(d, false);
+        ++impl_->holidayRevision;
     }
 
     void Calendar::removeHoliday(const Date& d) {
@@ -40,6 +178,9 @@ namespace QuantLib {
         // Otherwise, add it.
         if (!impl_->isBusinessDay(d))
             impl_->removedHolidays.insert(d);
+        if (impl_->businessDayCache)
+            impl_->businessDayCache->set(d, true);
+        ++impl_->holidayRevision;
     }
 
     Date Calendar::adjust(const Date& d,
@@ -77,6 +218,13 @@ namespace QuantLib {
         QL_REQUIRE(d!=Date(), "null date");
         if (n == 0) {
             return adjust(d,c);
+        } else if (unit == Days && impl_->businessDayCache) {
+            const detail::BusinessDayCache& cache = *impl_->businessDayCache;
+            // the n-th business day after d, or the (-n)-th before it
+            if (n > 0)
+                return cache.select(cache.rank(d.serialNumber()+1) + n - 1);
+            else
+                return cache.select(cache.rank(d.serialNumber()) + n);
         } else if (unit == Days) {
             Date d1 = d;
             if (n > 0) {
@@ -120,6 +268,21 @@ namespace QuantLib {
                                              const Date& to,
                                              bool includeFirst,
                                              bool includeLast) const {
+        if (impl_->businessDayCache) {
+            const detail::BusinessDayCache& cache = *impl_->businessDayCache;
+            if (from == to)
+                return 0;
+            const Date& first = std::min(from, to);
+            const Date& last = std::max(from, to);
+            BigInteger wd = cache.rank(last.serialNumber()+1)
+                          - cache.rank(first.serialNumber());
+            if (!includeFirst && cache.isBusinessDay(from))
+                --wd;
+            if (!includeLast && cache.isBusinessDay(to))
+                --wd;
+            return from > to ? -wd : wd;
+        }
+
         BigInteger wd = 0;
         if (from != to) {
             if (from < to) {
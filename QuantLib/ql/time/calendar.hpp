@@ -29,6 +29,7 @@
 #include <ql/time/date.hpp>
 #include <ql/time/businessdayconvention.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/cstdint.hpp>
 #include <set>
 #include <vector>
 #include <string>
@@ -37,6 +38,47 @@ namespace QuantLib {
 
     class Period;
 
+    namespace detail {
+
+        //! business days of a calendar over the range of valid dates
+        /*! Business days are stored as a bitmap, together with the
+            number of business days preceding each 64-day block, so
+            that counting and finding business days take constant or
+            logarithmic time.
+        */
+        class BusinessDayCache {
+          public:
+            //! all dates are initially holidays
+            BusinessDayCache();
+            bool isBusinessDay(const Date& d) const;
+            //! sets a single date, updating the counts that follow it
+            void set(const Date& d, bool isBusinessDay);
+            /*! sets a date without updating the counts, which must
+                then be recalculated by recount(); this is meant for
+                filling the cache in one pass.
+            */
+            void assign(const Date& d, bool isBusinessDay);
+            //! recalculates the counts after calls to assign()
+            void recount();
+            //! number of business days before the date with the given serial
+            BigInteger rank(BigInteger serialNumber) const;
+            //! date of the business day with the given rank
+            Date select(BigInteger rank) const;
+            //! total number of business days
+            BigInteger size() const;
+            //! keeps the business days that are also in the given cache
+            void intersect(const BusinessDayCache&);
+            //! adds the business days in the given cache
+            void unite(const BusinessDayCache&);
+          private:
+            void updateCounts(Size fromBlock);
+            BigInteger first_;
+            std::vector<boost::uint64_t> bits_;
+            std::vector<BigInteger> counts_;
+        };
+
+    }
+
     //! %calendar class
     /*! This class provides methods for determining whether a date is a
         business day or a holiday for a given market, and for
@@ -60,13 +102,25 @@ namespace QuantLib {
         //! abstract base class for calendar implementations
         class Impl {
           public:
+            Impl() : holidayRevision(0) {}
             virtual ~Impl() {}
             virtual std::string name() const = 0;
             virtual bool isBusinessDay(const Date&) const = 0;
             virtual bool isWeekend(Weekday) const = 0;
+            /*! returns the business days of the implementation,
+                not including added and removed holidays; the default
+                implementation checks each date in turn.
+            */
+            virtual boost::shared_ptr<detail::BusinessDayCache>
+            businessDays() const;
             std::set<Date> addedHolidays, removedHolidays;
+            Size holidayRevision;
+            boost::shared_ptr<detail::BusinessDayCache> businessDayCache;
         };
         boost::shared_ptr<Impl> impl_;
+        //! business days of the given calendar, cached or not
+        static boost::shared_ptr<detail::BusinessDayCache>
+        businessDays(const Calendar&);
       public:
         /*! The default constructor returns a calendar with a null
             implementation, which is therefore unusable except as a
@@ -106,6 +160,11 @@ namespace QuantLib {
         void addHoliday(const Date&);
         /*! Removes a date from the set of holidays for the given calendar. */
         void removeHoliday(const Date&);
+        /*! Returns a number that changes whenever holidays are added
+            to or removed from the calendar, so that figures
+            calculated from it can be checked for staleness.
+        */
+        Size holidayRevision() const;
 
         //! Returns the holidays between two dates
         static std::vector<Date> holidayList(const Calendar& calendar,
@@ -144,6 +203,27 @@ namespace QuantLib {
                                        bool includeLast = false) const;
         //@}
 
+        //! \name Business-day cache
+        /*! When enabled, the business days of the calendar over the
+            whole range of valid dates are precomputed, so that
+            isBusinessDay() and businessDaysBetween() take constant
+            time and advance() by a number of days takes logarithmic
+            time.  The cache is kept up to date by addHoliday() and
+            removeHoliday().
+
+            \warning The cache is shared by all the calendars sharing
+                     the same implementation, e.g., all instances of
+                     TARGET.  The cache of a JointCalendar is built
+                     from the calendars it joins and is not updated
+                     when holidays are later added to or removed from
+                     them.
+        */
+        //@{
+        void enableBusinessDayCache();
+        void disableBusinessDayCache();
+        bool businessDayCacheEnabled() const;
+        //@}
+
       protected:
         //! partial calendar implementation
         /*! This class provides the means of determining the Easter
@@ -193,6 +273,8 @@ namespace QuantLib {
     }
 
     inline bool Calendar::isBusinessDay(const Date& d) const {
+        if (impl_->businessDayCache)
+            return impl_->businessDayCache->isBusinessDay(d);
         if (impl_->addedHolidays.find(d) != impl_->addedHolidays.end())
             return false;
         if (impl_->removedHolidays.find(d) != impl_->removedHolidays.end())
@@ -216,6 +298,19 @@ namespace QuantLib {
         return impl_->isWeekend(w);
     }
 
+    inline Size Calendar::holidayRevision() const {
+        return impl_->holidayRevision;
+    }
+
+    inline bool Calendar::businessDayCacheEnabled() const {
+        return impl_->businessDayCache.get() != 0;
+    }
+
+    inline bool detail::BusinessDayCache::isBusinessDay(const Date& d) const {
+        const BigInteger i = d.serialNumber() - first_;
+        return (bits_[i >> 6] >> (i & 63)) & 1;
+    }
+
     inline bool operator==(const Calendar& c1, const Calendar& c2) {
         return (c1.empty() && c2.empty())
             || (!c1.empty() && !c2.empty() && c1.name() == c2.name());
@@ -114,6 +114,27 @@ namespace QuantLib {
         }
     }
 
+    boost::shared_ptr<detail::BusinessDayCache>
+    JointCalendar::Impl::businessDays() const {
+        // copy, since the first cache might be the one of a calendar
+        boost::shared_ptr<detail::BusinessDayCache> cache(
+                                new detail::BusinessDayCache(
+                                    *Calendar::businessDays(calendars_[0])));
+        for (Size i=1; i<calendars_.size(); ++i) {
+            switch (rule_) {
+              case JoinHolidays:
+                cache->intersect(*Calendar::businessDays(calendars_[i]));
+                break;
+              case JoinBusinessDays:
+                cache->unite(*Calendar::businessDays(calendars_[i]));
+                break;
+              default:
+                QL_FAIL("unknown joint calendar rule");
+            }
+        }
+        return cache;
+    }
+
 
     JointCalendar::JointCalendar(const Calendar& c1,
                                  const Calendar& c2,
@@ -65,6 +65,7 @@ namespace QuantLib {
             std::string name() const;
             bool isWeekend(Weekday) const;
             bool isBusinessDay(const Date&) const;
+            boost::shared_ptr<detail::BusinessDayCache> businessDays() const;
           private:
             JointCalendarRule rule_;
             std::vector<Calendar> calendars_;
@@ -19,54 +19,51 @@
 */
 
 #include <ql/time/daycounters/business252.hpp>
-#include <map>
+#include <ql/utilities/null.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
     namespace {
 
-        typedef std::map<Year, std::map<Month, BigInteger> > Cache;
-        typedef std::map<Year, BigInteger> OuterCache;
-        
-        std::map<std::string, Cache> monthlyFigures_;
-        std::map<std::string, OuterCache> yearlyFigures_;
-
-        bool sameYear(const Date& d1, const Date& d2) {
-            return d1.year() == d2.year();
+        Size yearIndex(Year y) {
+            return Size(y - Date::minDate().year());
         }
 
         bool sameMonth(const Date& d1, const Date& d2) {
             return d1.year() == d2.year() && d1.month() == d2.month();
         }
 
-        BigInteger businessDays(Cache& cache,
-                                const Calendar& calendar,
-                                Month month, Year year) {
-            if (cache[year][month] == 0) {
-                // calculate and store.
-                Date d1 = Date(1,month,year);
-                Date d2 = d1 + 1*Months;
-                cache[year][month] = calendar.businessDaysBetween(d1, d2);
-            }
-            return cache[year][month];
-        }
+    }
 
-        BigInteger businessDays(OuterCache& outerCache,
-                                Cache& cache,
-                                const Calendar& calendar,
-                                Year year) {
-            if (outerCache[year] == 0) {
-                // calculate and store.
-                BigInteger total = 0;
-                for (Integer i=1; i<=12; ++i) {
-                    total += businessDays(cache,calendar,
-                                          Month(i), year);
-                }
-                outerCache[year] = total;
-            }
-            return outerCache[year];
+    Business252::Impl::Impl(const Calendar& c)
+    : calendar_(c), monthlyFigures_((yearIndex(Date::maxDate().year())+1)*12,
+                                    Null<BigInteger>()),
+      yearlyFigures_(yearIndex(Date::maxDate().year())+1,
+                     Null<BigInteger>()),
+      holidayRevision_(c.holidayRevision()) {}
+
+    BigInteger Business252::Impl::businessDays(Month m, Year y) const {
+        BigInteger& figure = monthlyFigures_[yearIndex(y)*12 + Size(m) - 1];
+        if (figure == Null<BigInteger>()) {
+            // calculate and store.
+            Date d1 = Date(1,m,y);
+            Date d2 = d1 + 1*Months;
+            figure = calendar_.businessDaysBetween(d1, d2);
         }
+        return figure;
+    }
 
+    BigInteger Business252::Impl::businessDays(Year y) const {
+        BigInteger& figure = yearlyFigures_[yearIndex(y)];
+        if (figure == Null<BigInteger>()) {
+            // calculate and store.
+            BigInteger total = 0;
+            for (Integer i=1; i<=12; ++i)
+                total += businessDays(Month(i), y);
+            figure = total;
+        }
+        return figure;
     }
 
     std::string Business252::Impl::name() const {
@@ -83,55 +80,39 @@ namespace QuantLib {
             // for first included, last excluded and might have to be
             // changed going the other way.)
             return calendar_.businessDaysBetween(d1, d2);
-        } else if (sameYear(d1,d2)) {
-            Cache& cache = monthlyFigures_[calendar_.name()];
-            BigInteger total = 0;
-            Date d;
-            // first, we get to the beginning of next month.
-            d = Date(1,d1.month(),d1.year()) + 1*Months;
-            total += calendar_.businessDaysBetween(d1, d);
-            // then, we add any whole months (whose figures might be
-            // cached already) in the middle of our period.
-            while (!sameMonth(d,d2)) {
-                total += businessDays(cache, calendar_,
-                                      d.month(), d.year());
-                d += 1*Months;
-            }
-            // finally, we get to the end of the period.
-            total += calendar_.businessDaysBetween(d, d2);
-            return total;
-        } else {
-            Cache& cache = monthlyFigures_[calendar_.name()];
-            OuterCache& outerCache = yearlyFigures_[calendar_.name()];
-            BigInteger total = 0;
-            Date d;
-            // first, we get to the beginning of next year.
-            // The first bit gets us to the end of this month...
-            d = Date(1,d1.month(),d1.year()) + 1*Months;
-            total += calendar_.businessDaysBetween(d1, d);
-            // ...then we add any remaining months, possibly cached
-            for (Integer m = Integer(d1.month())+1; m <= 12; ++m) {
-                total += businessDays(cache, calendar_,
-                                      Month(m), d.year());
-            }
-            // then, we add any whole year in the middle of our period.
-            d = Date(1,January,d1.year()+1);
-            while (!sameYear(d,d2)) {
-                total += businessDays(outerCache, cache,
-                                      calendar_, d.year());
-                d += 1*Years;
+        }
+
+        // first, we get to the beginning of next month...
+        Date d = Date(1,d1.month(),d1.year()) + 1*Months;
+        BigInteger total = calendar_.businessDaysBetween(d1, d);
+        // ...then we add the whole months and years in the middle
+        // of our period, calculating their figures if needed...
+        const Date last = Date(1,d2.month(),d2.year());
+        {
+            #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN) || \
+                defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+            boost::mutex::scoped_lock lock(mutex_);
+            #endif
+            if (calendar_.holidayRevision() != holidayRevision_) {
+                std::fill(monthlyFigures_.begin(), monthlyFigures_.end(),
+                          Null<BigInteger>());
+                std::fill(yearlyFigures_.begin(), yearlyFigures_.end(),
+                          Null<BigInteger>());
+                holidayRevision_ = calendar_.holidayRevision();
             }
-            // finally, we get to the end of the period.
-            // First, we add whole months...
-            for (Integer m = 1; m<Integer(d2.month()); ++m) {
-                total += businessDays(cache, calendar_,
-                                      Month(m), d2.year());
+            while (d < last) {
+                if (d.month() == January && d.year() < last.year()) {
+                    total += businessDays(d.year());
+                    d += 1*Years;
+                } else {
+                    total += businessDays(d.month(), d.year());
+                    d += 1*Months;
+                }
             }
-            // ...then the last bit.
-            d = Date(1,d2.month(),d2.year());
-            total += calendar_.businessDaysBetween(d, d2);
-            return total;
         }
+        // ...and finally we get to the end of the period.
+        total += calendar_.businessDaysBetween(last, d2);
+        return total;
     }
 
     Time Business252::Impl::yearFraction(const Date& d1,
@@ -28,16 +28,41 @@
 #include <ql/time/daycounter.hpp>
 #include <ql/time/calendar.hpp>
 #include <ql/time/calendars/brazil.hpp>
+#include <vector>
+#if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN) || \
+    defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+#include <boost/thread/mutex.hpp>
+#endif
 
 namespace QuantLib {
 
     //! Business/252 day count convention
-    /*! \ingroup daycounters */
+    /*! The number of business days in each month and year is
+        calculated when first needed and shared by the copies of the
+        day counter, so the same instance should be reused.  When the
+        library is built with thread-safe observers or thread-local
+        sessions, the figures are filled under a lock and the day
+        counter can be used concurrently from different threads.
+
+        If holidays are added to or removed from the calendar, the
+        figures are calculated again.
+
+        \ingroup daycounters
+    */
     class Business252 : public DayCounter {
       private:
         class Impl : public DayCounter::Impl {
           private:
             Calendar calendar_;
+            mutable std::vector<BigInteger> monthlyFigures_,
+                                            yearlyFigures_;
+            mutable Size holidayRevision_;
+            #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN) || \
+                defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+            mutable boost::mutex mutex_;
+            #endif
+            BigInteger businessDays(Month m, Year y) const;
+            BigInteger businessDays(Year y) const;
           public:
             std::string name() const;
             BigInteger dayCount(const Date& d1,
@@ -46,7 +71,7 @@ namespace QuantLib {
                               const Date& d2,
                               const Date&,
                               const Date&) const;
-            Impl(Calendar c) { calendar_ = c; }
+            Impl(const Calendar& c);
         };
       public:
         Business252(Calendar c = Brazil())
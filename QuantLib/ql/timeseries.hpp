@@ -44,7 +44,10 @@ namespace QuantLib {
         iterators.
 
         \pre The <c>Container</c> type must satisfy the requirements
-             set by the C++ standard for associative containers.
+             set by the C++ standard for associative containers, or
+             at least provide the subset of them implemented by the
+             DenseDateMap class, which can be used for long series of
+             daily data.
     */
     template <class T, class Container = std::map<Date, T> >
     class TimeSeries {
@@ -93,8 +96,9 @@ namespace QuantLib {
         //@{
         //! returns the (possibly null) datum corresponding to the given date
         T operator[](const Date& d) const {
-            if (values_.find(d) != values_.end())
-                return values_[d];
+            typename Container::const_iterator i = values_.find(d);
+            if (i != values_.end())
+                return i->second;
             else
                 return Null<T>();
         }
@@ -77,4 +77,27 @@
 //#   define QL_ENABLE_SESSIONS
 #endif
 
+/* Define this to have singletons return a different instance for
+   each thread; the instance is found through a thread-local pointer
+   without locking. This cannot be used together with
+   QL_ENABLE_SESSIONS. */
+#ifndef QL_ENABLE_THREAD_LOCAL_SESSIONS
+//#   define QL_ENABLE_THREAD_LOCAL_SESSIONS
+#endif
+
+/* Define this to protect the observer pattern with locks, so that
+   observers can register with observables while notifications are
+   sent from a different thread. */
+#ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+//#   define QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+#endif
+
+/* Define this to have matrix products calculated by an external BLAS
+   library providing the CBLAS interface. You will have to link with
+   the library (e.g., OpenBLAS) and have its cblas.h header in your
+   include path. */
+#ifndef QL_USE_BLAS
+//#   define QL_USE_BLAS
+#endif
+
 #endif
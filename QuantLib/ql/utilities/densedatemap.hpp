@@ -0,0 +1,175 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file densedatemap.hpp
+    \brief date-indexed contiguous container
+*/
+
+#ifndef quantlib_dense_date_map_hpp
+#define quantlib_dense_date_map_hpp
+
+#include <ql/time/date.hpp>
+#include <ql/utilities/null.hpp>
+#include <boost/iterator/filter_iterator.hpp>
+#include <boost/iterator/reverse_iterator.hpp>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace QuantLib {
+
+    //! date-indexed contiguous container
+    /*! This class stores a value for each day in a range spanning
+        the dates it was given, in a contiguous array indexed by the
+        offset from the first day; days without data hold a null
+        value. Lookups take constant time, and data such as daily
+        index fixings take a fraction of the memory of a std::map.
+
+        It provides the subset of the associative-container interface
+        used by the TimeSeries class, e.g.,
+        <tt>TimeSeries<Real, DenseDateMap<Real> ></tt>.
+
+        \warning null values are not distinguished from missing
+                 data: iterators skip them, and they're not counted
+                 by size().
+
+        \pre The <c>T</c> type must be comparable with
+             <tt>Null<T>()</tt>.
+    */
+    template <class T>
+    class DenseDateMap {
+      public:
+        typedef Date key_type;
+        typedef T mapped_type;
+        typedef std::pair<Date,T> value_type;
+        typedef Size size_type;
+      private:
+        typedef std::vector<value_type> storage;
+        struct not_null {
+            bool operator()(const value_type& v) const {
+                return v.second != Null<T>();
+            }
+        };
+      public:
+        typedef boost::filter_iterator<not_null,
+                                       typename storage::const_iterator>
+                                                              const_iterator;
+        typedef const_iterator iterator;
+        typedef boost::reverse_iterator<const_iterator>
+                                                      const_reverse_iterator;
+        typedef const_reverse_iterator reverse_iterator;
+
+        //! \name Element access
+        //@{
+        //! returns the (possibly null) datum, extending the range if needed
+        T& operator[](const Date& d);
+        //! returns end() if no datum is stored for the given date
+        const_iterator find(const Date& d) const;
+        //@}
+        //! \name Iterators
+        //@{
+        const_iterator begin() const {
+            return const_iterator(not_null(), data_.begin(), data_.end());
+        }
+        const_iterator end() const {
+            return const_iterator(not_null(), data_.end(), data_.end());
+        }
+        const_reverse_iterator rbegin() const {
+            return const_reverse_iterator(end());
+        }
+        const_reverse_iterator rend() const {
+            return const_reverse_iterator(begin());
+        }
+        //@}
+        //! \name Capacity
+        //@{
+        //! number of non-null data; it takes linear time
+        Size size() const;
+        bool empty() const { return begin() == end(); }
+        //@}
+        //! \name Modifiers
+        //@{
+        void clear() { data_.clear(); }
+        //@}
+      private:
+        storage data_;
+    };
+
+
+    // template definitions
+
+    template <class T>
+    T& DenseDateMap<T>::operator[](const Date& d) {
+        if (data_.empty()) {
+            data_.push_back(value_type(d, Null<T>()));
+            return data_.back().second;
+        }
+        Date first = data_.front().first, last = data_.back().first;
+        if (d < first) {
+            // The range is extended backwards by at least its current
+            // length, so that adding dates in decreasing order takes
+            // amortized constant time as appending them does; the
+            // additional days hold null values.
+            BigInteger n = std::max<BigInteger>(first - d, data_.size());
+            n = std::min<BigInteger>(n, first - Date::minDate());
+            storage extended;
+            extended.reserve(data_.size() + n);
+            for (BigInteger i = first.serialNumber() - n;
+                 i < first.serialNumber(); ++i)
+                extended.push_back(value_type(Date(i), Null<T>()));
+            extended.insert(extended.end(), data_.begin(), data_.end());
+            data_.swap(extended);
+            return data_[d - data_.front().first].second;
+        } else if (d > last) {
+            // serial numbers, since incrementing Date::maxDate()
+            // would throw
+            for (BigInteger i = last.serialNumber() + 1;
+                 i <= d.serialNumber(); ++i)
+                data_.push_back(value_type(Date(i), Null<T>()));
+            return data_.back().second;
+        } else {
+            return data_[d - first].second;
+        }
+    }
+
+    template <class T>
+    typename DenseDateMap<T>::const_iterator
+    DenseDateMap<T>::find(const Date& d) const {
+        if (data_.empty() || d < data_.front().first
+                          || d > data_.back().first)
+            return end();
+        typename storage::const_iterator i =
+            data_.begin() + (d - data_.front().first);
+        if (i->second == Null<T>())
+            return end();
+        return const_iterator(not_null(), i, data_.end());
+    }
+
+    template <class T>
+    Size DenseDateMap<T>::size() const {
+        Size n = 0;
+        for (typename storage::const_iterator i = data_.begin();
+             i != data_.end(); ++i) {
+            if (i->second != Null<T>())
+                ++n;
+        }
+        return n;
+    }
+
+}
+
+#endif
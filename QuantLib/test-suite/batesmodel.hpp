@@ -31,6 +31,7 @@ class BatesModelTest {
     static void testAnalyticAndMcVsJumpDiffusion();
     static void testAnalyticVsMCPricing();
     static void testDAXCalibration();
+    static void testParallelDAXCalibration();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -1109,6 +1109,103 @@ void CalendarTest::testBespokeCalendars() {
 
 }
 
+void CalendarTest::testBusinessDayCache() {
+
+    BOOST_TEST_MESSAGE("Testing cached business-day calculations...");
+
+    std::vector<Calendar> calendars;
+    calendars.push_back(TARGET());
+    calendars.push_back(UnitedStates(UnitedStates::NYSE));
+    calendars.push_back(JointCalendar(TARGET(),
+                                      UnitedKingdom(UnitedKingdom::Exchange),
+                                      JoinHolidays));
+    calendars.push_back(JointCalendar(TARGET(),
+                                      UnitedKingdom(UnitedKingdom::Exchange),
+                                      JoinBusinessDays));
+
+    const Date first(1, January, 1995), last(31, December, 2025);
+    Integer shifts[] = { 1, 2, 5, 22, 260, -1, -3, -21, -250 };
+    const Size nShifts = LENGTH(shifts);
+
+    for (Size i=0; i<calendars.size(); ++i) {
+        Calendar c = calendars[i];
+
+        std::vector<bool> expected;
+        for (Date d=first; d<=last; ++d)
+            expected.push_back(c.isBusinessDay(d));
+        std::vector<Date> advanced;
+        std::vector<BigInteger> between;
+        for (Date d=first; d<=last; d+=17) {
+            for (Size j=0; j<nShifts; ++j)
+                advanced.push_back(c.advance(d, shifts[j], Days));
+            Date d2 = d + 400;
+            between.push_back(c.businessDaysBetween(d, d2));
+            between.push_back(c.businessDaysBetween(d2, d));
+            between.push_back(c.businessDaysBetween(d, d2, false, true));
+            between.push_back(c.businessDaysBetween(d2, d, true, false));
+        }
+
+        c.enableBusinessDayCache();
+        if (!c.businessDayCacheEnabled())
+            BOOST_FAIL(c.name() << ": business-day cache not enabled");
+
+        Size k = 0;
+        for (Date d=first; d<=last; ++d, ++k) {
+            if (c.isBusinessDay(d) != expected[k])
+                BOOST_FAIL(c.name() << ": cached calendar "
+                           << (expected[k] ? "detects" : "misses")
+                           << " holiday on " << d);
+        }
+        Size a = 0, b = 0;
+        for (Date d=first; d<=last; d+=17) {
+            for (Size j=0; j<nShifts; ++j, ++a) {
+                Date calculated = c.advance(d, shifts[j], Days);
+                if (calculated != advanced[a])
+                    BOOST_FAIL(c.name() << ": cached calendar advances "
+                               << d << " by " << shifts[j] << " days"
+                               << "\n    calculated: " << calculated
+                               << "\n    expected:   " << advanced[a]);
+            }
+            Date d2 = d + 400;
+            BigInteger calculated[] = {
+                c.businessDaysBetween(d, d2),
+                c.businessDaysBetween(d2, d),
+                c.businessDaysBetween(d, d2, false, true),
+                c.businessDaysBetween(d2, d, true, false)
+            };
+            for (Size j=0; j<LENGTH(calculated); ++j, ++b) {
+                if (calculated[j] != between[b])
+                    BOOST_FAIL(c.name() << ": cached calendar counts "
+                               << calculated[j] << " business days between "
+                               << d << " and " << d2
+                               << " (expected " << between[b] << ")");
+            }
+        }
+
+        c.disableBusinessDayCache();
+    }
+
+    // holidays added or removed while the cache is on
+    Calendar c = TARGET();
+    c.enableBusinessDayCache();
+    Date monday(5, May, 2014), saturday(10, May, 2014);
+    c.addHoliday(monday);
+    c.removeHoliday(saturday);
+    if (c.isBusinessDay(monday))
+        BOOST_ERROR(monday << " (marked as holiday) not detected");
+    if (!c.isBusinessDay(saturday))
+        BOOST_ERROR(saturday << " (marked as business day) not detected");
+    if (c.advance(Date(2, May, 2014), 1, Days) != Date(6, May, 2014))
+        BOOST_ERROR("added holiday not skipped when advancing");
+    if (c.businessDaysBetween(Date(2, May, 2014), Date(12, May, 2014)) != 6)
+        BOOST_ERROR("wrong number of business days with modified holidays");
+    c.removeHoliday(monday);
+    c.addHoliday(saturday);
+    c.disableBusinessDayCache();
+    if (!c.isBusinessDay(monday) || c.isBusinessDay(saturday))
+        BOOST_ERROR("holidays not restored");
+}
+
 test_suite* CalendarTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Calendar tests");
 
@@ -1141,6 +1238,7 @@ test_suite* CalendarTest::suite() {
 
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testEndOfMonth));
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testBusinessDaysBetween));
+    suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testBusinessDayCache));
 
     return suite;
 }
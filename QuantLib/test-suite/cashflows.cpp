@@ -20,6 +20,7 @@
 #include "cashflows.hpp"
 #include "utilities.hpp"
 #include <ql/cashflows/cashflows.hpp>
+#include <ql/cashflows/compiledleg.hpp>
 #include <ql/cashflows/simplecashflow.hpp>
 #include <ql/cashflows/fixedratecoupon.hpp>
 #include <ql/cashflows/floatingratecoupon.hpp>
@@ -28,6 +29,8 @@
 #include <ql/quotes/simplequote.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/schedule.hpp>
+#include <ql/time/daycounters/actualactual.hpp>
+#include <ql/time/daycounters/thirty360.hpp>
 #include <ql/indexes/ibor/usdlibor.hpp>
 #include <ql/settings.hpp>
 
@@ -245,11 +248,119 @@ void CashFlowsTest::testDefaultSettlementDate() {
 }
 
 
+void CashFlowsTest::testCompiledLeg() {
+
+    BOOST_TEST_MESSAGE("Testing compiled-leg cash-flow analytics...");
+
+    SavedSettings backup;
+
+    Date today(15, March, 2013);
+    Settings::instance().evaluationDate() = today;
+
+    Schedule schedule =
+        MakeSchedule()
+        .from(today-1*Years).to(today+10*Years)
+        .withFrequency(Semiannual)
+        .withCalendar(TARGET())
+        .withConvention(Unadjusted)
+        .backwards();
+    Leg leg = FixedRateLeg(schedule)
+              .withNotionals(100.0)
+              .withCouponRates(0.05, ActualActual(ActualActual::ISMA))
+              .withPaymentCalendar(TARGET())
+              .withPaymentAdjustment(Following);
+    leg.push_back(shared_ptr<CashFlow>(
+                          new SimpleCashFlow(100.0, leg.back()->date())));
+
+    Date settlement = today + 3;
+    CompiledLeg compiled(leg, false, settlement);
+
+    #define CHECK_COMPILED(what, calculated, expected) \
+    if (std::fabs((calculated)-(expected)) > 1.0e-10) { \
+        BOOST_FAIL("compiled-leg " << what << " mismatch:" \
+                   << std::setprecision(12) \
+                   << "\n    calculated: " << (calculated) \
+                   << "\n    expected:   " << (expected)); \
+    }
+
+    shared_ptr<YieldTermStructure> curve =
+        flatRate(today, 0.04, Actual365Fixed());
+
+    CHECK_COMPILED("npv", compiled.npv(*curve),
+                   CashFlows::npv(leg, *curve, false, settlement));
+    CHECK_COMPILED("bps", compiled.bps(*curve),
+                   CashFlows::bps(leg, *curve, false, settlement));
+    Real npv, bps;
+    compiled.npvbps(*curve, npv, bps);
+    CHECK_COMPILED("npvbps", npv,
+                   CashFlows::npv(leg, *curve, false, settlement));
+    CHECK_COMPILED("npvbps", bps,
+                   CashFlows::bps(leg, *curve, false, settlement));
+
+    DayCounter dayCounters[] = { ActualActual(ActualActual::ISMA),
+                                 Actual360(),
+                                 Thirty360() };
+    Compounding compoundings[] = { Simple, Compounded, Continuous,
+                                   SimpleThenCompounded };
+
+    for (Size i=0; i<LENGTH(dayCounters); ++i) {
+        for (Size j=0; j<LENGTH(compoundings); ++j) {
+            InterestRate y(0.045, dayCounters[i], compoundings[j],
+                           Semiannual);
+
+            Real expectedNPV = CashFlows::npv(leg, y, false, settlement);
+            CHECK_COMPILED("yield npv", compiled.npv(y), expectedNPV);
+            CHECK_COMPILED("yield bps", compiled.bps(y),
+                           CashFlows::bps(leg, y, false, settlement));
+            CHECK_COMPILED("simple duration",
+                           compiled.duration(y, Duration::Simple),
+                           CashFlows::duration(leg, y, Duration::Simple,
+                                               false, settlement));
+            CHECK_COMPILED("modified duration",
+                           compiled.duration(y, Duration::Modified),
+                           CashFlows::duration(leg, y, Duration::Modified,
+                                               false, settlement));
+            if (compoundings[j] == Compounded) {
+                CHECK_COMPILED("Macaulay duration",
+                               compiled.duration(y, Duration::Macaulay),
+                               CashFlows::duration(leg, y,
+                                                   Duration::Macaulay,
+                                                   false, settlement));
+            }
+            CHECK_COMPILED("convexity", compiled.convexity(y),
+                           CashFlows::convexity(leg, y, false, settlement));
+
+            Rate yield = compiled.yield(expectedNPV, dayCounters[i],
+                                        compoundings[j], Semiannual,
+                                        1.0e-12);
+            CHECK_COMPILED("yield", yield, 0.045);
+
+            Real expectedZNPV = CashFlows::npv(leg, curve, 0.01,
+                                               dayCounters[i],
+                                               compoundings[j], Semiannual,
+                                               false, settlement);
+            CHECK_COMPILED("z-spreaded npv",
+                           compiled.npv(curve, 0.01, dayCounters[i],
+                                        compoundings[j], Semiannual),
+                           expectedZNPV);
+            Spread zSpread = compiled.zSpread(expectedZNPV, curve,
+                                              dayCounters[i],
+                                              compoundings[j], Semiannual,
+                                              1.0e-12);
+            CHECK_COMPILED("z-spread", zSpread, 0.01);
+        }
+    }
+
+    #undef CHECK_COMPILED
+}
+
+
 test_suite* CashFlowsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Cash flows tests");
     suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testSettings));
     suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testAccessViolation));
     suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testDefaultSettlementDate));
+    suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testCompiledLeg));
     return suite;
 }
 
@@ -25,7 +25,12 @@
 #include <ql/time/daycounters/simpledaycounter.hpp>
 #include <ql/time/daycounters/business252.hpp>
 #include <ql/time/calendars/brazil.hpp>
+#include <ql/time/calendars/bespokecalendar.hpp>
 #include <ql/time/period.hpp>
+#include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
+#include <ql/termstructures/yield/ratehelpers.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/settings.hpp>
 #include <iomanip>
 
 using namespace QuantLib;
@@ -285,6 +290,83 @@ void DayCounterTest::testBusiness252() {
                             << "    expected:   " << expected[i-1]);
         }
     }
+
+    // holidays added after the day counter is built must be counted,
+    // also in the whole months of the period
+    BespokeCalendar calendar("bespoke");
+    calendar.addWeekend(Saturday);
+    calendar.addWeekend(Sunday);
+    DayCounter dayCounter3 = Business252(calendar);
+    Date start(1,February,2002), end(15,April,2002);
+    BigInteger before = dayCounter3.dayCount(start, end);
+    calendar.addHoliday(Date(15,March,2002));
+    BigInteger after = dayCounter3.dayCount(start, end);
+    if (after != before-1)
+        BOOST_ERROR("added holiday not taken into account:\n"
+                    << "    before adding it: " << before << "\n"
+                    << "    after adding it:  " << after);
+}
+
+
+void DayCounterTest::testBusiness252Curve() {
+
+    BOOST_TEST_MESSAGE("Testing business/252 day counter "
+                       "in curve bootstrapping...");
+
+    SavedSettings backup;
+
+    Calendar calendar = Brazil();
+    DayCounter dayCounter = Business252(calendar);
+
+    // the cached figures must agree with a direct count
+    Date start(3, January, 2011);
+    for (Integer i=0; i<400; i+=7) {
+        Date d1 = start + i;
+        for (Integer j=1; j<3000; j+=97) {
+            Date d2 = d1 + j;
+            BigInteger calculated = dayCounter.dayCount(d1, d2);
+            BigInteger expected = calendar.businessDaysBetween(d1, d2);
+            if (calculated != expected)
+                BOOST_FAIL("from " << d1 << " to " << d2 << ":\n"
+                           << "    calculated: " << calculated << "\n"
+                           << "    expected:   " << expected);
+        }
+    }
+
+    // a 40-pillar DI-like curve
+    Date today = calendar.adjust(Date(15, March, 2012));
+    Settings::instance().evaluationDate() = today;
+
+    std::vector<boost::shared_ptr<SimpleQuote> > quotes;
+    std::vector<boost::shared_ptr<RateHelper> > helpers;
+    for (Integer m=1; m<=96; m += (m < 12 ? 1 : 3)) {
+        boost::shared_ptr<SimpleQuote> q(new SimpleQuote(0.10 + 0.0003*m));
+        quotes.push_back(q);
+        helpers.push_back(boost::shared_ptr<RateHelper>(
+            new DepositRateHelper(Handle<Quote>(q), m*Months, 0, calendar,
+                                  Following, false, dayCounter)));
+    }
+    BOOST_REQUIRE(helpers.size() == 40);
+
+    PiecewiseYieldCurve<Discount,LogLinear> curve(today, helpers,
+                                                  dayCounter);
+
+    for (Size k=0; k<50; ++k) {
+        for (Size i=0; i<quotes.size(); ++i)
+            quotes[i]->setValue(quotes[i]->value() + (k%2 == 0 ? 1 : -1)
+                                                    * 0.0001);
+        curve.discount(1.0);
+        for (Size i=0; i<helpers.size(); ++i) {
+            Real error = std::fabs(helpers[i]->impliedQuote()
+                                   - quotes[i]->value());
+            if (error > 1.0e-9)
+                BOOST_FAIL("failed to reprice pillar " << i << ":\n"
+                           << std::setprecision(10)
+                           << "    estimated rate: "
+                           << helpers[i]->impliedQuote() << "\n"
+                           << "    input rate:     " << quotes[i]->value());
+        }
+    }
 }
 
 
@@ -294,6 +376,7 @@ test_suite* DayCounterTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testSimple));
     suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testOne));
     suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testBusiness252));
+    suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testBusiness252Curve));
     return suite;
 }
 
@@ -405,9 +405,60 @@ void DistributionTest::testInverseCumulativePoisson() {
 }
 
 
+void DistributionTest::testNormalArrays() {
+
+    BOOST_TEST_MESSAGE("Testing array versions of normal distributions...");
+
+    Size N = 1000000;
+    std::vector<Real> x(N), y(N);
+    Size i;
+
+    // uniform grid over (0,1), tails included
+    for (i=0; i<N; i++)
+        x[i] = (i+0.5)/N;
+
+    InverseCumulativeNormal invCumStandardNormal;
+    InverseCumulativeNormal invCum(average,sigma);
+    InverseCumulativeNormal* invCums[] = { &invCumStandardNormal, &invCum };
+    for (Size k=0; k<LENGTH(invCums); k++) {
+        const InverseCumulativeNormal& f = *invCums[k];
+        f(&x[0], &x[0]+N, &y[0]);
+        for (i=0; i<N; i++) {
+            Real expected = f(x[i]);
+            if (std::fabs(y[i]-expected) > 1.0e-15*(1.0+std::fabs(expected)))
+                BOOST_FAIL("array version of InverseCumulativeNormal "
+                           "doesn't match scalar version:"
+                           << QL_SCIENTIFIC
+                           << "\n    input:      " << x[i]
+                           << "\n    scalar:     " << expected
+                           << "\n    array:      " << y[i]);
+        }
+    }
+
+    // grid covering the asymptotic expansion for very negative values
+    Real xMin = -40.0, xMax = 10.0, h = (xMax-xMin)/(N-1);
+    for (i=0; i<N; i++)
+        x[i] = xMin+h*i;
+
+    CumulativeNormalDistribution cum(average,sigma);
+    cum(&x[0], &x[0]+N, &y[0]);
+    for (i=0; i<N; i++) {
+        Real expected = cum(x[i]);
+        if (std::fabs(y[i]-expected) > 1.0e-15*std::fabs(expected))
+            BOOST_FAIL("array version of CumulativeNormalDistribution "
+                       "doesn't match scalar version:"
+                       << QL_SCIENTIFIC
+                       << "\n    input:      " << x[i]
+                       << "\n    scalar:     " << expected
+                       << "\n    array:      " << y[i]);
+    }
+}
+
+
 test_suite* DistributionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Distribution tests");
     suite->add(QUANTLIB_TEST_CASE(&DistributionTest::testNormal));
+    suite->add(QUANTLIB_TEST_CASE(&DistributionTest::testNormalArrays));
     suite->add(QUANTLIB_TEST_CASE(&DistributionTest::testBivariate));
     suite->add(QUANTLIB_TEST_CASE(&DistributionTest::testPoisson));
     suite->add(QUANTLIB_TEST_CASE(&DistributionTest::testCumulativePoisson));
@@ -1282,6 +1282,104 @@ void EuropeanOptionTest::testMcEngines() {
     testEngineConsistency(engine,steps,samples,relativeTol);
 }
 
+void EuropeanOptionTest::testMultithreadedMcEngines() {
+
+    BOOST_TEST_MESSAGE("Testing multithreaded Monte Carlo European engines...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<BlackScholesMertonProcess> process(
+        new BlackScholesMertonProcess(
+                     Handle<Quote>(spot),
+                     Handle<YieldTermStructure>(flatRate(today, 0.02, dc)),
+                     Handle<YieldTermStructure>(flatRate(today, 0.05, dc)),
+                     Handle<BlackVolTermStructure>(flatVol(today, 0.25, dc))));
+
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+                                 new PlainVanillaPayoff(Option::Call, 105.0));
+    boost::shared_ptr<Exercise> exercise(
+                                  new EuropeanExercise(today + 360));
+    EuropeanOption option(payoff, exercise);
+
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                      new AnalyticEuropeanEngine(process)));
+    Real expected = option.NPV();
+
+    Size samples = 20001, threads = 4;
+    option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(process)
+                            .withSteps(1)
+                            .withSamples(samples)
+                            .withSeed(42)
+                            .withThreads(threads));
+    Real calculated = option.NPV();
+    Real error = option.errorEstimate();
+    if (std::fabs(calculated-expected) > 3.0*error)
+        BOOST_ERROR("multithreaded Monte Carlo price out of tolerance"
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << expected
+                    << "\n    error:      " << error);
+
+    // same seed and number of threads must reproduce the same price
+    option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(process)
+                            .withSteps(1)
+                            .withSamples(samples)
+                            .withSeed(42)
+                            .withThreads(threads));
+    if (option.NPV() != calculated)
+        BOOST_ERROR("multithreaded Monte Carlo price not reproducible"
+                    << "\n    first run:  " << calculated
+                    << "\n    second run: " << option.NPV());
+
+    // the samples must be split among workers drawing distinct streams
+    option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(process)
+                            .withSteps(1)
+                            .withSamples(samples)
+                            .withSeed(42));
+    if (option.NPV() == calculated)
+        BOOST_ERROR("multithreaded Monte Carlo price equal to "
+                    "single-threaded one");
+
+    // with the default seed, a single random one is shared by workers
+    option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(process)
+                            .withSteps(1)
+                            .withSamples(samples)
+                            .withThreads(threads));
+    calculated = option.NPV();
+    error = option.errorEstimate();
+    if (std::fabs(calculated-expected) > 3.0*error)
+        BOOST_ERROR("multithreaded Monte Carlo price with default seed "
+                    "out of tolerance"
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << expected
+                    << "\n    error:      " << error);
+
+    // low-discrepancy sequences are split in contiguous chunks among
+    // workers, which must use the same points as a single generator
+    option.setPricingEngine(MakeMCEuropeanEngine<LowDiscrepancy>(process)
+                            .withSteps(1)
+                            .withSamples(samples)
+                            .withThreads(threads));
+    calculated = option.NPV();
+    if (std::fabs(calculated/expected-1.0) > 0.01)
+        BOOST_ERROR("multithreaded quasi Monte Carlo price out of tolerance"
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << expected);
+    option.setPricingEngine(MakeMCEuropeanEngine<LowDiscrepancy>(process)
+                            .withSteps(1)
+                            .withSamples(samples));
+    Real serial = option.NPV();
+    if (std::fabs(calculated-serial) > 1.0e-10)
+        BOOST_ERROR("multithreaded quasi Monte Carlo price differs from "
+                    "single-threaded one"
+                    << "\n    multithreaded:   " << calculated
+                    << "\n    single-threaded: " << serial);
+}
+
 void EuropeanOptionTest::testQmcEngines() {
 
     BOOST_TEST_MESSAGE("Testing Quasi Monte Carlo European engines "
@@ -1569,6 +1667,8 @@ test_suite* EuropeanOptionTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testIntegralEngines));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testMcEngines));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testQmcEngines));
+    suite->add(QUANTLIB_TEST_CASE(
+                            &EuropeanOptionTest::testMultithreadedMcEngines));
 
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testPriceCurve));
@@ -44,6 +44,7 @@ class EuropeanOptionTest {
     static void testIntegralEngines();
     static void testQmcEngines();
     static void testMcEngines();
+    static void testMultithreadedMcEngines();
     static void testFFTEngines();
     static void testPriceCurve();
     static void testLocalVolatility();
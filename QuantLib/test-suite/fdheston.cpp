@@ -334,6 +334,72 @@ void FdHestonTest::testFdmHestonAmerican() {
 }
 
 
+void FdHestonTest::testFdmHestonMultiThreaded() {
+
+    BOOST_TEST_MESSAGE("Testing multi-threaded FDM with Heston model...");
+
+    SavedSettings backup;
+
+    // same option as in testFdmHestonAmerican
+    Settings::instance().evaluationDate() = Date(28, March, 2004);
+    Date exerciseDate(28, March, 2005);
+
+    Handle<Quote> s0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> rTS(flatRate(0.05, Actual365Fixed()));
+    Handle<YieldTermStructure> qTS(flatRate(0.0 , Actual365Fixed()));
+
+    boost::shared_ptr<HestonModel> model(new HestonModel(
+        boost::shared_ptr<HestonProcess>(
+            new HestonProcess(rTS, qTS, s0, 0.04, 2.5, 0.04, 0.66, -0.8))));
+
+    boost::shared_ptr<Exercise> exercise(new AmericanExercise(exerciseDate));
+    boost::shared_ptr<StrikedTypePayoff> payoff(new
+                                      PlainVanillaPayoff(Option::Put, 100));
+    VanillaOption option(payoff, exercise);
+
+    const FdmSchemeDesc schemes[] = { FdmSchemeDesc::Douglas(),
+                                      FdmSchemeDesc::CraigSneyd(),
+                                      FdmSchemeDesc::ModifiedCraigSneyd(),
+                                      FdmSchemeDesc::Hundsdorfer() };
+    const Size threads[] = { 2, 4 };
+    const Real tol = 0.01;
+    const Real npvExpected = 5.66032;
+
+    for (Size i=0; i<LENGTH(schemes); ++i) {
+        option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                          new FdHestonVanillaEngine(model, 200, 100, 50, 0,
+                                                    schemes[i])));
+        const Real expected = option.NPV();
+
+        if (std::fabs(expected - npvExpected) > tol) {
+            BOOST_ERROR("Failed to reproduce expected npv"
+                        << "\n    scheme:     " << i
+                        << "\n    calculated: " << expected
+                        << "\n    expected:   " << npvExpected
+                        << "\n    tolerance:  " << tol);
+        }
+
+        for (Size j=0; j<LENGTH(threads); ++j) {
+            const FdmSchemeDesc scheme(schemes[i].type, schemes[i].theta,
+                                       schemes[i].mu, threads[j]);
+            option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                   new FdHestonVanillaEngine(model, 200, 100, 50, 0, scheme)));
+            const Real calculated = option.NPV();
+
+            // the lines are solved independently, so that the
+            // results do not depend on the number of threads
+            if (calculated != expected) {
+                BOOST_ERROR("Failed to reproduce single-threaded npv"
+                            << "\n    scheme:     " << i
+                            << "\n    threads:    " << threads[j]
+                            << std::setprecision(16)
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected);
+            }
+        }
+    }
+}
+
 void FdHestonTest::testFdmHestonIkonenToivanen() {
 
     BOOST_TEST_MESSAGE("Testing FDM Heston for Ikonen and Toivanen tests...");
@@ -1286,6 +1352,7 @@ test_suite* FdHestonTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(
                          &FdHestonTest::testFdmHestonBarrierVsBlackScholes));
     suite->add(QUANTLIB_TEST_CASE(&FdHestonTest::testFdmHestonAmerican));
+    suite->add(QUANTLIB_TEST_CASE(&FdHestonTest::testFdmHestonMultiThreaded));
     suite->add(QUANTLIB_TEST_CASE(&FdHestonTest::testFdmHestonIkonenToivanen));
     suite->add(QUANTLIB_TEST_CASE(&FdHestonTest::testFdmHestonBlackScholes));
     suite->add(QUANTLIB_TEST_CASE(
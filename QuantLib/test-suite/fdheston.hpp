@@ -30,6 +30,7 @@ public:
     static void testFdmHestonBarrier();
     static void testFdmHestonBarrierVsBlackScholes();
     static void testFdmHestonAmerican();
+    static void testFdmHestonMultiThreaded();
     static void testFdmHestonIkonenToivanen();
     static void testFdmHestonEuropeanWithDividends();
     static void testFdmHestonConvergence();
@@ -580,6 +580,24 @@ void FdmLinearOpTest::testTripleBandMapSolve() {
                 << "\n calculated    : " << t[i]);
         }
     }
+
+    // implicit steps solve (a L + b I) x = r line by line
+    SecondDerivativeOp dyy(1, mesher);
+    dyy.axpyb(Array(1, 0.5), dyy, dy, Array(1, 1.0));
+    const TripleBandLinearOp* ops[] = { &dxx, &dyy };
+    for (Size k=0; k < LENGTH(ops); ++k) {
+        const Real a = -0.01, b = 1.0;
+        t = ops[k]->solve_splitting(u, a, b);
+        const Array r = a*ops[k]->apply(t) + b*t;
+        for (Size i=0; i < u.size(); ++i) {
+            if (std::fabs(u[i] - r[i]) > 1e-8) {
+                BOOST_FAIL("solution does not satisfy the system "
+                    << "\n direction     : " << k
+                    << "\n expected rhs  : " << u[i]
+                    << "\n calculated rhs: " << r[i]);
+            }
+        }
+    }
 }
 
 
@@ -1210,6 +1210,337 @@ void HestonModelTest::testAlanLewisReferencePrices() {
     }
 }
 
+void HestonModelTest::testParallelDAXCalibration() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing Heston model calibration on several workers "
+        "using DAX volatility data...");
+
+    SavedSettings backup;
+
+    Date settlementDate(5, July, 2002);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    CalibrationMarketData marketData = getDAXCalibrationMarketData();
+
+    const std::vector<boost::shared_ptr<CalibrationHelper> > options
+                                                    = marketData.options;
+
+    boost::shared_ptr<HestonProcess> process(new HestonProcess(
+                            marketData.riskFreeTS, marketData.dividendYield,
+                            marketData.s0, 0.1, 1.0, 0.1, 0.5, -0.5));
+    boost::shared_ptr<HestonModel> model(new HestonModel(process));
+
+    boost::shared_ptr<PricingEngine> engine(
+                                         new AnalyticHestonEngine(model, 64));
+    for (Size i = 0; i < options.size(); ++i)
+        options[i]->setPricingEngine(engine);
+
+    std::vector<boost::shared_ptr<PricingEngine> > workerEngines;
+    for (Size i = 0; i < 4; ++i)
+        workerEngines.push_back(boost::shared_ptr<PricingEngine>(
+                                       new AnalyticHestonEngine(model, 64)));
+
+    LevenbergMarquardt om(1e-8, 1e-8, 1e-8);
+    model->calibrate(options, workerEngines, om,
+                     EndCriteria(400, 40, 1.0e-8, 1.0e-8, 1.0e-8));
+
+    Real sse = 0;
+    for (Size i = 0; i < options.size(); ++i) {
+        const Real diff = options[i]->calibrationError()*100.0;
+        sse += diff*diff;
+    }
+    Real expected = 177.2; //see article by A. Sepp.
+    if (std::fabs(sse - expected) > 1.0) {
+        BOOST_FAIL("Failed to reproduce calibration error"
+                   << "\n    calculated: " << sse
+                   << "\n    expected:   " << expected);
+    }
+}
+
+void HestonModelTest::testParallelVsSerialCalibration() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing Heston model calibration on several workers "
+        "against serial calibration...");
+
+    SavedSettings backup;
+
+    Date settlementDate(5, July, 2002);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    CalibrationMarketData marketData = getDAXCalibrationMarketData();
+
+    const std::vector<boost::shared_ptr<CalibrationHelper> > options
+                                                    = marketData.options;
+
+    Array params[2];
+    for (Size k=0; k<2; ++k) {
+        boost::shared_ptr<HestonProcess> process(new HestonProcess(
+                            marketData.riskFreeTS, marketData.dividendYield,
+                            marketData.s0, 0.1, 1.0, 0.1, 0.5, -0.5));
+        boost::shared_ptr<HestonModel> model(new HestonModel(process));
+
+        boost::shared_ptr<PricingEngine> engine(
+                                         new AnalyticHestonEngine(model, 64));
+        for (Size i = 0; i < options.size(); ++i)
+            options[i]->setPricingEngine(engine);
+
+        LevenbergMarquardt om(1e-8, 1e-8, 1e-8);
+        const EndCriteria endCriteria(400, 40, 1.0e-8, 1.0e-8, 1.0e-8);
+        if (k == 0) {
+            model->calibrate(options, om, endCriteria);
+        } else {
+            std::vector<boost::shared_ptr<PricingEngine> > workerEngines;
+            for (Size i = 0; i < 4; ++i)
+                workerEngines.push_back(boost::shared_ptr<PricingEngine>(
+                                       new AnalyticHestonEngine(model, 64)));
+            model->calibrate(options, workerEngines, om, endCriteria);
+
+            for (Size i = 0; i < options.size(); ++i) {
+                if (options[i]->pricingEngine() != engine)
+                    BOOST_FAIL("pricing engine of helper #" << i
+                               << " not restored after calibration");
+            }
+        }
+        params[k] = model->params();
+    }
+
+    // the same errors are calculated in the same order
+    for (Size i = 0; i < params[0].size(); ++i) {
+        if (std::fabs(params[0][i] - params[1][i]) > 1.0e-12) {
+            BOOST_ERROR("Failed to reproduce serial calibration"
+                        << "\n    parameter:  " << i
+                        << "\n    serial:     " << params[0][i]
+                        << "\n    parallel:   " << params[1][i]);
+        }
+    }
+}
+
+void HestonModelTest::testAnalyticParameterGradient() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing analytic Heston parameter gradient against finite "
+        "differences...");
+
+    SavedSettings backup;
+
+    const Date settlementDate(27, December, 2004);
+    Settings::instance().evaluationDate() = settlementDate;
+    DayCounter dayCounter = ActualActual();
+
+    Handle<YieldTermStructure> riskFreeTS(flatRate(0.05, dayCounter));
+    Handle<YieldTermStructure> dividendTS(flatRate(0.02, dayCounter));
+    Handle<Quote> s0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+
+    boost::shared_ptr<HestonProcess> process(new HestonProcess(
+              riskFreeTS, dividendTS, s0, 0.04, 1.5, 0.06, 0.6, -0.7));
+    boost::shared_ptr<HestonModel> model(new HestonModel(process));
+
+    std::vector<boost::shared_ptr<AnalyticHestonEngine> > engines;
+    engines.push_back(boost::shared_ptr<AnalyticHestonEngine>(
+                                       new AnalyticHestonEngine(model, 144)));
+    engines.push_back(boost::shared_ptr<AnalyticHestonEngine>(
+        new AnalyticHestonEngine(
+                        model, AnalyticHestonEngine::BranchCorrection,
+                        AnalyticHestonEngine::Integration::gaussLaguerre(
+                                                                    144))));
+    engines.push_back(boost::shared_ptr<AnalyticHestonEngine>(
+        new AnalyticHestonEngine(
+                        model, AnalyticHestonEngine::Gatheral,
+                        AnalyticHestonEngine::Integration::gaussLegendre(
+                                                                    256))));
+
+    const Option::Type types[] = { Option::Call, Option::Put };
+    const Real strikes[] = { 70.0, 100.0, 140.0 };
+    const Period maturities[] = { 3*Months, 1*Years, 5*Years };
+
+    const Array params = model->params();
+    const Real h = 1.0e-5;
+    const Real tolerance = 1.0e-5;
+
+    for (Size e=0; e<engines.size(); ++e) {
+      for (Size i=0; i<LENGTH(types); ++i) {
+        for (Size j=0; j<LENGTH(strikes); ++j) {
+          for (Size k=0; k<LENGTH(maturities); ++k) {
+            boost::shared_ptr<StrikedTypePayoff> payoff(
+                               new PlainVanillaPayoff(types[i], strikes[j]));
+            boost::shared_ptr<Exercise> exercise(
+                  new EuropeanExercise(settlementDate + maturities[k]));
+            VanillaOption option(payoff, exercise);
+            option.setPricingEngine(engines[e]);
+
+            const Array calculated = engines[e]->parameterGradient(option);
+            if (calculated.size() != params.size())
+                BOOST_FAIL("wrong number of derivatives: "
+                           << calculated.size() << " instead of "
+                           << params.size());
+
+            for (Size l=0; l<params.size(); ++l) {
+                Array bumped = params;
+                bumped[l] += h;
+                model->setParams(bumped);
+                const Real up = option.NPV();
+                bumped[l] -= 2*h;
+                model->setParams(bumped);
+                const Real down = option.NPV();
+                model->setParams(params);
+
+                const Real expected = (up - down)/(2*h);
+                if (std::fabs(calculated[l] - expected)
+                                > tolerance*std::max(1.0, std::fabs(expected)))
+                    BOOST_ERROR("failed to reproduce finite-difference "
+                                "derivative"
+                                << "\n    engine:     " << e
+                                << "\n    type:       " << types[i]
+                                << "\n    strike:     " << strikes[j]
+                                << "\n    maturity:   " << maturities[k]
+                                << "\n    parameter:  " << l
+                                << QL_SCIENTIFIC
+                                << "\n    calculated: " << calculated[l]
+                                << "\n    expected:   " << expected);
+            }
+          }
+        }
+      }
+    }
+}
+
+void HestonModelTest::testDAXCalibrationWithGradient() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing Heston model calibration with analytic jacobian...");
+
+    SavedSettings backup;
+
+    Date settlementDate(5, July, 2002);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    CalibrationMarketData marketData = getDAXCalibrationMarketData();
+
+    const std::vector<boost::shared_ptr<CalibrationHelper> > options
+                                                    = marketData.options;
+
+    boost::shared_ptr<HestonProcess> process(new HestonProcess(
+                            marketData.riskFreeTS, marketData.dividendYield,
+                            marketData.s0, 0.1, 1.0, 0.1, 0.5, -0.5));
+    boost::shared_ptr<HestonModel> model(new HestonModel(process));
+
+    boost::shared_ptr<PricingEngine> engine(
+                                         new AnalyticHestonEngine(model, 64));
+    for (Size i = 0; i < options.size(); ++i)
+        options[i]->setPricingEngine(engine);
+
+    LevenbergMarquardt om(1e-8, 1e-8, 1e-8, true);
+    model->calibrate(options, om,
+                     EndCriteria(400, 40, 1.0e-8, 1.0e-8, 1.0e-8));
+
+    Real sse = 0;
+    for (Size i = 0; i < 13*8; ++i) {
+        const Real diff = options[i]->calibrationError()*100.0;
+        sse += diff*diff;
+    }
+    Real expected = 177.2; //see article by A. Sepp.
+    if (std::fabs(sse - expected) > 1.0) {
+        BOOST_FAIL("Failed to reproduce calibration error"
+                   << "\n    calculated: " << sse
+                   << "\n    expected:   " << expected);
+    }
+}
+
+void HestonModelTest::testBatchPricing() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing batch and FFT pricing of strike slices with the "
+        "analytic Heston engine...");
+
+    SavedSettings backup;
+
+    const Date settlementDate(27, December, 2004);
+    Settings::instance().evaluationDate() = settlementDate;
+    DayCounter dayCounter = ActualActual();
+
+    Handle<YieldTermStructure> riskFreeTS(flatRate(0.05, dayCounter));
+    Handle<YieldTermStructure> dividendTS(flatRate(0.02, dayCounter));
+    Handle<Quote> s0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+
+    boost::shared_ptr<HestonProcess> process(new HestonProcess(
+              riskFreeTS, dividendTS, s0, 0.04, 1.5, 0.06, 0.6, -0.7));
+    boost::shared_ptr<HestonModel> model(new HestonModel(process));
+
+    const Period maturities[] = { 1*Months, 6*Months, 2*Years, 5*Years };
+    const Real tolerance[] = { 1.0e-10, 1.0e-5 };
+    // the branch correction keeps a state along the nodes, which
+    // must be consistent with the cached exponents
+    const AnalyticHestonEngine::ComplexLogFormula formulas[] = {
+        AnalyticHestonEngine::Gatheral,
+        AnalyticHestonEngine::BranchCorrection
+    };
+
+    for (Size f=0; f<LENGTH(formulas); ++f) {
+      for (Size k=0; k<LENGTH(maturities); ++k) {
+        const Date exerciseDate = settlementDate + maturities[k];
+        boost::shared_ptr<Exercise> exercise(
+                                        new EuropeanExercise(exerciseDate));
+
+        std::vector<boost::shared_ptr<StrikedTypePayoff> > payoffs;
+        for (Real strike = 60.0; strike <= 160.0; strike += 5.0) {
+            payoffs.push_back(boost::shared_ptr<StrikedTypePayoff>(
+                           new PlainVanillaPayoff(Option::Call, strike)));
+            payoffs.push_back(boost::shared_ptr<StrikedTypePayoff>(
+                           new PlainVanillaPayoff(Option::Put, strike)));
+        }
+
+        const boost::shared_ptr<AnalyticHestonEngine> engine(
+            new AnalyticHestonEngine(
+                    model, formulas[f],
+                    AnalyticHestonEngine::Integration::gaussLaguerre(144)));
+        Array calculated[] = {
+            engine->values(exerciseDate, payoffs),
+            engine->fftValues(exerciseDate, payoffs)
+        };
+
+        for (Size i=0; i<payoffs.size(); ++i) {
+            // each option is priced by its own engine
+            VanillaOption option(payoffs[i], exercise);
+            option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                new AnalyticHestonEngine(
+                    model, formulas[f],
+                    AnalyticHestonEngine::Integration::gaussLaguerre(144))));
+            const Real expected = option.NPV();
+
+            for (Size m=0; m<LENGTH(calculated); ++m) {
+                if (std::fabs(calculated[m][i] - expected) > tolerance[m])
+                    BOOST_ERROR("failed to reproduce single-option price"
+                                << "\n    method:     "
+                                << (m == 0 ? "batch" : "FFT")
+                                << "\n    formula:    " << f
+                                << "\n    maturity:   " << maturities[k]
+                                << "\n    type:       "
+                                << payoffs[i]->optionType()
+                                << "\n    strike:     "
+                                << payoffs[i]->strike()
+                                << QL_FIXED << std::setprecision(10)
+                                << "\n    calculated: " << calculated[m][i]
+                                << "\n    expected:   " << expected);
+            }
+
+            // options priced in sequence reuse the cached exponents
+            option.setPricingEngine(engine);
+            if (std::fabs(option.NPV() - expected) > tolerance[0])
+                BOOST_ERROR("failed to reproduce single-option price "
+                            "with cached exponents"
+                            << "\n    formula:    " << f
+                            << "\n    maturity:   " << maturities[k]
+                            << "\n    strike:     " << payoffs[i]->strike()
+                            << QL_FIXED << std::setprecision(10)
+                            << "\n    calculated: " << option.NPV()
+                            << "\n    expected:   " << expected);
+        }
+      }
+    }
+}
+
 test_suite* HestonModelTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Heston model tests");
 
@@ -1232,6 +1563,15 @@ test_suite* HestonModelTest::suite() {
                     &HestonModelTest::testDAXCalibrationOfTimeDependentModel));
     suite->add(QUANTLIB_TEST_CASE(
                     &HestonModelTest::testAlanLewisReferencePrices));
+    suite->add(QUANTLIB_TEST_CASE(
+                    &HestonModelTest::testParallelDAXCalibration));
+    suite->add(QUANTLIB_TEST_CASE(
+                    &HestonModelTest::testParallelVsSerialCalibration));
+    suite->add(QUANTLIB_TEST_CASE(
+                    &HestonModelTest::testAnalyticParameterGradient));
+    suite->add(QUANTLIB_TEST_CASE(
+                    &HestonModelTest::testDAXCalibrationWithGradient));
+    suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testBatchPricing));
 
     return suite;
 }
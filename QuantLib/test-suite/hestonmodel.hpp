@@ -40,6 +40,11 @@ class HestonModelTest {
     static void testAnalyticPiecewiseTimeDependent();
     static void testDAXCalibrationOfTimeDependentModel();
     static void testAlanLewisReferencePrices();
+    static void testParallelDAXCalibration();
+    static void testParallelVsSerialCalibration();
+    static void testAnalyticParameterGradient();
+    static void testDAXCalibrationWithGradient();
+    static void testBatchPricing();
     static boost::unit_test_framework::test_suite* suite();
 };
 
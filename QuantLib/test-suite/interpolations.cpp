@@ -40,6 +40,8 @@
 #include <ql/math/randomnumbers/sobolrsg.hpp>
 #include <ql/math/optimization/levenbergmarquardt.hpp>
 #include <boost/foreach.hpp>
+#include <algorithm>
+#include <iomanip>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -1689,6 +1691,84 @@ void InterpolationTest::testRichardsonExtrapolation() {
 }
 
 
+namespace {
+
+    template <class I>
+    void checkSequentialLookup(const std::string& name,
+                               const std::vector<Real>& x,
+                               const std::vector<Real>& y,
+                               const I& interpolator) {
+        Interpolation f = interpolator.interpolate(x.begin(), x.end(),
+                                                   y.begin());
+        f.update();
+
+        // increasing, decreasing and scattered points; some of them
+        // are outside the grid or on its nodes
+        Size n = 1000;
+        std::vector<Real> points(n);
+        Real x1 = x.front()-1.0, x2 = x.back()+1.0;
+        for (Size i=0; i<n; ++i)
+            points[i] = x1 + (x2-x1)*i/(n-1);
+        for (Size i=0; i<x.size(); i+=3)
+            points.push_back(x[i]);
+        std::sort(points.begin(), points.end());
+
+        std::vector<Real> values(points.size());
+        f.values(points.begin(), points.end(), values.begin(), true);
+
+        std::vector<Real> order(points.size());
+        for (Size i=0; i<points.size(); ++i)
+            order[i] = points[points.size()-1-i];
+        for (Size i=0; i<points.size(); i+=7)
+            order.push_back(points[(i*389) % points.size()]);
+
+        for (Size i=0; i<points.size(); ++i) {
+            // a single lookup from a fresh interpolation
+            Interpolation g = interpolator.interpolate(x.begin(), x.end(),
+                                                       y.begin());
+            g.update();
+            Real expected = g(points[i], true);
+            if (values[i] != expected)
+                BOOST_FAIL(name << " interpolation at x = " << points[i]
+                           << std::setprecision(16)
+                           << "\n    sequential lookup: " << values[i]
+                           << "\n    single lookup:     " << expected);
+        }
+        // the hint is carried over from each lookup to the next
+        Size hint = 0;
+        for (Size i=0; i<order.size(); ++i) {
+            Interpolation g = interpolator.interpolate(x.begin(), x.end(),
+                                                       y.begin());
+            g.update();
+            Real expected = g(order[i], true);
+            Real calculated = f.value(order[i], hint, true);
+            if (calculated != expected)
+                BOOST_FAIL(name << " interpolation at x = " << order[i]
+                           << std::setprecision(16)
+                           << "\n    after previous lookups: " << calculated
+                           << "\n    single lookup:          " << expected);
+        }
+    }
+
+}
+
+void InterpolationTest::testSequentialLookup() {
+
+    BOOST_TEST_MESSAGE("Testing sequential lookup of interpolated values...");
+
+    std::vector<Real> x(50), y(50);
+    for (Size i=0; i<x.size(); ++i) {
+        x[i] = std::pow(Real(i), 1.5);
+        y[i] = std::sin(0.2*x[i]);
+    }
+
+    checkSequentialLookup("linear", x, y, Linear());
+    checkSequentialLookup("backward-flat", x, y, BackwardFlat());
+    checkSequentialLookup("forward-flat", x, y, ForwardFlat());
+    checkSequentialLookup("cubic", x, y, Cubic());
+}
+
+
 test_suite* InterpolationTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Interpolation tests");
 
@@ -1718,6 +1798,7 @@ test_suite* InterpolationTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testBicubicUpdate));
     suite->add(QUANTLIB_TEST_CASE(
                             &InterpolationTest::testRichardsonExtrapolation));
+    suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testSequentialLookup));
 
     return suite;
 }
@@ -23,6 +23,7 @@
 #include "utilities.hpp"
 #include <ql/math/matrix.hpp>
 #include <ql/math/matrixutilities/pseudosqrt.hpp>
+#include <ql/math/matrixutilities/choleskydecomposition.hpp>
 #include <ql/math/matrixutilities/svd.hpp>
 #include <ql/math/matrixutilities/symmetricschurdecomposition.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
@@ -95,6 +96,23 @@ namespace {
         M7[0][1] = 0.3; M7[0][2] = 0.2; M7[2][1] = 1.2;
     }
 
+    Matrix randomMatrix(Size rows, Size columns,
+                        MersenneTwisterUniformRng& rng) {
+        Matrix m(rows, columns);
+        for (Size i=0; i<rows; ++i)
+            for (Size j=0; j<columns; ++j)
+                m[i][j] = rng.nextReal() - 0.5;
+        return m;
+    }
+
+    // reference product, one element at a time
+    Real product(const Matrix& A, Size i, const Matrix& B, Size j) {
+        Real sum = 0.0;
+        for (Size k=0; k<A.columns(); ++k)
+            sum += A[i][k]*B[k][j];
+        return sum;
+    }
+
 }
 
 
@@ -469,6 +487,157 @@ void MatricesTest::testOrthogonalProjection() {
 }
 
 
+void MatricesTest::testProducts() {
+
+    BOOST_TEST_MESSAGE("Testing matrix products...");
+
+    MersenneTwisterUniformRng rng(1234);
+    Real tolerance = 1.0e-12;
+
+    // sizes around and across the block sizes of the kernels
+    Size sizes[][3] = { { 1, 1, 1 }, { 3, 5, 7 }, { 7, 300, 9 },
+                        { 130, 270, 513 }, { 65, 33, 260 }, { 4, 0, 5 } };
+
+    for (Size n=0; n<LENGTH(sizes); ++n) {
+        Size rows = sizes[n][0], inner = sizes[n][1], columns = sizes[n][2];
+        Matrix A = randomMatrix(rows, inner, rng);
+        Matrix B = randomMatrix(inner, columns, rng);
+        Matrix C = randomMatrix(inner, rows, rng);
+        Array v(rows), w(inner);
+        for (Size i=0; i<rows; ++i)
+            v[i] = rng.nextReal();
+        for (Size i=0; i<inner; ++i)
+            w[i] = rng.nextReal();
+
+        Matrix AB = A*B;
+        Matrix CtB = transposedProduct(C, B);
+        Matrix AAt = symmetricProduct(A);
+        Matrix At = transpose(A), Ct = transpose(C);
+        Array vA = v*A, Aw = A*w;
+
+        for (Size i=0; i<rows; ++i) {
+            for (Size j=0; j<columns; ++j) {
+                Real expected = product(A, i, B, j);
+                if (std::fabs(AB[i][j]-expected) > tolerance)
+                    BOOST_ERROR("wrong product of " << rows << "x" << inner
+                                << " and " << inner << "x" << columns
+                                << " matrices at (" << i << "," << j << "):"
+                                << "\n    calculated: " << AB[i][j]
+                                << "\n    expected:   " << expected);
+                expected = product(Ct, i, B, j);
+                if (std::fabs(CtB[i][j]-expected) > tolerance)
+                    BOOST_ERROR("wrong transposed product at ("
+                                << i << "," << j << "):"
+                                << "\n    calculated: " << CtB[i][j]
+                                << "\n    expected:   " << expected);
+            }
+            for (Size j=0; j<rows; ++j) {
+                Real expected = product(A, i, At, j);
+                if (std::fabs(AAt[i][j]-expected) > tolerance
+                    || AAt[i][j] != AAt[j][i])
+                    BOOST_ERROR("wrong symmetric product at ("
+                                << i << "," << j << "):"
+                                << "\n    calculated: " << AAt[i][j]
+                                << "\n    expected:   " << expected);
+            }
+            Real expected = 0.0;
+            for (Size k=0; k<inner; ++k) {
+                expected += A[i][k]*w[k];
+                if (At[k][i] != A[i][k])
+                    BOOST_ERROR("wrong transposed element at ("
+                                << k << "," << i << ")");
+            }
+            if (std::fabs(Aw[i]-expected) > tolerance)
+                BOOST_ERROR("wrong matrix-vector product at " << i << ":"
+                            << "\n    calculated: " << Aw[i]
+                            << "\n    expected:   " << expected);
+        }
+        for (Size k=0; k<inner; ++k) {
+            Real expected = 0.0;
+            for (Size i=0; i<rows; ++i)
+                expected += v[i]*A[i][k];
+            if (std::fabs(vA[k]-expected) > tolerance)
+                BOOST_ERROR("wrong vector-matrix product at " << k << ":"
+                            << "\n    calculated: " << vA[k]
+                            << "\n    expected:   " << expected);
+        }
+    }
+}
+
+void MatricesTest::testLargeMultiplication() {
+
+    BOOST_TEST_MESSAGE("Testing product of large matrices...");
+
+    MersenneTwisterUniformRng rng(42);
+    Size size = 500;
+    Matrix A = randomMatrix(size, size, rng);
+    Matrix B = randomMatrix(size, size, rng);
+
+    Matrix AB = A*B;
+
+    for (Size n=0; n<100; ++n) {
+        Size i = Size(rng.nextReal()*size), j = Size(rng.nextReal()*size);
+        Real expected = product(A, i, B, j);
+        if (std::fabs(AB[i][j]-expected) > 1.0e-10)
+            BOOST_ERROR("wrong product at (" << i << "," << j << "):"
+                        << "\n    calculated: " << AB[i][j]
+                        << "\n    expected:   " << expected);
+    }
+}
+
+void MatricesTest::testLargeSymmetricProduct() {
+
+    BOOST_TEST_MESSAGE("Testing symmetric product of a large matrix...");
+
+    MersenneTwisterUniformRng rng(42);
+    Size size = 500;
+    Matrix A = randomMatrix(size, size, rng);
+
+    Matrix AAt = symmetricProduct(A);
+
+    for (Size n=0; n<100; ++n) {
+        Size i = Size(rng.nextReal()*size), j = Size(rng.nextReal()*size);
+        Real expected = 0.0;
+        for (Size k=0; k<size; ++k)
+            expected += A[i][k]*A[j][k];
+        if (std::fabs(AAt[i][j]-expected) > 1.0e-10)
+            BOOST_ERROR("wrong symmetric product at ("
+                        << i << "," << j << "):"
+                        << "\n    calculated: " << AAt[i][j]
+                        << "\n    expected:   " << expected);
+    }
+}
+
+void MatricesTest::testLargeCholesky() {
+
+    BOOST_TEST_MESSAGE("Testing Cholesky decomposition of a large matrix...");
+
+    // the correlation matrix rho^|i-j| has the known decomposition
+    // L[i][0] = rho^i, L[i][j] = rho^(i-j) sqrt(1-rho^2) for 0<j<=i
+    Size size = 800;
+    Real rho = 0.99;
+    Matrix correlation(size, size);
+    for (Size i=0; i<size; ++i)
+        for (Size j=0; j<size; ++j)
+            correlation[i][j] = std::pow(rho, std::fabs(Real(i)-Real(j)));
+
+    Matrix L = CholeskyDecomposition(correlation);
+
+    Real c = std::sqrt(1.0-rho*rho);
+    for (Size i=0; i<size; i+=7) {
+        for (Size j=0; j<size; ++j) {
+            Real expected = j > i ? 0.0 :
+                            j == 0 ? std::pow(rho, Real(i)) :
+                                     std::pow(rho, Real(i-j))*c;
+            if (std::fabs(L[i][j]-expected) > 1.0e-10)
+                BOOST_ERROR("wrong Cholesky factor at ("
+                            << i << "," << j << "):"
+                            << "\n    calculated: " << L[i][j]
+                            << "\n    expected:   " << expected);
+        }
+    }
+}
+
 
 test_suite* MatricesTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Matrix tests");
@@ -480,6 +649,10 @@ test_suite* MatricesTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testHighamSqrt));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testQRDecomposition));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testQRSolve));
+    suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testProducts));
+    suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testLargeMultiplication));
+    suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testLargeSymmetricProduct));
+    suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testLargeCholesky));
     #if !defined(QL_NO_UBLAS_SUPPORT)
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testInverse));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testDeterminant));
@@ -37,6 +37,10 @@ class MatricesTest {
     static void testInverse();
     static void testDeterminant();
     static void testOrthogonalProjection();
+    static void testProducts();
+    static void testLargeMultiplication();
+    static void testLargeSymmetricProduct();
+    static void testLargeCholesky();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -294,6 +294,93 @@ void MCLongstaffSchwartzEngineTest::testAmericanMaxOption() {
     }
 }
 
+void MCLongstaffSchwartzEngineTest::testStreamingCalibration() {
+
+    BOOST_TEST_MESSAGE("Testing streaming calibration of "
+                       "Longstaff-Schwartz engines...");
+
+    SavedSettings backup;
+
+    const Date today(15, May, 1998);
+    Settings::instance().evaluationDate() = today;
+    const DayCounter dayCounter = Actual365Fixed();
+
+    Handle<Quote> underlying(
+        boost::shared_ptr<Quote>(new SimpleQuote(36.0)));
+    Handle<YieldTermStructure> riskFreeTS(flatRate(today, 0.06, dayCounter));
+    Handle<YieldTermStructure> dividendTS(flatRate(today, 0.00, dayCounter));
+    Handle<BlackVolTermStructure> volTS(flatVol(today, 0.20, dayCounter));
+
+    boost::shared_ptr<GeneralizedBlackScholesProcess> process(
+        new GeneralizedBlackScholesProcess(underlying, dividendTS,
+                                           riskFreeTS, volTS));
+
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+        new PlainVanillaPayoff(Option::Put, 40.0));
+    boost::shared_ptr<Exercise> exercise(
+        new AmericanExercise(today, today + 1*Years));
+    VanillaOption option(payoff, exercise);
+
+    for (Size i=0; i<2; ++i) {
+        const bool antithetic = (i == 1);
+
+        option.setPricingEngine(
+            MakeMCAmericanEngine<PseudoRandom>(process)
+            .withSteps(20)
+            .withAntitheticVariate(antithetic)
+            .withSamples(2048)
+            .withCalibrationSamples(1024)
+            .withSeed(42));
+        const Real stored = option.NPV();
+
+        option.setPricingEngine(
+            MakeMCAmericanEngine<PseudoRandom>(process)
+            .withSteps(20)
+            .withAntitheticVariate(antithetic)
+            .withSamples(2048)
+            .withCalibrationSamples(1024)
+            .withSeed(42)
+            .withStreamingCalibration());
+        const Real streamed = option.NPV();
+        const Real errorEstimate = option.errorEstimate();
+
+        // the regression is performed on the same paths; differences
+        // are due to the different linear solver and can only affect
+        // paths lying on the exercise boundary
+        if (std::fabs(stored - streamed) > 0.05*errorEstimate) {
+            BOOST_ERROR("Failed to reproduce price with stored "
+                        "calibration paths"
+                        << "\n    antithetic: " << antithetic
+                        << "\n    stored:     " << stored
+                        << "\n    streamed:   " << streamed
+                        << "\n    error estimate: " << errorEstimate);
+        }
+
+        // without a seed, all the passes must still see the same
+        // paths; the price can only be checked statistically
+        option.setPricingEngine(
+            MakeMCAmericanEngine<PseudoRandom>(process)
+            .withSteps(20)
+            .withAntitheticVariate(antithetic)
+            .withSamples(2048)
+            .withCalibrationSamples(1024)
+            .withStreamingCalibration());
+        const Real unseeded = option.NPV();
+        const Real tolerance =
+            4.0*std::sqrt(errorEstimate*errorEstimate
+                          + option.errorEstimate()*option.errorEstimate());
+
+        if (std::fabs(stored - unseeded) > tolerance) {
+            BOOST_ERROR("Failed to reproduce price with streaming "
+                        "calibration and no given seed"
+                        << "\n    antithetic: " << antithetic
+                        << "\n    stored:     " << stored
+                        << "\n    streamed:   " << unseeded
+                        << "\n    tolerance:  " << tolerance);
+        }
+    }
+}
+
 test_suite* MCLongstaffSchwartzEngineTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Longstaff Schwartz MC engine tests");
     // FLOATING_POINT_EXCEPTION
@@ -301,6 +388,8 @@ test_suite* MCLongstaffSchwartzEngineTest::suite() {
          &MCLongstaffSchwartzEngineTest::testAmericanOption));
     suite->add(QUANTLIB_TEST_CASE(
          &MCLongstaffSchwartzEngineTest::testAmericanMaxOption));
+    suite->add(QUANTLIB_TEST_CASE(
+         &MCLongstaffSchwartzEngineTest::testStreamingCalibration));
     return suite;
 }
 
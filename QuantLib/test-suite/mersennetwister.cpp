@@ -482,9 +482,66 @@ void MersenneTwisterTest::testValues() {
 }
 
 
+void MersenneTwisterTest::testSkipping() {
+
+    BOOST_TEST_MESSAGE("Testing Mersenne twister skipping...");
+
+    unsigned long seed = 42;
+    Size drawn[] = { 0, 1, 100, 623, 624 };
+    BigNatural skip[] = { 1, 10, 396, 397, 624, 625, 100000 };
+
+    for (Size i=0; i<LENGTH(drawn); i++) {
+        for (Size j=0; j<LENGTH(skip); j++) {
+            MersenneTwisterUniformRng mt1(seed), mt2(seed);
+            for (Size k=0; k<drawn[i]; k++) {
+                mt1.nextInt32();
+                mt2.nextInt32();
+            }
+
+            // draw n numbers one by one
+            for (Size k=0; k<skip[j]; k++)
+                mt1.nextInt32();
+            // skip n numbers at once
+            mt2.skip(skip[j]);
+
+            for (Size k=0; k<1000; k++) {
+                unsigned long x1 = mt1.nextInt32(), x2 = mt2.nextInt32();
+                if (x1 != x2)
+                    BOOST_FAIL("Mismatch after skipping:"
+                               << "\n  drawn:    " << drawn[i]
+                               << "\n  skipped:  " << skip[j]
+                               << "\n  at index: " << k
+                               << "\n  expected: " << x1
+                               << "\n  found:    " << x2);
+            }
+        }
+    }
+
+    // large skips and jumps must compose
+    MersenneTwisterUniformRng mt1(seed), mt2(seed);
+    mt1.skip(BigNatural(1) << 30);
+    mt1.skip(BigNatural(1) << 31);
+    mt2.skip(BigNatural(3) << 30);
+    for (Size k=0; k<1000; k++) {
+        if (mt1.nextInt32() != mt2.nextInt32())
+            BOOST_FAIL("Mismatch after composing skips at index " << k);
+    }
+
+    MersenneTwisterUniformRng mt3(seed), mt4(seed);
+    mt3.jump(1);
+    mt3.jump(2);
+    mt4.jump(3);
+    for (Size k=0; k<1000; k++) {
+        if (mt3.nextInt32() != mt4.nextInt32())
+            BOOST_FAIL("Mismatch after composing jumps at index " << k);
+    }
+}
+
+
 test_suite* MersenneTwisterTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Mersenne twister tests");
     suite->add(QUANTLIB_TEST_CASE(&MersenneTwisterTest::testValues));
+    suite->add(QUANTLIB_TEST_CASE(&MersenneTwisterTest::testSkipping));
     return suite;
 }
 
@@ -19,12 +19,14 @@
 
 #include "pathgenerator.hpp"
 #include "utilities.hpp"
-#include <ql/methods/montecarlo/mctraits.hpp>
+#include <ql/methods/montecarlo/montecarlomodel.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/processes/geometricbrownianprocess.hpp>
 #include <ql/processes/ornsteinuhlenbeckprocess.hpp>
 #include <ql/processes/squarerootprocess.hpp>
 #include <ql/processes/stochasticprocessarray.hpp>
+#include <ql/pricingengines/vanilla/mceuropeanengine.hpp>
+#include <ql/pricingengines/asian/mc_discr_arith_av_price.hpp>
 #include <ql/time/daycounters/actual360.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/utilities/dataformatters.hpp>
@@ -290,11 +292,198 @@ void PathGeneratorTest::testMultiPathGenerator() {
 }
 
 
+namespace {
+
+    void testBlock(const boost::shared_ptr<StochasticProcess1D>& process,
+                   const std::string& tag, bool brownianBridge) {
+        typedef PseudoRandom::rsg_type rsg_type;
+        typedef PathGenerator<rsg_type>::sample_type sample_type;
+
+        BigNatural seed = 42;
+        Time length = 10;
+        Size timeSteps = 12, blockSize = 64;
+        rsg_type rsg = PseudoRandom::make_sequence_generator(timeSteps, seed);
+        PathGenerator<rsg_type> generator1(process, length, timeSteps,
+                                           rsg, brownianBridge);
+        PathGenerator<rsg_type> generator2(process, length, timeSteps,
+                                           rsg, brownianBridge);
+
+        EuropeanPathPricer europeanPricer(Option::Call, 100.0, 0.9);
+        ArithmeticAPOPathPricer asianPricer(Option::Put, 100.0, 0.9);
+        std::vector<Real> europeanValues, asianValues;
+
+        PathBlock block(generator2.timeGrid(), blockSize);
+        PathBlock antitheticBlock(generator2.timeGrid(), blockSize);
+        Real tolerance = 1.0e-12;
+        for (Size k=0; k<3; k++) {
+            generator2.nextBlock(block);
+            generator2.antitheticBlock(antitheticBlock);
+            europeanPricer(block, europeanValues);
+            asianPricer(block, asianValues);
+            for (Size j=0; j<blockSize; j++) {
+                const sample_type& sample = generator1.next();
+                for (Size i=0; i<block.length(); i++) {
+                    Real error = std::fabs(block(i,j) - sample.value[i]);
+                    if (error > tolerance*std::fabs(sample.value[i]))
+                        BOOST_FAIL("using " << tag << " process "
+                                   << (brownianBridge ? "with " : "without ")
+                                   << "brownian bridge:\n"
+                                   << "mismatch at step " << i
+                                   << " of path " << j << " in block "
+                                   << k << ":\n"
+                                   << std::setprecision(13)
+                                   << "    block value: " << block(i,j)
+                                   << "\n"
+                                   << "    path value:  " << sample.value[i]);
+                }
+                if (block.weight(j) != sample.weight)
+                    BOOST_FAIL("using " << tag << " process: "
+                               << "weight mismatch for path " << j);
+
+                Real expected = europeanPricer(sample.value);
+                if (std::fabs(europeanValues[j]-expected)
+                                     > tolerance*(1.0+std::fabs(expected)))
+                    BOOST_FAIL("using " << tag << " process: "
+                               << "European block pricer mismatch:\n"
+                               << std::setprecision(13)
+                               << "    block value: " << europeanValues[j]
+                               << "\n"
+                               << "    path value:  " << expected);
+                expected = asianPricer(sample.value);
+                if (std::fabs(asianValues[j]-expected)
+                                     > tolerance*(1.0+std::fabs(expected)))
+                    BOOST_FAIL("using " << tag << " process: "
+                               << "Asian block pricer mismatch:\n"
+                               << std::setprecision(13)
+                               << "    block value: " << asianValues[j]
+                               << "\n"
+                               << "    path value:  " << expected);
+
+                const sample_type& antithetic = generator1.antithetic();
+                for (Size i=0; i<block.length(); i++) {
+                    Real error = std::fabs(antitheticBlock(i,j)
+                                           - antithetic.value[i]);
+                    if (error > tolerance*std::fabs(antithetic.value[i]))
+                        BOOST_FAIL("using " << tag << " process "
+                                   << (brownianBridge ? "with " : "without ")
+                                   << "brownian bridge:\n"
+                                   << "antithetic mismatch at step " << i
+                                   << " of path " << j << " in block "
+                                   << k << ":\n"
+                                   << std::setprecision(13)
+                                   << "    block value: "
+                                   << antitheticBlock(i,j) << "\n"
+                                   << "    path value:  "
+                                   << antithetic.value[i]);
+                }
+                if (antitheticBlock.weight(j) != antithetic.weight)
+                    BOOST_FAIL("using " << tag << " process: "
+                               << "weight mismatch for antithetic path "
+                               << j);
+            }
+        }
+    }
+
+    // hides the block interface of the wrapped pricer
+    class PathOnlyPricer : public PathPricer<Path> {
+      public:
+        explicit PathOnlyPricer(const boost::shared_ptr<PathPricer<Path> >& p)
+        : pricer_(p) {}
+        Real operator()(const Path& path) const { return (*pricer_)(path); }
+      private:
+        boost::shared_ptr<PathPricer<Path> > pricer_;
+    };
+
+    void testBlockSampling(Size workers) {
+        typedef PseudoRandom::rsg_type rsg_type;
+        typedef MonteCarloModel<SingleVariate,PseudoRandom> model_type;
+
+        boost::shared_ptr<StochasticProcess1D> process(
+                       new GeometricBrownianMotionProcess(100.0, 0.03, 0.20));
+        boost::shared_ptr<PathPricer<Path> > pricer(
+                          new ArithmeticAPOPathPricer(Option::Put, 100.0, 0.9));
+
+        std::vector<boost::shared_ptr<model_type::path_generator_type> >
+            generators1, generators2;
+        std::vector<boost::shared_ptr<PathPricer<Path> > >
+            blockPricers, pathPricers;
+        for (Size i=0; i<workers; i++) {
+            rsg_type rsg =
+                PseudoRandom::make_sequence_generator(12, 42, i, workers);
+            generators1.push_back(
+                boost::shared_ptr<model_type::path_generator_type>(
+                    new model_type::path_generator_type(process, 1.0, 12,
+                                                        rsg, false)));
+            generators2.push_back(
+                boost::shared_ptr<model_type::path_generator_type>(
+                    new model_type::path_generator_type(process, 1.0, 12,
+                                                        rsg, false)));
+            blockPricers.push_back(pricer);
+            pathPricers.push_back(boost::shared_ptr<PathPricer<Path> >(
+                                                 new PathOnlyPricer(pricer)));
+        }
+
+        // a few samples more than a block, then a partial one
+        model_type blocks(generators1, blockPricers, Statistics(), true);
+        model_type paths(generators2, pathPricers, Statistics(), true);
+        blocks.addSamples(1000);
+        blocks.addSamples(100);
+        paths.addSamples(1000);
+        paths.addSamples(100);
+
+        Real tolerance = 1.0e-12;
+        Real blockMean = blocks.sampleAccumulator().mean();
+        Real pathMean = paths.sampleAccumulator().mean();
+        if (blocks.sampleAccumulator().samples() != 1100
+            || std::fabs(blockMean-pathMean) > tolerance*pathMean)
+            BOOST_FAIL("Monte Carlo model with " << workers << " workers:\n"
+                       << "block sampling differs from path sampling:\n"
+                       << std::setprecision(13)
+                       << "    block samples: "
+                       << blocks.sampleAccumulator().samples() << "\n"
+                       << "    block mean:    " << blockMean << "\n"
+                       << "    path mean:     " << pathMean);
+    }
+
+}
+
+void PathGeneratorTest::testPathBlocks() {
+
+    BOOST_TEST_MESSAGE("Testing 1-D path generation in blocks...");
+
+    SavedSettings backup;
+
+    Settings::instance().evaluationDate() = Date(26,April,2005);
+
+    Handle<Quote> x0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> r(flatRate(0.05, Actual360()));
+    Handle<YieldTermStructure> q(flatRate(0.02, Actual360()));
+    Handle<BlackVolTermStructure> sigma(flatVol(0.20, Actual360()));
+
+    testBlock(boost::shared_ptr<StochasticProcess1D>(
+                                 new BlackScholesMertonProcess(x0,q,r,sigma)),
+              "Black-Scholes", false);
+    testBlock(boost::shared_ptr<StochasticProcess1D>(
+                                 new BlackScholesMertonProcess(x0,q,r,sigma)),
+              "Black-Scholes", true);
+    testBlock(boost::shared_ptr<StochasticProcess1D>(
+                       new GeometricBrownianMotionProcess(100.0, 0.03, 0.20)),
+              "geometric Brownian", false);
+    testBlock(boost::shared_ptr<StochasticProcess1D>(
+                                 new SquareRootProcess(0.1, 0.1, 0.20, 10.0)),
+              "square-root", true);
+
+    testBlockSampling(1);
+    testBlockSampling(3);
+}
+
+
 test_suite* PathGeneratorTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Path generation tests");
     suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testPathGenerator));
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testMultiPathGenerator));
+    suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testPathBlocks));
     return suite;
 }
 
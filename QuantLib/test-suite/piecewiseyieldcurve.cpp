@@ -20,6 +20,10 @@
 #include "piecewiseyieldcurve.hpp"
 #include "utilities.hpp"
 #include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
+#include <ql/experimental/risk/bucketedcurverisk.hpp>
+#include <ql/cashflows/cashflows.hpp>
+#include <ql/cashflows/fixedratecoupon.hpp>
+#include <ql/cashflows/simplecashflow.hpp>
 #include <ql/termstructures/yield/ratehelpers.hpp>
 #include <ql/termstructures/yield/bondhelpers.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
@@ -908,6 +912,226 @@ void PiecewiseYieldCurveTest::testZeroCopy() {
 
 
 
+void PiecewiseYieldCurveTest::testIncrementalBootstrap() {
+
+    BOOST_TEST_MESSAGE("Testing incremental bootstrap "
+                       "of piecewise yield curve...");
+
+    CommonVars vars, refVars;
+
+    typedef PiecewiseYieldCurve<Discount,LogLinear> Curve;
+    boost::shared_ptr<Curve> curve(
+        new Curve(vars.settlement, vars.instruments, Actual360()));
+    // reference curve, always bootstrapped from scratch
+    boost::shared_ptr<Curve> refCurve(
+        new Curve(vars.settlement, refVars.instruments, Actual360(),
+                  LogLinear(), IterativeBootstrap<Curve>(false)));
+
+    for (Size i=0; i<vars.deposits+vars.swaps; i++) {
+        std::vector<std::pair<Date,Real> > before = curve->nodes();
+
+        vars.rates[i]->setValue(vars.rates[i]->value()*1.01);
+        refVars.rates[i]->setValue(refVars.rates[i]->value()*1.01);
+
+        std::vector<std::pair<Date,Real> > after = curve->nodes();
+        std::vector<std::pair<Date,Real> > expected = refCurve->nodes();
+        Date changed = vars.instruments[i]->latestDate();
+
+        for (Size j=0; j<after.size(); ++j) {
+            if (after[j].first < changed) {
+                // pillars before the changed one are kept as they were
+                if (after[j].second != before[j].second)
+                    BOOST_FAIL("pillar at " << after[j].first
+                               << " modified by change of quote at "
+                               << changed);
+            } else if (std::fabs(after[j].second-expected[j].second)
+                       > 1.0e-10) {
+                BOOST_FAIL("pillar at " << after[j].first
+                           << " after change of quote at " << changed
+                           << std::setprecision(12)
+                           << "\n    incremental bootstrap: "
+                           << after[j].second
+                           << "\n    full bootstrap:        "
+                           << expected[j].second);
+            }
+        }
+
+        vars.rates[i]->setValue(vars.rates[i]->value()/1.01);
+        refVars.rates[i]->setValue(refVars.rates[i]->value()/1.01);
+    }
+
+    // a date change moves all pillars
+    Settings::instance().evaluationDate() =
+        vars.calendar.advance(vars.today,15,Days);
+    Curve movingCurve(vars.settlementDays, vars.calendar,
+                      vars.instruments, Actual360());
+    Curve movingRefCurve(vars.settlementDays, vars.calendar,
+                         refVars.instruments, Actual360(),
+                         LogLinear(), IterativeBootstrap<Curve>(false));
+    movingCurve.nodes();
+    Settings::instance().evaluationDate() = vars.today;
+    vars.rates[3]->setValue(vars.rates[3]->value()*1.01);
+    refVars.rates[3]->setValue(refVars.rates[3]->value()*1.01);
+    std::vector<std::pair<Date,Real> > after = movingCurve.nodes();
+    std::vector<std::pair<Date,Real> > expected = movingRefCurve.nodes();
+    for (Size j=0; j<after.size(); ++j) {
+        if (after[j].first != expected[j].first ||
+            std::fabs(after[j].second-expected[j].second) > 1.0e-10)
+            BOOST_FAIL("pillar at " << after[j].first
+                       << " after change of evaluation date:"
+                       << std::setprecision(12)
+                       << "\n    incremental bootstrap: "
+                       << after[j].second
+                       << "\n    full bootstrap:        "
+                       << expected[j].second);
+    }
+
+    // a change in a jump affects all the pillars after the jump date,
+    // even if it comes together with a change in a later helper
+    boost::shared_ptr<SimpleQuote> jump(new SimpleQuote(0.99));
+    std::vector<Handle<Quote> > jumps(1, Handle<Quote>(jump));
+    std::vector<Date> jumpDates(1,
+                                vars.calendar.advance(vars.settlement,
+                                                      2, Months));
+    Curve jumpCurve(vars.settlement, vars.instruments, Actual360(),
+                    jumps, jumpDates);
+    Curve jumpRefCurve(vars.settlement, refVars.instruments, Actual360(),
+                       jumps, jumpDates, 1.0e-12,
+                       LogLinear(), IterativeBootstrap<Curve>(false));
+    jumpCurve.nodes();
+    Size last = vars.deposits+vars.swaps-1;
+    vars.rates[last]->setValue(vars.rates[last]->value()*1.01);
+    refVars.rates[last]->setValue(refVars.rates[last]->value()*1.01);
+    jump->setValue(0.98);
+    after = jumpCurve.nodes();
+    expected = jumpRefCurve.nodes();
+    for (Size j=0; j<after.size(); ++j) {
+        if (std::fabs(after[j].second-expected[j].second) > 1.0e-10)
+            BOOST_FAIL("pillar at " << after[j].first
+                       << " after change of jump at " << jumpDates[0]
+                       << std::setprecision(12)
+                       << "\n    incremental bootstrap: "
+                       << after[j].second
+                       << "\n    full bootstrap:        "
+                       << expected[j].second);
+    }
+}
+
+
+void PiecewiseYieldCurveTest::testGlobalBootstrap() {
+
+    BOOST_TEST_MESSAGE("Testing global bootstrap of piecewise yield curve...");
+
+    CommonVars vars;
+
+    testCurveConsistency<ZeroYield,Cubic,GlobalBootstrap>(
+                   vars,
+                   Cubic(CubicInterpolation::Spline, true,
+                         CubicInterpolation::SecondDerivative, 0.0,
+                         CubicInterpolation::SecondDerivative, 0.0));
+    testCurveConsistency<Discount,LogLinear,GlobalBootstrap>(vars);
+
+    // the Jacobian must match the one obtained by bumping the
+    // quotes and bootstrapping again
+    typedef PiecewiseYieldCurve<ZeroYield,Linear,GlobalBootstrap> Curve;
+    Curve curve(vars.settlement, vars.instruments, Actual360());
+    Matrix jacobian = curve.jacobian();
+    std::vector<Real> data = curve.data();
+
+    Size n = vars.deposits+vars.swaps;
+    if (jacobian.rows() != data.size()-1 || jacobian.columns() != n)
+        BOOST_FAIL("wrong Jacobian size: " << jacobian.rows() << "x"
+                   << jacobian.columns() << " instead of "
+                   << data.size()-1 << "x" << n);
+
+    Real bump = 1.0e-6, tolerance = 1.0e-4;
+    for (Size j=0; j<n; ++j) {
+        Real rate = vars.rates[j]->value();
+        vars.rates[j]->setValue(rate+bump);
+        std::vector<Real> bumpedData = curve.data();
+        vars.rates[j]->setValue(rate);
+        for (Size i=0; i<jacobian.rows(); ++i) {
+            Real expected = (bumpedData[i+1]-data[i+1])/bump;
+            if (std::fabs(jacobian[i][j]-expected) > tolerance)
+                BOOST_FAIL("Jacobian element (" << i << "," << j << "):"
+                           << std::setprecision(8)
+                           << "\n    calculated: " << jacobian[i][j]
+                           << "\n    expected:   " << expected);
+        }
+    }
+}
+
+
+void PiecewiseYieldCurveTest::testBucketedRisk() {
+
+    BOOST_TEST_MESSAGE("Testing bucketed risk from the bootstrap Jacobian...");
+
+    CommonVars vars;
+
+    typedef PiecewiseYieldCurve<ZeroYield,Linear,GlobalBootstrap> Curve;
+    boost::shared_ptr<Curve> curve(
+        new Curve(vars.settlement, vars.instruments, Actual360()));
+
+    Schedule longSchedule = MakeSchedule().from(vars.settlement)
+                                          .to(vars.settlement+12*Years)
+                                          .withFrequency(Semiannual)
+                                          .withCalendar(vars.calendar);
+    Leg bond = FixedRateLeg(longSchedule)
+        .withNotionals(100.0)
+        .withCouponRates(0.04, Thirty360());
+    bond.push_back(boost::shared_ptr<CashFlow>(
+                    new SimpleCashFlow(100.0, longSchedule.endDate())));
+    Schedule shortSchedule = MakeSchedule().from(vars.settlement)
+                                           .to(vars.settlement+3*Years)
+                                           .withFrequency(Annual)
+                                           .withCalendar(vars.calendar);
+    Leg coupons = FixedRateLeg(shortSchedule)
+        .withNotionals(50.0)
+        .withCouponRates(0.03, Actual360());
+
+    std::vector<Leg> legs;
+    legs.push_back(bond);
+    legs.push_back(coupons);
+    std::vector<Real> quantities(2);
+    quantities[0] = 1.0;
+    quantities[1] = -2.0;
+    std::vector<CompiledLeg> compiledLegs;
+    for (Size k=0; k<legs.size(); ++k)
+        compiledLegs.push_back(CompiledLeg(legs[k], false,
+                                           vars.settlement));
+
+    BucketedCurveRisk<Curve> risk(curve);
+    Array deltas = risk.deltas(compiledLegs, quantities);
+
+    // compare with bump-and-rebuild
+    Size n = vars.deposits+vars.swaps;
+    if (deltas.size() != n)
+        BOOST_FAIL("wrong number of deltas: " << deltas.size()
+                   << " instead of " << n);
+    Real bump = 1.0e-5, tolerance = 1.0e-3;
+    for (Size j=0; j<n; ++j) {
+        Real rate = vars.rates[j]->value();
+        Real npv[2];
+        for (Size s=0; s<2; ++s) {
+            vars.rates[j]->setValue(s == 0 ? rate+bump : rate-bump);
+            npv[s] = 0.0;
+            for (Size k=0; k<legs.size(); ++k)
+                npv[s] += quantities[k] * CashFlows::npv(legs[k], *curve,
+                                                         false,
+                                                         vars.settlement);
+        }
+        vars.rates[j]->setValue(rate);
+        Real expected = (npv[0]-npv[1])/(2.0*bump);
+        if (std::fabs(deltas[j]-expected) > tolerance)
+            BOOST_FAIL("delta with respect to quote of "
+                       << io::ordinal(j+1) << " helper:"
+                       << std::setprecision(8)
+                       << "\n    calculated:     " << deltas[j]
+                       << "\n    bump-and-build: " << expected);
+    }
+}
+
+
 test_suite* PiecewiseYieldCurveTest::suite() {
 
     test_suite* suite = BOOST_TEST_SUITE("Piecewise yield curve tests");
@@ -947,6 +1171,11 @@ test_suite* PiecewiseYieldCurveTest::suite() {
              &PiecewiseYieldCurveTest::testLocalBootstrapConsistency));
 
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testObservability));
+    suite->add(QUANTLIB_TEST_CASE(
+                 &PiecewiseYieldCurveTest::testIncrementalBootstrap));
+    suite->add(QUANTLIB_TEST_CASE(
+                 &PiecewiseYieldCurveTest::testGlobalBootstrap));
+    suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testBucketedRisk));
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testLiborFixing));
 
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testJpyLibor));
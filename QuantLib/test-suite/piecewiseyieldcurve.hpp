@@ -43,6 +43,9 @@ class PiecewiseYieldCurveTest {
     static void testLocalBootstrapConsistency();
 
     static void testObservability();
+    static void testIncrementalBootstrap();
+    static void testGlobalBootstrap();
+    static void testBucketedRisk();
     static void testLiborFixing();
 
     static void testJpyLibor();
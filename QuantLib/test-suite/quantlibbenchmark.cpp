@@ -28,6 +28,8 @@
  The number of floating point operations of a given test case was measured
  using the perfex library, http://user.it.uu.se/~mikpe/linux/perfctr
  and PAPI, http://icl.cs.utk.edu/papi
+ Test cases without a measured number of operations are reported by their
+ running time and are not part of the index.
 
  Example results: 1. i7 870@2.93GHz         :4759.2 mflops
                   2. Core2 Q9300@2.5Ghz     :2272.6 mflops
@@ -74,12 +76,23 @@
 
 #include <ql/types.hpp>
 #include <ql/version.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
+#include <ql/math/matrixutilities/choleskydecomposition.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/instruments/vanillaoption.hpp>
+#include <ql/pricingengines/vanilla/fdhestonvanillaengine.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
 #include <boost/test/unit_test.hpp>
 #include <boost/timer.hpp>
 #include <iostream>
 #include <iomanip>
 #include <list>
 #include <string>
+#include <vector>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
 
 /* PAPI code
 #include <stdio.h
@@ -123,6 +136,7 @@
 #include "quantooption.hpp"
 #include "riskstats.hpp"
 #include "shortratemodels.hpp"
+#include "swap.hpp"
 
 using namespace boost::unit_test_framework;
 
@@ -135,6 +149,10 @@ namespace {
         Benchmark(std::string name, fct_ptr f, double mflop)
         : f_(f), name_(name), mflop_(mflop) {
         }
+        // no measured number of operations; reported by time only
+        Benchmark(std::string name, fct_ptr f)
+        : f_(f), name_(name), mflop_(0.0) {
+        }
 
         test_case* getTestCase() const {
             return QUANTLIB_TEST_CASE(f_);
@@ -142,6 +160,9 @@ namespace {
         double getMflop() const {
             return mflop_;
         }
+        bool hasMflop() const {
+            return mflop_ > 0.0;
+        }
         std::string getName() const {
             return name_;
         }
@@ -156,6 +177,136 @@ namespace {
     std::list<double> runTimes;
     std::list<Benchmark> bm;
 
+    /* Array and scalar versions of the inverse cumulative normal on
+       the same inputs, all of them in the central region of the
+       approximation: each value takes 24 floating point operations
+       (two for z and r, eleven for the numerator, ten for the
+       denominator and one division.)
+    */
+    const QuantLib::Size normalSamples = 1000000;
+    const QuantLib::Size normalRepetitions = 50;
+    const double normalMflop = 24.0e-6*normalSamples*normalRepetitions;
+    std::vector<QuantLib::Real> normalInputs, normalOutputs;
+
+    void initializeNormalInputs() {
+        if (normalInputs.empty()) {
+            normalInputs.resize(normalSamples);
+            normalOutputs.resize(normalSamples);
+            for (QuantLib::Size i=0; i<normalSamples; ++i)
+                normalInputs[i] = 0.025 + 0.95*(i+0.5)/normalSamples;
+        }
+    }
+
+    void inverseCumulativeNormalArray() {
+        using QuantLib::InverseCumulativeNormal;
+        initializeNormalInputs();
+        const QuantLib::Real* x = &normalInputs[0];
+        for (QuantLib::Size k=0; k<normalRepetitions; ++k)
+            InverseCumulativeNormal::standard_values(x, x+normalSamples,
+                                                     &normalOutputs[0]);
+    }
+
+    void inverseCumulativeNormalScalar() {
+        using QuantLib::InverseCumulativeNormal;
+        initializeNormalInputs();
+        for (QuantLib::Size k=0; k<normalRepetitions; ++k)
+            for (QuantLib::Size i=0; i<normalSamples; ++i)
+                normalOutputs[i] =
+                    InverseCumulativeNormal::standard_value(normalInputs[i]);
+    }
+
+    /* Dense linear-algebra kernels on fixed inputs, which are built
+       outside the timed loops at a negligible cost.  The flop counts
+       are the analytic ones: 2n^3 for the product of two n x n
+       matrices, n^2(n+1) for the symmetric product A*transpose(A),
+       of which a single triangle is calculated, and n^3/3 for the
+       Cholesky decomposition.
+    */
+    const QuantLib::Size matrixSize = 500, choleskySize = 800;
+    const QuantLib::Size matrixRepetitions = 4;
+    const double matrixSize3 = double(matrixSize)*matrixSize*matrixSize;
+    const double choleskySize3 =
+        double(choleskySize)*choleskySize*choleskySize;
+    const double productMflop = 2.0e-6*matrixSize3*matrixRepetitions;
+    const double symmetricProductMflop =
+        1.0e-6*matrixSize3*(matrixSize+1.0)/matrixSize*matrixRepetitions;
+    const double choleskyMflop = 1.0e-6*choleskySize3/3.0*matrixRepetitions;
+
+    QuantLib::Matrix randomMatrix(QuantLib::Size n) {
+        QuantLib::MersenneTwisterUniformRng rng(42);
+        QuantLib::Matrix m(n, n);
+        for (QuantLib::Size i=0; i<n; ++i)
+            for (QuantLib::Size j=0; j<n; ++j)
+                m[i][j] = rng.nextReal();
+        return m;
+    }
+
+    void matrixProduct() {
+        const QuantLib::Matrix A = randomMatrix(matrixSize),
+                               B = transpose(A);
+        for (QuantLib::Size k=0; k<matrixRepetitions; ++k)
+            QuantLib::Matrix AB = A*B;
+    }
+
+    void matrixSymmetricProduct() {
+        const QuantLib::Matrix A = randomMatrix(matrixSize);
+        for (QuantLib::Size k=0; k<matrixRepetitions; ++k)
+            QuantLib::Matrix AAt = symmetricProduct(A);
+    }
+
+    void matrixCholesky() {
+        // the correlation matrix rho^|i-j|, which is positive definite
+        QuantLib::Real rho = 0.99;
+        std::vector<QuantLib::Real> powers(choleskySize, 1.0);
+        for (QuantLib::Size i=1; i<choleskySize; ++i)
+            powers[i] = powers[i-1]*rho;
+        QuantLib::Matrix correlation(choleskySize, choleskySize);
+        for (QuantLib::Size i=0; i<choleskySize; ++i)
+            for (QuantLib::Size j=0; j<choleskySize; ++j)
+                correlation[i][j] = powers[i > j ? i-j : j-i];
+        for (QuantLib::Size k=0; k<matrixRepetitions; ++k)
+            QuantLib::Matrix L = QuantLib::CholeskyDecomposition(correlation);
+    }
+
+    /* The American option of FdHestonTest::testFdmHestonAmerican,
+       with the operators split across all available threads.  The
+       threads share the same operations, so that the flop count is
+       the one measured for the single-threaded test.
+    */
+    void fdHestonAmericanMultiThreaded() {
+        using namespace QuantLib;
+
+        SavedSettings backup;
+        Settings::instance().evaluationDate() = Date(28, March, 2004);
+
+        Handle<Quote> s0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+        Handle<YieldTermStructure> rTS(flatRate(0.05, Actual365Fixed()));
+        Handle<YieldTermStructure> qTS(flatRate(0.0 , Actual365Fixed()));
+        boost::shared_ptr<HestonModel> model(new HestonModel(
+            boost::shared_ptr<HestonProcess>(
+               new HestonProcess(rTS, qTS, s0, 0.04, 2.5, 0.04, 0.66, -0.8))));
+
+        boost::shared_ptr<Exercise> exercise(
+                            new AmericanExercise(Date(28, March, 2005)));
+        boost::shared_ptr<StrikedTypePayoff> payoff(
+                                new PlainVanillaPayoff(Option::Put, 100));
+        VanillaOption option(payoff, exercise);
+
+        #if defined(_OPENMP)
+        const Size threads = omp_get_max_threads();
+        #else
+        const Size threads = 1;
+        #endif
+        const FdmSchemeDesc hundsdorfer = FdmSchemeDesc::Hundsdorfer();
+        const FdmSchemeDesc scheme(hundsdorfer.type, hundsdorfer.theta,
+                                   hundsdorfer.mu, threads);
+        option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                   new FdHestonVanillaEngine(model, 200, 100, 50, 0, scheme)));
+        option.NPV();
+        option.delta();
+        option.gamma();
+    }
+
     /* PAPI code
     float real_time, proc_time, mflops;
     long_long lflop, flop=0;
@@ -195,26 +346,46 @@ namespace {
                   << std::endl << std::endl;
 
         double sum=0;
+        int measured=0;
+        // the matrix kernels have analytic flop counts, so that
+        // their combined rate is also reported
+        double matrixMflop=0, matrixTime=0;
         std::list<double>::const_iterator iterT = runTimes.begin();
         std::list<Benchmark>::const_iterator iterBM = bm.begin();
 
         while (iterT != runTimes.end()) {
-            const double mflopsPerSec = iterBM->getMflop()/(*iterT);
             std::cout << iterBM->getName()
                       << std::string(42-iterBM->getName().length(),' ') << ":"
-                      << std::fixed << std::setw(6) << std::setprecision(1)
-                      << mflopsPerSec
+                      << std::fixed << std::setw(6) << std::setprecision(1);
+            if (!iterBM->hasMflop()) {
+                std::cout << *iterT << " s" << std::endl;
+                iterT++;
+                iterBM++;
+                continue;
+            }
+            const double mflopsPerSec = iterBM->getMflop()/(*iterT);
+            std::cout << mflopsPerSec
                       << " mflops" << std::endl;
 
+            if (iterBM->getName().compare(0, 8, "Matrix::") == 0) {
+                matrixMflop += iterBM->getMflop();
+                matrixTime += *iterT;
+            }
             sum+=mflopsPerSec;
+            ++measured;
             iterT++;
             iterBM++;
         }
         std::cout << std::string(56,'-') << std::endl
                   << "QuantLib Benchmark Index                  :"
                   << std::fixed << std::setw(6) << std::setprecision(1)
-                  << sum/runTimes.size()
+                  << sum/measured
                   << " mflops" << std::endl;
+        if (matrixTime > 0.0)
+            std::cout << "Matrix kernels                            :"
+                      << std::fixed << std::setw(6) << std::setprecision(2)
+                      << matrixMflop/matrixTime/1000.0
+                      << " gflops" << std::endl;
     }
 }
 
@@ -242,10 +413,16 @@ test_suite* init_unit_test_suite(int, char*[]) {
         &BasketOptionTest::testOddSamples, 642.46));
     bm.push_back(Benchmark("BatesModel::DAXCalibration",
         &BatesModelTest::testDAXCalibration, 1993.35));
+    bm.push_back(Benchmark("BatesModel::ParallelDAXCalibration",
+        &BatesModelTest::testParallelDAXCalibration));
     bm.push_back(Benchmark("ConvertibleBondTest::testBond",
         &ConvertibleBondTest::testBond, 159.85));
     bm.push_back(Benchmark("DigitalOption::MCCashAtHit",
         &DigitalOptionTest::testMCCashAtHit,995.87));
+    bm.push_back(Benchmark("Distribution::InverseNormalArray",
+        &inverseCumulativeNormalArray, normalMflop));
+    bm.push_back(Benchmark("Distribution::InverseNormalScalar",
+        &inverseCumulativeNormalScalar, normalMflop));
     bm.push_back(Benchmark("DividendOption::FdEuropeanGreeks",
         &DividendOptionTest::testFdEuropeanGreeks, 949.52));
     bm.push_back(Benchmark("DividendOption::FdAmericanGreeks",
@@ -260,8 +437,12 @@ test_suite* init_unit_test_suite(int, char*[]) {
         &EuropeanOptionTest::testPriceCurve, 414.76));
     bm.push_back(Benchmark("FdHestonTest::testFdmHestonAmerican",
         &FdHestonTest::testFdmHestonAmerican, 234.21));
+    bm.push_back(Benchmark("FdHestonTest::AmericanMultiThreaded",
+        &fdHestonAmericanMultiThreaded, 234.21));
     bm.push_back(Benchmark("HestonModel::DAXCalibration",
         &HestonModelTest::testDAXCalibration, 555.19));
+    bm.push_back(Benchmark("HestonModel::ParallelDAXCalibration",
+        &HestonModelTest::testParallelDAXCalibration));
     bm.push_back(Benchmark("InterpolationTest::testSabrInterpolation",
         &InterpolationTest::testSabrInterpolation, 2266.06));
     bm.push_back(Benchmark("JumpDiffusion::Greeks",
@@ -272,6 +453,12 @@ test_suite* init_unit_test_suite(int, char*[]) {
     bm.push_back(Benchmark("MarketModelSmmTest::testMultiSmmSwaptions",
         &MarketModelSmmTest::testMultiStepCoterminalSwapsAndSwaptions,
         11244.95));
+    bm.push_back(Benchmark("Matrix::Product",
+        &matrixProduct, productMflop));
+    bm.push_back(Benchmark("Matrix::SymmetricProduct",
+        &matrixSymmetricProduct, symmetricProductMflop));
+    bm.push_back(Benchmark("Matrix::Cholesky",
+        &matrixCholesky, choleskyMflop));
     bm.push_back(Benchmark("QuantoOption::ForwardGreeks",
         &QuantoOptionTest::testForwardGreeks, 90.98));
     bm.push_back(Benchmark("RandomNumber::MersenneTwisterDescrepancy",
@@ -280,6 +467,8 @@ test_suite* init_unit_test_suite(int, char*[]) {
         &RiskStatisticsTest::testResults, 300.28));
     bm.push_back(Benchmark("ShortRateModel::Swaps",
         &ShortRateModelTest::testSwaps, 454.73));
+    bm.push_back(Benchmark("Swap::LargePortfolio",
+        &SwapTest::testLargePortfolio));
 
     test_suite* test = BOOST_TEST_SUITE("QuantLib benchmark suite");
 
@@ -137,7 +137,9 @@
 #include "rngtraits.hpp"
 #include "rounding.hpp"
 #include "sampledcurve.hpp"
+#include "scenarioanalysis.hpp"
 #include "schedule.hpp"
+#include "settings.hpp"
 #include "shortratemodels.hpp"
 #include "solvers.hpp"
 #include "spreadoption.hpp"
@@ -328,6 +330,9 @@ test_suite* init_unit_test_suite(int, char* []) {
     test->add(RoundingTest::suite());
     test->add(SampledCurveTest::suite());
     test->add(ScheduleTest::suite());
+    #if defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+    test->add(SettingsTest::suite());
+    #endif
     test->add(ShortRateModelTest::suite()); // fails with QL_USE_INDEXED_COUPON
     test->add(Solver1DTest::suite());
     test->add(StatisticsTest::suite());
@@ -369,6 +374,7 @@ test_suite* init_unit_test_suite(int, char* []) {
     test->add(NthToDefaultTest::suite());
     test->add(OdeTest::suite());
     test->add(PagodaOptionTest::suite());
+    test->add(ScenarioAnalysisTest::suite());
     test->add(SpreadOptionTest::suite());
     test->add(SwingOptionTest::suite());
     test->add(TwoAssetBarrierOptionTest::suite());
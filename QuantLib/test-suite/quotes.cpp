@@ -43,6 +43,32 @@ namespace {
     Real mul(Real x, Real y) { return x*y; }
     Real sub(Real x, Real y) { return x-y; }
 
+    class UpdateCounter : public Observer {
+      public:
+        UpdateCounter() : counter_(0) {}
+        void update() { ++counter_; }
+        Size counter() const { return counter_; }
+      private:
+        Size counter_;
+    };
+
+    // destroys its target when notified
+    class ObserverRemover : public Observer {
+      public:
+        explicit ObserverRemover(Size& updates)
+        : updates_(updates), target_(0) {}
+        void setTarget(boost::shared_ptr<ObserverRemover>* target) {
+            target_ = target;
+        }
+        void update() {
+            ++updates_;
+            target_->reset();
+        }
+      private:
+        Size& updates_;
+        boost::shared_ptr<ObserverRemover>* target_;
+    };
+
 }
 
 
@@ -196,10 +222,89 @@ void QuoteTest::testForwardValueQuoteAndImpliedStdevQuote(){
 }
 
 
+void QuoteTest::testDeferredNotifications() {
+
+    BOOST_TEST_MESSAGE("Testing deferred notifications of quotes...");
+
+    ObservableSettings& settings = ObservableSettings::instance();
+
+    std::vector<boost::shared_ptr<SimpleQuote> > quotes;
+    UpdateCounter counter;
+    for (Size i=0; i<5; ++i) {
+        quotes.push_back(boost::shared_ptr<SimpleQuote>(new SimpleQuote));
+        counter.registerWith(quotes.back());
+    }
+
+    // deferred notifications reach each observer once
+    settings.disableUpdates(true);
+    for (Size j=0; j<3; ++j)
+        for (Size i=0; i<quotes.size(); ++i)
+            quotes[i]->setValue(i+j+1.0);
+    Size notified = counter.counter();
+    {
+        // observers destroyed before the end of the batch are skipped
+        UpdateCounter temporary;
+        temporary.registerWith(quotes.front());
+        quotes.front()->setValue(42.0);
+    }
+    settings.enableUpdates();
+
+    if (notified != 0)
+        BOOST_ERROR("observer notified while updates were deferred");
+    if (counter.counter() != 1)
+        BOOST_ERROR("observer notified " << counter.counter()
+                    << " times after enabling deferred updates "
+                    << "(once expected)");
+
+    // discarded notifications never reach the observer
+    settings.disableUpdates(false);
+    for (Size i=0; i<quotes.size(); ++i)
+        quotes[i]->setValue(i+10.0);
+    settings.enableUpdates();
+
+    if (counter.counter() != 1)
+        BOOST_ERROR("observer notified while updates were disabled");
+
+    // normal notification is restored
+    quotes.back()->setValue(0.0);
+    if (counter.counter() != 2)
+        BOOST_ERROR("observer not notified after enabling updates");
+}
+
+void QuoteTest::testObserversRemovedDuringNotification() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing observers destroyed during a notification...");
+
+    boost::shared_ptr<SimpleQuote> quote(new SimpleQuote(0.0));
+
+    // whichever is notified first destroys the other, which must
+    // not be notified afterwards
+    Size updates = 0;
+    boost::shared_ptr<ObserverRemover> first(new ObserverRemover(updates));
+    boost::shared_ptr<ObserverRemover> second(new ObserverRemover(updates));
+    first->setTarget(&second);
+    second->setTarget(&first);
+    first->registerWith(quote);
+    second->registerWith(quote);
+
+    quote->setValue(1.0);
+
+    if (updates != 1)
+        BOOST_ERROR(updates << " observers notified (one expected)");
+    if (first && second)
+        BOOST_ERROR("no observer destroyed");
+}
+
+
+
 test_suite* QuoteTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Quote tests");
     suite->add(QUANTLIB_TEST_CASE(&QuoteTest::testObservable));
     suite->add(QUANTLIB_TEST_CASE(&QuoteTest::testObservableHandle));
+    suite->add(QUANTLIB_TEST_CASE(&QuoteTest::testDeferredNotifications));
+    suite->add(QUANTLIB_TEST_CASE(
+                     &QuoteTest::testObserversRemovedDuringNotification));
     suite->add(QUANTLIB_TEST_CASE(&QuoteTest::testDerived));
     suite->add(QUANTLIB_TEST_CASE(&QuoteTest::testComposite));
     suite->add(QUANTLIB_TEST_CASE(
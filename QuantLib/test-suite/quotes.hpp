@@ -29,6 +29,8 @@ class QuoteTest {
   public:
     static void testObservable();
     static void testObservableHandle();
+    static void testDeferredNotifications();
+    static void testObserversRemovedDuringNotification();
     static void testDerived();
     static void testComposite();
     static void testForwardValueQuoteAndImpliedStdevQuote();
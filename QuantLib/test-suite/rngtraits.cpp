@@ -92,11 +92,73 @@ void RngTraitsTest::testCustomPoisson() {
 }
 
 
+void RngTraitsTest::testSubstreams() {
+
+    BOOST_TEST_MESSAGE("Testing random-number substreams...");
+
+    Size dimension = 10, streams = 4;
+    BigNatural seed = 1234;
+
+    // the first substream is the plain sequence
+    PseudoRandom::rsg_type rsg =
+        PseudoRandom::make_sequence_generator(dimension, seed);
+    PseudoRandom::rsg_type first =
+        PseudoRandom::make_sequence_generator(dimension, seed, 0, streams);
+    for (Size i=0; i<100; i++) {
+        if (rsg.nextSequence().value != first.nextSequence().value)
+            BOOST_FAIL("first substream differs from plain sequence");
+    }
+
+    // the others start further along the same sequence
+    for (Size stream=1; stream<streams; stream++) {
+        MersenneTwisterUniformRng mt(seed);
+        mt.jump(stream);
+        RandomSequenceGenerator<MersenneTwisterUniformRng> ursg(dimension,
+                                                                mt);
+        InverseCumulativeRsg<RandomSequenceGenerator<
+                                 MersenneTwisterUniformRng>,
+                             InverseCumulativeNormal> expected(ursg);
+        PseudoRandom::rsg_type calculated =
+            PseudoRandom::make_sequence_generator(dimension, seed,
+                                                  stream, streams);
+        for (Size i=0; i<100; i++) {
+            if (expected.nextSequence().value
+                != calculated.nextSequence().value)
+                BOOST_FAIL("substream " << stream << " not matching "
+                           "jumped generator at draw " << i);
+        }
+    }
+
+    // low-discrepancy substreams are positioned by the caller
+    for (Size stream=1; stream<streams; stream++) {
+        LowDiscrepancy::rsg_type ldsg =
+            LowDiscrepancy::make_sequence_generator(dimension, 0);
+        LowDiscrepancy::rsg_type calculated =
+            LowDiscrepancy::make_sequence_generator(dimension, 0,
+                                                    stream, streams);
+        calculated.skipTo(stream*100);
+        ldsg.skipTo(stream*100);
+        if (ldsg.nextSequence().value != calculated.nextSequence().value)
+            BOOST_FAIL("low-discrepancy substream " << stream
+                       << " not matching skipped sequence");
+    }
+
+    // pseudo-random substreams need an explicit common seed
+    BOOST_CHECK_THROW(
+        PseudoRandom::make_sequence_generator(dimension, 0, 1, streams),
+        Error);
+    BOOST_CHECK_THROW(
+        PseudoRandom::make_sequence_generator(dimension, seed, 4, streams),
+        Error);
+}
+
+
 test_suite* RngTraitsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("RNG traits tests");
     suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testGaussian));
     suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testDefaultPoisson));
     suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testCustomPoisson));
+    suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testSubstreams));
     return suite;
 }
 
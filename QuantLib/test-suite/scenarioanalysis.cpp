@@ -0,0 +1,251 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include "scenarioanalysis.hpp"
+#include "utilities.hpp"
+#include <ql/experimental/risk/scenarioanalysis.hpp>
+#include <ql/instruments/europeanoption.hpp>
+#include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/time/calendars/nullcalendar.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+#include <ql/indexes/indexmanager.hpp>
+#include <set>
+
+using namespace QuantLib;
+using namespace boost::unit_test_framework;
+
+namespace {
+
+    // calls on spot, risk-free rate and volatility quotes
+    class OptionPortfolio : public PortfolioBuilder {
+      public:
+        explicit OptionPortfolio(const std::vector<Real>& strikes)
+        : strikes_(strikes) {}
+        std::vector<boost::shared_ptr<Instrument> >
+        build(const std::vector<Handle<Quote> >& quotes) const {
+            DayCounter dc = Actual365Fixed();
+            Handle<YieldTermStructure> riskFree(
+                boost::shared_ptr<YieldTermStructure>(
+                         new FlatForward(0, NullCalendar(), quotes[1], dc)));
+            Handle<YieldTermStructure> dividends(
+                boost::shared_ptr<YieldTermStructure>(
+                         new FlatForward(0, NullCalendar(), 0.02, dc)));
+            Handle<BlackVolTermStructure> volatility(
+                boost::shared_ptr<BlackVolTermStructure>(
+                    new BlackConstantVol(0, NullCalendar(), quotes[2], dc)));
+            boost::shared_ptr<GeneralizedBlackScholesProcess> process(
+                new BlackScholesMertonProcess(quotes[0], dividends,
+                                              riskFree, volatility));
+            boost::shared_ptr<PricingEngine> engine(
+                                      new AnalyticEuropeanEngine(process));
+
+            Date today = Settings::instance().evaluationDate();
+            boost::shared_ptr<Exercise> exercise(
+                                   new EuropeanExercise(today + 1*Years));
+            std::vector<boost::shared_ptr<Instrument> > options;
+            for (Size i=0; i<strikes_.size(); ++i) {
+                boost::shared_ptr<StrikedTypePayoff> payoff(
+                          new PlainVanillaPayoff(Option::Call, strikes_[i]));
+                options.push_back(boost::shared_ptr<Instrument>(
+                                      new EuropeanOption(payoff, exercise)));
+                options.back()->setPricingEngine(engine);
+            }
+            return options;
+        }
+      private:
+        std::vector<Real> strikes_;
+    };
+
+    // records the sessions in which the portfolio copies are built
+    class SessionRecorder : public OptionPortfolio {
+      public:
+        explicit SessionRecorder(const std::vector<Real>& strikes)
+        : OptionPortfolio(strikes), missingFixings_(false) {}
+        std::vector<boost::shared_ptr<Instrument> >
+        build(const std::vector<Handle<Quote> >& quotes) const {
+            const Settings* settings = &Settings::instance();
+            Date today = Settings::instance().evaluationDate();
+            bool fixings = IndexManager::instance().hasHistory("TEST");
+            #if defined(_OPENMP)
+            #pragma omp critical
+            #endif
+            {
+                sessions_.insert(settings);
+                dates_.insert(today);
+                if (!fixings)
+                    missingFixings_ = true;
+            }
+            return OptionPortfolio::build(quotes);
+        }
+        mutable std::set<const Settings*> sessions_;
+        mutable std::set<Date> dates_;
+        mutable bool missingFixings_;
+    };
+
+}
+
+
+void ScenarioAnalysisTest::testScenarioNPVs() {
+
+    BOOST_TEST_MESSAGE("Testing portfolio repricing under scenarios...");
+
+    SavedSettings backup;
+    Settings::instance().evaluationDate() = Date(15, May, 2013);
+
+    std::vector<Real> strikes;
+    strikes.push_back(90.0);
+    strikes.push_back(100.0);
+    strikes.push_back(110.0);
+    OptionPortfolio builder(strikes);
+
+    std::vector<boost::shared_ptr<SimpleQuote> > quotes;
+    quotes.push_back(boost::shared_ptr<SimpleQuote>(new SimpleQuote(100.0)));
+    quotes.push_back(boost::shared_ptr<SimpleQuote>(new SimpleQuote(0.03)));
+    quotes.push_back(boost::shared_ptr<SimpleQuote>(new SimpleQuote(0.20)));
+    std::vector<Handle<Quote> > baseQuotes;
+    for (Size k=0; k<quotes.size(); ++k)
+        baseQuotes.push_back(Handle<Quote>(quotes[k]));
+
+    // spot and volatility move in every scenario, the rate only in
+    // some of them
+    Size scenarios = 7;
+    Matrix shifts(scenarios, quotes.size(), 0.0);
+    for (Size i=0; i<scenarios; ++i) {
+        shifts[i][0] = 2.0*i - 6.0;
+        shifts[i][1] = (i % 3 == 0 ? 0.0 : 0.001*i);
+        shifts[i][2] = 0.01*(i % 4);
+    }
+
+    // expected values: mutate the base quotes in place
+    std::vector<boost::shared_ptr<Instrument> > options =
+        builder.build(baseQuotes);
+    Matrix expected(scenarios, options.size());
+    Real baseValues[] = { 100.0, 0.03, 0.20 };
+    for (Size i=0; i<scenarios; ++i) {
+        for (Size k=0; k<quotes.size(); ++k)
+            quotes[k]->setValue(baseValues[k] + shifts[i][k]);
+        for (Size j=0; j<options.size(); ++j)
+            expected[i][j] = options[j]->NPV();
+    }
+    for (Size k=0; k<quotes.size(); ++k)
+        quotes[k]->setValue(baseValues[k]);
+
+    Size workers[] = { 1, 2, 3, 10 };
+    for (Size w=0; w<LENGTH(workers); ++w) {
+        Matrix npvs = scenarioAnalysis(baseQuotes, shifts,
+                                       builder, workers[w]);
+        if (npvs.rows() != scenarios || npvs.columns() != options.size())
+            BOOST_FAIL("wrong result size with " << workers[w]
+                       << " workers: " << npvs.rows() << "x"
+                       << npvs.columns() << " instead of "
+                       << scenarios << "x" << options.size());
+        for (Size i=0; i<scenarios; ++i) {
+            for (Size j=0; j<options.size(); ++j) {
+                if (std::fabs(npvs[i][j]-expected[i][j]) > 1.0e-10)
+                    BOOST_ERROR("failed to reproduce NPV with "
+                                << workers[w] << " workers:"
+                                << "\n    scenario:   " << i
+                                << "\n    instrument: " << j
+                                << std::setprecision(12)
+                                << "\n    calculated: " << npvs[i][j]
+                                << "\n    expected:   " << expected[i][j]);
+            }
+        }
+    }
+
+    // base quotes are left untouched
+    for (Size k=0; k<quotes.size(); ++k) {
+        if (quotes[k]->value() != baseValues[k])
+            BOOST_ERROR("base quote " << k << " was modified");
+    }
+}
+
+
+void ScenarioAnalysisTest::testWorkerSessions() {
+
+    BOOST_TEST_MESSAGE("Testing sessions used by scenario workers...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Date today(15, May, 2013);
+    Settings::instance().evaluationDate() = today;
+    TimeSeries<Real> fixings;
+    fixings[today - 1] = 0.01;
+    IndexManager::instance().setHistory("TEST", fixings);
+
+    std::vector<Real> strikes(2, 100.0);
+    strikes[1] = 105.0;
+    std::vector<Handle<Quote> > baseQuotes;
+    baseQuotes.push_back(Handle<Quote>(
+                     boost::shared_ptr<Quote>(new SimpleQuote(100.0))));
+    baseQuotes.push_back(Handle<Quote>(
+                     boost::shared_ptr<Quote>(new SimpleQuote(0.03))));
+    baseQuotes.push_back(Handle<Quote>(
+                     boost::shared_ptr<Quote>(new SimpleQuote(0.20))));
+
+    Size scenarios = 8, workers = 4;
+    Matrix shifts(scenarios, baseQuotes.size(), 0.0);
+    for (Size i=0; i<scenarios; ++i)
+        shifts[i][0] = 1.0*i;
+
+    Matrix expected = scenarioAnalysis(baseQuotes, shifts,
+                                       OptionPortfolio(strikes), 1);
+    SessionRecorder recorder(strikes);
+    Matrix npvs = scenarioAnalysis(baseQuotes, shifts, recorder, workers);
+
+    for (Size i=0; i<scenarios; ++i) {
+        for (Size j=0; j<strikes.size(); ++j) {
+            if (std::fabs(npvs[i][j]-expected[i][j]) > 1.0e-10)
+                BOOST_ERROR("failed to reproduce serial NPV:"
+                            << "\n    scenario:   " << i
+                            << "\n    instrument: " << j
+                            << std::setprecision(12)
+                            << "\n    calculated: " << npvs[i][j]
+                            << "\n    expected:   " << expected[i][j]);
+        }
+    }
+
+    // workers run in parallel, each in its own session, only when
+    // thread-local sessions are enabled; otherwise, they run in
+    // sequence in the session of the caller
+    #if defined(_OPENMP) && defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+    Size expectedSessions = workers;
+    #else
+    Size expectedSessions = 1;
+    #endif
+    if (recorder.sessions_.size() != expectedSessions)
+        BOOST_ERROR("portfolio copies built in "
+                    << recorder.sessions_.size() << " sessions"
+                    << " instead of " << expectedSessions);
+    if (recorder.dates_.size() != 1 || *recorder.dates_.begin() != today)
+        BOOST_ERROR("workers did not use the caller's evaluation date");
+    if (recorder.missingFixings_)
+        BOOST_ERROR("workers did not see the caller's index fixings");
+}
+
+
+test_suite* ScenarioAnalysisTest::suite() {
+    test_suite* suite = BOOST_TEST_SUITE("Scenario analysis tests");
+    suite->add(QUANTLIB_TEST_CASE(&ScenarioAnalysisTest::testScenarioNPVs));
+    suite->add(QUANTLIB_TEST_CASE(&ScenarioAnalysisTest::testWorkerSessions));
+    return suite;
+}
@@ -0,0 +1,109 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include "settings.hpp"
+#include "utilities.hpp"
+#include <ql/settings.hpp>
+#include <ql/math/randomnumbers/seedgenerator.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/time/calendars/nullcalendar.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+#if defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+#include <boost/thread/thread.hpp>
+#include <boost/thread/barrier.hpp>
+#include <boost/bind.hpp>
+#endif
+#include <set>
+
+using namespace QuantLib;
+using namespace boost::unit_test_framework;
+
+#if defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+
+namespace {
+
+    struct SessionResults {
+        Date referenceDate;
+        unsigned long seed;
+    };
+
+    void runSession(const Date& evaluationDate,
+                    boost::barrier& barrier,
+                    SessionResults& results) {
+        Settings::instance().evaluationDate() = evaluationDate;
+        // the other threads set their own dates in the meantime
+        barrier.wait();
+        FlatForward curve(0, NullCalendar(), 0.05, Actual365Fixed());
+        results.referenceDate = curve.referenceDate();
+        results.seed = SeedGenerator::instance().get();
+    }
+
+}
+
+void SettingsTest::testThreadLocalSessions() {
+
+    BOOST_TEST_MESSAGE("Testing thread-local sessions...");
+
+    SavedSettings backup;
+
+    Date today = Settings::instance().evaluationDate();
+
+    const Size n = 4;
+    std::vector<Date> dates(n);
+    std::vector<SessionResults> results(n);
+    boost::barrier barrier(n);
+    boost::thread_group threads;
+    for (Size i=0; i<n; ++i) {
+        dates[i] = today + Integer(i+1)*Weeks;
+        threads.create_thread(boost::bind(&runSession,
+                                          boost::cref(dates[i]),
+                                          boost::ref(barrier),
+                                          boost::ref(results[i])));
+    }
+    threads.join_all();
+
+    std::set<unsigned long> seeds;
+    for (Size i=0; i<n; ++i) {
+        if (results[i].referenceDate != dates[i])
+            BOOST_ERROR("thread " << i << ":"
+                        << "\n    evaluation date: " << dates[i]
+                        << "\n    reference date:  "
+                        << results[i].referenceDate);
+        seeds.insert(results[i].seed);
+    }
+    if (seeds.size() != n)
+        BOOST_ERROR("seed generators of different threads "
+                    "returned the same seeds");
+
+    if (Settings::instance().evaluationDate() != today)
+        BOOST_ERROR("evaluation date of the main thread was modified:"
+                    << "\n    before:  " << today
+                    << "\n    after:   "
+                    << Settings::instance().evaluationDate());
+}
+
+#endif
+
+
+test_suite* SettingsTest::suite() {
+    test_suite* suite = BOOST_TEST_SUITE("Settings tests");
+    #if defined(QL_ENABLE_THREAD_LOCAL_SESSIONS)
+    suite->add(QUANTLIB_TEST_CASE(&SettingsTest::testThreadLocalSessions));
+    #endif
+    return suite;
+}
+
@@ -323,6 +323,47 @@ void SwapTest::testCachedValue() {
 }
 
 
+// run by the benchmark only, as it is too slow for the test suite
+void SwapTest::testLargePortfolio() {
+
+    BOOST_TEST_MESSAGE("Testing notification of a large swap portfolio...");
+
+    CommonVars vars;
+
+    // all swaps observe the same index and discount curve, whose
+    // observer sets grow and shrink with the portfolio
+    Size n = 100000;
+    std::vector<boost::shared_ptr<VanillaSwap> > swaps;
+    swaps.reserve(n);
+    for (Size i=0; i<n; i++)
+        swaps.push_back(vars.makeSwap(1, 0.05, 0.0));
+
+    // swaps forward notifications only after being calculated
+    Flag flag;
+    flag.registerWith(swaps[n/2]);
+    swaps[n/2]->NPV();
+    Real npv = swaps.back()->NPV();
+
+    vars.termStructure.linkTo(flatRate(vars.settlement,0.06,Actual365Fixed()));
+
+    if (!flag.isUp())
+        BOOST_ERROR("swap in portfolio was not notified of curve change");
+    if (swaps.back()->NPV() == npv)
+        BOOST_ERROR("swap in portfolio was not recalculated "
+                    "after curve change");
+
+    // destroy the swaps in creation order
+    swaps.clear();
+
+    Flag curveFlag;
+    curveFlag.registerWith(vars.termStructure);
+    vars.termStructure.linkTo(flatRate(vars.settlement,0.04,Actual365Fixed()));
+    if (!curveFlag.isUp())
+        BOOST_ERROR("observer was not notified of curve change "
+                    "after destroying the portfolio");
+}
+
+
 test_suite* SwapTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Swap tests");
     suite->add(QUANTLIB_TEST_CASE(&SwapTest::testFairRate));
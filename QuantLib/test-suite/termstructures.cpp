@@ -25,6 +25,7 @@
 #include <ql/termstructures/yield/impliedtermstructure.hpp>
 #include <ql/termstructures/yield/forwardspreadedtermstructure.hpp>
 #include <ql/termstructures/yield/zerospreadedtermstructure.hpp>
+#include <ql/termstructures/yield/zerocurve.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/calendars/nullcalendar.hpp>
 #include <ql/time/daycounters/actual360.hpp>
@@ -299,6 +300,106 @@ void TermStructureTest::testZSpreadedObs() {
 }
 
 
+void TermStructureTest::testBatchDiscounts() {
+
+    BOOST_TEST_MESSAGE("Testing batch discount factors and rates...");
+
+    CommonVars vars;
+
+    Date today = Settings::instance().evaluationDate();
+    std::vector<Date> dates;
+    std::vector<Rate> zeros;
+    Real tenors[] = { 0.0, 1.0, 2.0, 5.0, 10.0, 20.0 };
+    for (Size i=0; i<LENGTH(tenors); ++i) {
+        dates.push_back(today + Integer(tenors[i]*365));
+        zeros.push_back(0.02 + 0.002*tenors[i]);
+    }
+    std::vector<Handle<Quote> > jumps(2);
+    jumps[0] = Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.99)));
+    jumps[1] = Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.98)));
+
+    std::vector<std::string> names;
+    std::vector<boost::shared_ptr<YieldTermStructure> > curves;
+    names.push_back("flat forward");
+    curves.push_back(boost::shared_ptr<YieldTermStructure>(
+                  new FlatForward(today, 0.03, Actual360(), Compounded)));
+    names.push_back("piecewise");
+    curves.push_back(vars.termStructure);
+    names.push_back("zero");
+    curves.push_back(boost::shared_ptr<YieldTermStructure>(
+                                new ZeroCurve(dates, zeros, Actual360())));
+    names.push_back("zero with jumps");
+    curves.push_back(boost::shared_ptr<YieldTermStructure>(
+                 new ZeroCurve(dates, zeros, Actual360(), Calendar(), jumps)));
+    names.push_back("zero-spreaded");
+    curves.push_back(boost::shared_ptr<YieldTermStructure>(
+        new ZeroSpreadedTermStructure(
+            Handle<YieldTermStructure>(vars.termStructure),
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.01))),
+            Compounded, Semiannual)));
+    names.push_back("implied");
+    curves.push_back(boost::shared_ptr<YieldTermStructure>(
+        new ImpliedTermStructure(
+            Handle<YieldTermStructure>(vars.termStructure),
+            vars.termStructure->referenceDate() + 1*Years)));
+
+    // sorted times, followed by a few unsorted ones
+    std::vector<Time> times;
+    for (Size i=0; i<=250; ++i)
+        times.push_back(0.1*i);
+    times.push_back(3.3);
+    times.push_back(0.7);
+    times.push_back(15.25);
+
+    Real tolerance = 1.0e-14;
+    for (Size k=0; k<curves.size(); ++k) {
+        Array discounts, zeroRates, forwardRates;
+        curves[k]->discounts(times, discounts, true);
+        curves[k]->zeroRates(times, zeroRates, Continuous, NoFrequency, true);
+        curves[k]->forwardRates(std::vector<Time>(times.begin(),
+                                                  times.begin()+251),
+                                forwardRates, Compounded, Annual, true);
+        if (discounts.size() != times.size() ||
+            zeroRates.size() != times.size() ||
+            forwardRates.size() != 250)
+            BOOST_FAIL(names[k] << " curve: wrong batch size");
+
+        for (Size i=0; i<times.size(); ++i) {
+            Time t = times[i];
+            DiscountFactor discount = curves[k]->discount(t, true);
+            if (std::fabs(discounts[i]-discount) > tolerance)
+                BOOST_FAIL(names[k] << " curve: discount at t = " << t
+                           << std::setprecision(16)
+                           << "\n    batch:  " << discounts[i]
+                           << "\n    single: " << discount);
+            Rate zero = curves[k]->zeroRate(t, Continuous, NoFrequency,
+                                            true);
+            if (std::fabs(zeroRates[i]-zero) > tolerance)
+                BOOST_FAIL(names[k] << " curve: zero rate at t = " << t
+                           << std::setprecision(16)
+                           << "\n    batch:  " << zeroRates[i]
+                           << "\n    single: " << zero);
+        }
+        for (Size i=0; i<250; ++i) {
+            Rate forward = curves[k]->forwardRate(times[i], times[i+1],
+                                                  Compounded, Annual, true);
+            if (std::fabs(forwardRates[i]-forward) > tolerance)
+                BOOST_FAIL(names[k] << " curve: forward rate at t = "
+                           << times[i] << std::setprecision(16)
+                           << "\n    batch:  " << forwardRates[i]
+                           << "\n    single: " << forward);
+        }
+    }
+
+    // the range is checked for the whole set
+    Array discounts;
+    std::vector<Time> outOfRange(1, 25.0);
+    outOfRange.push_back(50.0);
+    BOOST_CHECK_THROW(curves[2]->discounts(outOfRange, discounts),
+                      Error);
+}
+
+
 test_suite* TermStructureTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Term structure tests");
     suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testReferenceChange));
@@ -308,6 +409,7 @@ test_suite* TermStructureTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testFSpreadedObs));
     suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testZSpreaded));
     suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testZSpreadedObs));
+    suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testBatchDiscounts));
     return suite;
 }
 
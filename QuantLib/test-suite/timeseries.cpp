@@ -22,10 +22,20 @@
 #include "utilities.hpp"
 #include <ql/timeseries.hpp>
 #include <ql/prices.hpp>
+#include <ql/utilities/densedatemap.hpp>
+#include <ql/indexes/fixingstore.hpp>
+#include <ql/indexes/ibor/euribor.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/time/daycounters/actual360.hpp>
 #include <ql/time/calendars/unitedstates.hpp>
 #if BOOST_VERSION >= 103600
     #include <boost/unordered_map.hpp>
 #endif
+#include <cstdio>
+#if defined(BOOST_HAS_UNISTD_H)
+#include <stdlib.h>
+#include <unistd.h>
+#endif
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -189,11 +199,239 @@ void TimeSeriesTest::testIterators() {
     }
 }
 
+void TimeSeriesTest::testDenseStorage() {
+    BOOST_TEST_MESSAGE("Testing time series with dense storage...");
+
+    TimeSeries<Real> ts;
+    TimeSeries<Real, DenseDateMap<Real> > dense;
+
+    // fill in both directions, leaving gaps
+    Date d0(15, March, 2005);
+    for (Integer i=0; i<40; i+=3) {
+        ts[d0+i] = dense[d0+i] = 0.01*i;
+        ts[d0-2*i] = dense[d0-2*i] = -0.01*i;
+    }
+
+    if (dense.size() != ts.size())
+        BOOST_FAIL("size does not match: " << dense.size()
+                   << " instead of " << ts.size());
+    if (dense.firstDate() != ts.firstDate())
+        BOOST_ERROR("firstDate does not match");
+    if (dense.lastDate() != ts.lastDate())
+        BOOST_ERROR("lastDate does not match");
+
+    const TimeSeries<Real, DenseDateMap<Real> >& constDense = dense;
+    const TimeSeries<Real>& constTs = ts;
+    for (Date d = d0-100; d <= d0+100; ++d) {
+        if (constDense[d] != constTs[d])
+            BOOST_ERROR("value at " << d << " does not match: "
+                        << constDense[d] << " instead of " << constTs[d]);
+    }
+
+    // iteration skips the gaps
+    if (dense.dates() != ts.dates())
+        BOOST_ERROR("dates do not match");
+    if (dense.values() != ts.values())
+        BOOST_ERROR("values do not match");
+
+    std::vector<Date> reversed(dense.crbegin_time(), dense.crend_time());
+    std::reverse(reversed.begin(), reversed.end());
+    if (reversed != ts.dates())
+        BOOST_ERROR("reverse iteration does not match");
+
+    // the range can be extended up to the ends of the valid dates
+    DenseDateMap<Real> edges;
+    edges[Date::maxDate()-2] = 1.0;
+    edges[Date::maxDate()] = 2.0;
+    edges[Date::minDate()] = 3.0;
+    if (edges.size() != 3)
+        BOOST_ERROR("wrong number of data at the range ends: "
+                    << edges.size() << " instead of 3");
+    if (edges.find(Date::maxDate()) == edges.end() ||
+        edges.find(Date::maxDate())->second != 2.0 ||
+        edges.find(Date::minDate()) == edges.end() ||
+        edges.find(Date::minDate())->second != 3.0)
+        BOOST_ERROR("wrong data at the range ends");
+}
+
+void TimeSeriesTest::testIndexFixings() {
+    BOOST_TEST_MESSAGE("Testing bulk lookup of index fixings...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Date today(15, March, 2005);
+    Settings::instance().evaluationDate() = today;
+    Handle<YieldTermStructure> forecast(boost::shared_ptr<YieldTermStructure>(
+                                new FlatForward(today, 0.03, Actual360())));
+    Euribor6M index(forecast);
+    Calendar calendar = index.fixingCalendar();
+
+    std::vector<Date> dates;
+    for (Date d = calendar.advance(today, -60, Days); d < today;
+         d = calendar.advance(d, 1, Days)) {
+        index.addFixing(d, 0.02 + 0.0001*dates.size());
+        dates.push_back(d);
+    }
+    dates.push_back(today);
+    for (Integer i=0; i<10; ++i)
+        dates.push_back(calendar.advance(today, 5*(i+1), Days));
+
+    boost::shared_ptr<const ObservableValue<TimeSeries<Real> > > history =
+        IndexManager::instance().history(index.name());
+
+    for (Size k=0; k<2; ++k) {
+        bool forecastTodaysFixing = (k == 1);
+        std::vector<Real> fixings;
+        index.fixings(dates, fixings, forecastTodaysFixing);
+        if (fixings.size() != dates.size())
+            BOOST_FAIL("wrong number of fixings");
+        for (Size i=0; i<dates.size(); ++i) {
+            Real expected = index.fixing(dates[i], forecastTodaysFixing);
+            if (fixings[i] != expected)
+                BOOST_ERROR("fixing at " << dates[i] << " does not match:"
+                            << "\n    bulk:   " << fixings[i]
+                            << "\n    single: " << expected);
+            if (dates[i] < today && history->value()[dates[i]] != expected)
+                BOOST_ERROR("stored fixing at " << dates[i]
+                            << " does not match");
+        }
+    }
+
+    // the history object follows the stored fixings
+    index.clearFixings();
+    if (!history->value().empty())
+        BOOST_ERROR("history not cleared");
+    index.addFixing(dates[0], 0.05);
+    if (history->value()[dates[0]] != 0.05)
+        BOOST_ERROR("history not updated");
+
+    std::vector<Real> fixings;
+    BOOST_CHECK_THROW(index.fixings(dates, fixings), Error);
+}
+
+namespace {
+
+    // a file name not used by other processes, removed on exit
+    class TemporaryFile {
+      public:
+        TemporaryFile() {
+            #if defined(BOOST_HAS_UNISTD_H)
+            char buffer[] = "/tmp/quantlib-fixings-XXXXXX";
+            int fd = mkstemp(buffer);
+            QL_REQUIRE(fd != -1, "unable to create a temporary file");
+            close(fd);
+            #else
+            char buffer[L_tmpnam];
+            QL_REQUIRE(std::tmpnam(buffer) != 0,
+                       "unable to create a temporary file name");
+            #endif
+            name_ = buffer;
+        }
+        ~TemporaryFile() { std::remove(name_.c_str()); }
+        const std::string& name() const { return name_; }
+      private:
+        std::string name_;
+    };
+
+}
+
+void TimeSeriesTest::testFixingStore() {
+    BOOST_TEST_MESSAGE("Testing binary store of index fixings...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+    // fixings stored by other tests would be written too
+    IndexManager::instance().clearHistories();
+
+    Date today(15, March, 2005);
+    Settings::instance().evaluationDate() = today;
+    Euribor6M euribor;
+    Calendar calendar = euribor.fixingCalendar();
+
+    TimeSeries<Real> other;
+    for (Date d = calendar.advance(today, -250, Days); d < today;
+         d = calendar.advance(d, 1, Days)) {
+        euribor.addFixing(d, 0.02 + 0.00001*(d - today));
+        other[d] = 1.5 - 0.001*(d - today);
+    }
+    IndexManager::instance().setHistory("Other index", other);
+    IndexManager::instance().setHistory("Empty index", TimeSeries<Real>());
+
+    TemporaryFile file;
+    const std::string& filename = file.name();
+    FixingStore::write(filename);
+    TimeSeries<Real> expected = euribor.timeSeries();
+
+    FixingStore store(filename);
+    if (store.size() != 2)
+        BOOST_FAIL("wrong number of stored histories: "
+                   << store.size() << " instead of 2");
+    for (Size i=0; i<store.size(); ++i) {
+        std::string name = store.name(i);
+        TimeSeries<Real> reference =
+            IndexManager::instance().getHistory(name);
+        TimeSeries<Real> stored = store.history(i);
+        if (store.fixings(i) != reference.size()
+            || stored.size() != reference.size())
+            BOOST_FAIL("wrong number of fixings stored for " << name);
+        TimeSeries<Real>::const_iterator j = stored.begin(),
+                                         k = reference.begin();
+        for (; j != stored.end(); ++j, ++k) {
+            if (j->first != k->first || j->second != k->second)
+                BOOST_ERROR("wrong fixing stored for " << name << ":"
+                            << "\n    stored:   " << j->first
+                            << ", " << j->second
+                            << "\n    original: " << k->first
+                            << ", " << k->second);
+        }
+    }
+
+    // histories are loaded on demand, and observers of the ones in
+    // use are notified
+    IndexManager::instance().clearHistories();
+    Flag flag;
+    flag.registerWith(IndexManager::instance().notifier(euribor.name()));
+    IndexManager::instance().loadHistories(filename);
+    if (!flag.isUp())
+        BOOST_ERROR("observer not notified of loaded fixings");
+    if (!IndexManager::instance().hasHistory("OTHER INDEX")
+        || IndexManager::instance().hasHistory("EMPTY INDEX"))
+        BOOST_ERROR("wrong histories reported as available");
+    if (IndexManager::instance().histories().size() != 2)
+        BOOST_ERROR("wrong number of available histories");
+
+    Date d = calendar.advance(today, -10, Days);
+    if (euribor.fixing(d) != expected[d])
+        BOOST_ERROR("wrong loaded fixing: " << euribor.fixing(d)
+                    << " instead of " << expected[d]);
+    if (IndexManager::instance().getHistory("other index")[d] != other[d])
+        BOOST_ERROR("wrong loaded fixing for other index");
+
+    // loaded fixings still notify when updated...
+    flag.lower();
+    euribor.addFixing(today, 0.03);
+    if (!flag.isUp())
+        BOOST_ERROR("observer not notified of added fixing");
+
+    // ...and cleared histories are not read again
+    IndexManager::instance().loadHistories(filename);
+    IndexManager::instance().clearHistory("other index");
+    if (IndexManager::instance().hasHistory("other index"))
+        BOOST_ERROR("cleared history still available");
+
+    std::remove(filename.c_str());
+    BOOST_CHECK_THROW(FixingStore store(filename), Error);
+}
+
 test_suite* TimeSeriesTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("time series tests");
     suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testConstruction));
     suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testIntervalPrice));
     suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testIterators));
+    suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testDenseStorage));
+    suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testIndexFixings));
+    suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testFixingStore));
     return suite;
 }
 
@@ -30,6 +30,9 @@ class TimeSeriesTest {
     static void testConstruction();
     static void testIntervalPrice();
     static void testIterators();
+    static void testDenseStorage();
+    static void testIndexFixings();
+    static void testFixingStore();
     static boost::unit_test_framework::test_suite* suite();
     
 };